@@ -45,6 +45,7 @@
  * - Detecting grapheme boundaries (@ref utf8proc_grapheme_break and @ref UTF8PROC_CHARBOUND)
  * - Character-width computation: @ref utf8proc_charwidth
  * - Classification of characters by Unicode category: @ref utf8proc_category and @ref utf8proc_category_string
+ * - Scripts of characters: @ref utf8proc_script and @ref utf8proc_script_extensions
  * - Encode (@ref utf8proc_encode_char) and decode (@ref utf8proc_iterate) Unicode codepoints to/from UTF-8.
  */
 
@@ -140,6 +141,31 @@ extern "C" {
 #  define UINT16_MAX 65535U
 #endif
 
+/* Features built into the library, see utf8string.h */
+#ifndef UTF8STR_WITH_NORMALIZATION
+#  define UTF8STR_WITH_NORMALIZATION 1
+#endif
+#ifndef UTF8STR_WITH_CASE
+#  define UTF8STR_WITH_CASE 1
+#endif
+#ifndef UTF8STR_WITH_WIDTH
+#  define UTF8STR_WITH_WIDTH 1
+#endif
+#ifndef UTF8STR_WITH_GRAPHEME
+#  define UTF8STR_WITH_GRAPHEME 1
+#endif
+#ifndef UTF8STR_WITH_SCRIPT
+#  define UTF8STR_WITH_SCRIPT 1
+#endif
+#ifndef UTF8STR_WITH_LINEBREAK
+#  define UTF8STR_WITH_LINEBREAK 1
+#endif
+/* The Unicode tables are read from a file by utf8proc_load_data instead of
+   being compiled in */
+#ifndef UTF8STR_EXTERNAL_DATA
+#  define UTF8STR_EXTERNAL_DATA 0
+#endif
+
 /**
  * Option flags used by several functions in the library.
  */
@@ -221,6 +247,8 @@ typedef enum {
 #define UTF8PROC_ERROR_NOTASSIGNED -4
 /** Invalid options have been used. */
 #define UTF8PROC_ERROR_INVALIDOPTS -5
+/** The Unicode data file could not be read or does not match the library. */
+#define UTF8PROC_ERROR_INVALIDDATA -6
 /** @} */
 
 /* @name Types */
@@ -374,8 +402,225 @@ typedef enum {
   UTF8PROC_BOUNDCLASS_E_MODIFIER         = 16, /**< Emoji Modifier */
   UTF8PROC_BOUNDCLASS_GLUE_AFTER_ZWJ     = 17, /**< Glue_After_ZWJ */
   UTF8PROC_BOUNDCLASS_E_BASE_GAZ         = 18, /**< E_BASE + GLUE_AFTER_ZJW */
+  UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC = 19, /**< Other with Extended_Pictographic(UTS #51) */
 } utf8proc_boundclass_t;
 
+/** Emoji properties(UTS #51), flags returned by @ref utf8proc_emoji. */
+typedef enum {
+  UTF8PROC_EMOJI                 =  1, /**< Emoji */
+  UTF8PROC_EMOJI_PRESENTATION    =  2, /**< Emoji_Presentation: shown as emoji by default */
+  UTF8PROC_EMOJI_MODIFIER_BASE   =  4, /**< Emoji_Modifier_Base: takes a skin tone modifier */
+  UTF8PROC_EXTENDED_PICTOGRAPHIC =  8, /**< Extended_Pictographic, including reserved codepoints */
+  UTF8PROC_EMOJI_MODIFIER        = 16, /**< Emoji_Modifier: skin tone modifier */
+} utf8proc_emoji_t;
+
+/**
+ * Properties for quick checks of whole strings, flags returned by
+ * @ref utf8proc_quick_props.
+ */
+typedef enum {
+  UTF8PROC_QUICK_COMBINING  =  1, /**< non-zero canonical combining class */
+  UTF8PROC_QUICK_NFC_CHECK  =  2, /**< NFC_Quick_Check is No or Maybe */
+  UTF8PROC_QUICK_CASEMAP    =  4, /**< has a case mapping or case folding */
+  UTF8PROC_QUICK_CONTROL    =  8, /**< control character(Cc) or Bidi_Control */
+  UTF8PROC_QUICK_NOT_NARROW = 16, /**< @ref utf8proc_charwidth is not 1 */
+} utf8proc_quick_t;
+
+/**
+ * Unicode scripts(Script property, UAX #24) with their ISO 15924 codes, see
+ * @ref utf8proc_script.
+ */
+typedef enum {
+  UTF8PROC_SCRIPT_UNKNOWN = 0, /**< Zzzz */
+  UTF8PROC_SCRIPT_COMMON = 1, /**< Zyyy */
+  UTF8PROC_SCRIPT_INHERITED = 2, /**< Zinh */
+  UTF8PROC_SCRIPT_ADLAM = 3, /**< Adlm */
+  UTF8PROC_SCRIPT_AHOM = 4, /**< Ahom */
+  UTF8PROC_SCRIPT_ANATOLIAN_HIEROGLYPHS = 5, /**< Hluw */
+  UTF8PROC_SCRIPT_ARABIC = 6, /**< Arab */
+  UTF8PROC_SCRIPT_ARMENIAN = 7, /**< Armn */
+  UTF8PROC_SCRIPT_AVESTAN = 8, /**< Avst */
+  UTF8PROC_SCRIPT_BALINESE = 9, /**< Bali */
+  UTF8PROC_SCRIPT_BAMUM = 10, /**< Bamu */
+  UTF8PROC_SCRIPT_BASSA_VAH = 11, /**< Bass */
+  UTF8PROC_SCRIPT_BATAK = 12, /**< Batk */
+  UTF8PROC_SCRIPT_BENGALI = 13, /**< Beng */
+  UTF8PROC_SCRIPT_BHAIKSUKI = 14, /**< Bhks */
+  UTF8PROC_SCRIPT_BOPOMOFO = 15, /**< Bopo */
+  UTF8PROC_SCRIPT_BRAHMI = 16, /**< Brah */
+  UTF8PROC_SCRIPT_BRAILLE = 17, /**< Brai */
+  UTF8PROC_SCRIPT_BUGINESE = 18, /**< Bugi */
+  UTF8PROC_SCRIPT_BUHID = 19, /**< Buhd */
+  UTF8PROC_SCRIPT_CANADIAN_ABORIGINAL = 20, /**< Cans */
+  UTF8PROC_SCRIPT_CARIAN = 21, /**< Cari */
+  UTF8PROC_SCRIPT_CAUCASIAN_ALBANIAN = 22, /**< Aghb */
+  UTF8PROC_SCRIPT_CHAKMA = 23, /**< Cakm */
+  UTF8PROC_SCRIPT_CHAM = 24, /**< Cham */
+  UTF8PROC_SCRIPT_CHEROKEE = 25, /**< Cher */
+  UTF8PROC_SCRIPT_COPTIC = 26, /**< Copt */
+  UTF8PROC_SCRIPT_CUNEIFORM = 27, /**< Xsux */
+  UTF8PROC_SCRIPT_CYPRIOT = 28, /**< Cprt */
+  UTF8PROC_SCRIPT_CYRILLIC = 29, /**< Cyrl */
+  UTF8PROC_SCRIPT_DESERET = 30, /**< Dsrt */
+  UTF8PROC_SCRIPT_DEVANAGARI = 31, /**< Deva */
+  UTF8PROC_SCRIPT_DUPLOYAN = 32, /**< Dupl */
+  UTF8PROC_SCRIPT_EGYPTIAN_HIEROGLYPHS = 33, /**< Egyp */
+  UTF8PROC_SCRIPT_ELBASAN = 34, /**< Elba */
+  UTF8PROC_SCRIPT_ETHIOPIC = 35, /**< Ethi */
+  UTF8PROC_SCRIPT_GEORGIAN = 36, /**< Geor */
+  UTF8PROC_SCRIPT_GLAGOLITIC = 37, /**< Glag */
+  UTF8PROC_SCRIPT_GOTHIC = 38, /**< Goth */
+  UTF8PROC_SCRIPT_GRANTHA = 39, /**< Gran */
+  UTF8PROC_SCRIPT_GREEK = 40, /**< Grek */
+  UTF8PROC_SCRIPT_GUJARATI = 41, /**< Gujr */
+  UTF8PROC_SCRIPT_GURMUKHI = 42, /**< Guru */
+  UTF8PROC_SCRIPT_HAN = 43, /**< Hani */
+  UTF8PROC_SCRIPT_HANGUL = 44, /**< Hang */
+  UTF8PROC_SCRIPT_HANUNOO = 45, /**< Hano */
+  UTF8PROC_SCRIPT_HATRAN = 46, /**< Hatr */
+  UTF8PROC_SCRIPT_HEBREW = 47, /**< Hebr */
+  UTF8PROC_SCRIPT_HIRAGANA = 48, /**< Hira */
+  UTF8PROC_SCRIPT_IMPERIAL_ARAMAIC = 49, /**< Armi */
+  UTF8PROC_SCRIPT_INSCRIPTIONAL_PAHLAVI = 50, /**< Phli */
+  UTF8PROC_SCRIPT_INSCRIPTIONAL_PARTHIAN = 51, /**< Prti */
+  UTF8PROC_SCRIPT_JAVANESE = 52, /**< Java */
+  UTF8PROC_SCRIPT_KAITHI = 53, /**< Kthi */
+  UTF8PROC_SCRIPT_KANNADA = 54, /**< Knda */
+  UTF8PROC_SCRIPT_KATAKANA = 55, /**< Kana */
+  UTF8PROC_SCRIPT_KAYAH_LI = 56, /**< Kali */
+  UTF8PROC_SCRIPT_KHAROSHTHI = 57, /**< Khar */
+  UTF8PROC_SCRIPT_KHMER = 58, /**< Khmr */
+  UTF8PROC_SCRIPT_KHOJKI = 59, /**< Khoj */
+  UTF8PROC_SCRIPT_KHUDAWADI = 60, /**< Sind */
+  UTF8PROC_SCRIPT_LAO = 61, /**< Laoo */
+  UTF8PROC_SCRIPT_LATIN = 62, /**< Latn */
+  UTF8PROC_SCRIPT_LEPCHA = 63, /**< Lepc */
+  UTF8PROC_SCRIPT_LIMBU = 64, /**< Limb */
+  UTF8PROC_SCRIPT_LINEAR_A = 65, /**< Lina */
+  UTF8PROC_SCRIPT_LINEAR_B = 66, /**< Linb */
+  UTF8PROC_SCRIPT_LISU = 67, /**< Lisu */
+  UTF8PROC_SCRIPT_LYCIAN = 68, /**< Lyci */
+  UTF8PROC_SCRIPT_LYDIAN = 69, /**< Lydi */
+  UTF8PROC_SCRIPT_MAHAJANI = 70, /**< Mahj */
+  UTF8PROC_SCRIPT_MALAYALAM = 71, /**< Mlym */
+  UTF8PROC_SCRIPT_MANDAIC = 72, /**< Mand */
+  UTF8PROC_SCRIPT_MANICHAEAN = 73, /**< Mani */
+  UTF8PROC_SCRIPT_MARCHEN = 74, /**< Marc */
+  UTF8PROC_SCRIPT_MEETEI_MAYEK = 75, /**< Mtei */
+  UTF8PROC_SCRIPT_MENDE_KIKAKUI = 76, /**< Mend */
+  UTF8PROC_SCRIPT_MEROITIC_CURSIVE = 77, /**< Merc */
+  UTF8PROC_SCRIPT_MEROITIC_HIEROGLYPHS = 78, /**< Mero */
+  UTF8PROC_SCRIPT_MIAO = 79, /**< Plrd */
+  UTF8PROC_SCRIPT_MODI = 80, /**< Modi */
+  UTF8PROC_SCRIPT_MONGOLIAN = 81, /**< Mong */
+  UTF8PROC_SCRIPT_MRO = 82, /**< Mroo */
+  UTF8PROC_SCRIPT_MULTANI = 83, /**< Mult */
+  UTF8PROC_SCRIPT_MYANMAR = 84, /**< Mymr */
+  UTF8PROC_SCRIPT_NABATAEAN = 85, /**< Nbat */
+  UTF8PROC_SCRIPT_NEW_TAI_LUE = 86, /**< Talu */
+  UTF8PROC_SCRIPT_NEWA = 87, /**< Newa */
+  UTF8PROC_SCRIPT_NKO = 88, /**< Nkoo */
+  UTF8PROC_SCRIPT_OGHAM = 89, /**< Ogam */
+  UTF8PROC_SCRIPT_OL_CHIKI = 90, /**< Olck */
+  UTF8PROC_SCRIPT_OLD_HUNGARIAN = 91, /**< Hung */
+  UTF8PROC_SCRIPT_OLD_ITALIC = 92, /**< Ital */
+  UTF8PROC_SCRIPT_OLD_NORTH_ARABIAN = 93, /**< Narb */
+  UTF8PROC_SCRIPT_OLD_PERMIC = 94, /**< Perm */
+  UTF8PROC_SCRIPT_OLD_PERSIAN = 95, /**< Xpeo */
+  UTF8PROC_SCRIPT_OLD_SOUTH_ARABIAN = 96, /**< Sarb */
+  UTF8PROC_SCRIPT_OLD_TURKIC = 97, /**< Orkh */
+  UTF8PROC_SCRIPT_ORIYA = 98, /**< Orya */
+  UTF8PROC_SCRIPT_OSAGE = 99, /**< Osge */
+  UTF8PROC_SCRIPT_OSMANYA = 100, /**< Osma */
+  UTF8PROC_SCRIPT_PAHAWH_HMONG = 101, /**< Hmng */
+  UTF8PROC_SCRIPT_PALMYRENE = 102, /**< Palm */
+  UTF8PROC_SCRIPT_PAU_CIN_HAU = 103, /**< Pauc */
+  UTF8PROC_SCRIPT_PHAGS_PA = 104, /**< Phag */
+  UTF8PROC_SCRIPT_PHOENICIAN = 105, /**< Phnx */
+  UTF8PROC_SCRIPT_PSALTER_PAHLAVI = 106, /**< Phlp */
+  UTF8PROC_SCRIPT_REJANG = 107, /**< Rjng */
+  UTF8PROC_SCRIPT_RUNIC = 108, /**< Runr */
+  UTF8PROC_SCRIPT_SAMARITAN = 109, /**< Samr */
+  UTF8PROC_SCRIPT_SAURASHTRA = 110, /**< Saur */
+  UTF8PROC_SCRIPT_SHARADA = 111, /**< Shrd */
+  UTF8PROC_SCRIPT_SHAVIAN = 112, /**< Shaw */
+  UTF8PROC_SCRIPT_SIDDHAM = 113, /**< Sidd */
+  UTF8PROC_SCRIPT_SIGNWRITING = 114, /**< Sgnw */
+  UTF8PROC_SCRIPT_SINHALA = 115, /**< Sinh */
+  UTF8PROC_SCRIPT_SORA_SOMPENG = 116, /**< Sora */
+  UTF8PROC_SCRIPT_SUNDANESE = 117, /**< Sund */
+  UTF8PROC_SCRIPT_SYLOTI_NAGRI = 118, /**< Sylo */
+  UTF8PROC_SCRIPT_SYRIAC = 119, /**< Syrc */
+  UTF8PROC_SCRIPT_TAGALOG = 120, /**< Tglg */
+  UTF8PROC_SCRIPT_TAGBANWA = 121, /**< Tagb */
+  UTF8PROC_SCRIPT_TAI_LE = 122, /**< Tale */
+  UTF8PROC_SCRIPT_TAI_THAM = 123, /**< Lana */
+  UTF8PROC_SCRIPT_TAI_VIET = 124, /**< Tavt */
+  UTF8PROC_SCRIPT_TAKRI = 125, /**< Takr */
+  UTF8PROC_SCRIPT_TAMIL = 126, /**< Taml */
+  UTF8PROC_SCRIPT_TANGUT = 127, /**< Tang */
+  UTF8PROC_SCRIPT_TELUGU = 128, /**< Telu */
+  UTF8PROC_SCRIPT_THAANA = 129, /**< Thaa */
+  UTF8PROC_SCRIPT_THAI = 130, /**< Thai */
+  UTF8PROC_SCRIPT_TIBETAN = 131, /**< Tibt */
+  UTF8PROC_SCRIPT_TIFINAGH = 132, /**< Tfng */
+  UTF8PROC_SCRIPT_TIRHUTA = 133, /**< Tirh */
+  UTF8PROC_SCRIPT_UGARITIC = 134, /**< Ugar */
+  UTF8PROC_SCRIPT_VAI = 135, /**< Vaii */
+  UTF8PROC_SCRIPT_WARANG_CITI = 136, /**< Wara */
+  UTF8PROC_SCRIPT_YI = 137, /**< Yiii */
+} utf8proc_script_t;
+
+/**
+ * Line breaking classes(Line_Break property, UAX #14), see
+ * @ref utf8proc_linebreak.
+ */
+typedef enum {
+  UTF8PROC_LINEBREAK_XX  =  0, /**< Unknown */
+  UTF8PROC_LINEBREAK_BK  =  1, /**< Mandatory Break */
+  UTF8PROC_LINEBREAK_CR  =  2, /**< Carriage Return */
+  UTF8PROC_LINEBREAK_LF  =  3, /**< Line Feed */
+  UTF8PROC_LINEBREAK_CM  =  4, /**< Combining Mark */
+  UTF8PROC_LINEBREAK_NL  =  5, /**< Next Line */
+  UTF8PROC_LINEBREAK_SG  =  6, /**< Surrogate */
+  UTF8PROC_LINEBREAK_WJ  =  7, /**< Word Joiner */
+  UTF8PROC_LINEBREAK_ZW  =  8, /**< Zero Width Space */
+  UTF8PROC_LINEBREAK_GL  =  9, /**< Non-breaking(Glue) */
+  UTF8PROC_LINEBREAK_SP  = 10, /**< Space */
+  UTF8PROC_LINEBREAK_ZWJ = 11, /**< Zero Width Joiner */
+  UTF8PROC_LINEBREAK_B2  = 12, /**< Break Opportunity Before and After */
+  UTF8PROC_LINEBREAK_BA  = 13, /**< Break After */
+  UTF8PROC_LINEBREAK_BB  = 14, /**< Break Before */
+  UTF8PROC_LINEBREAK_HY  = 15, /**< Hyphen */
+  UTF8PROC_LINEBREAK_CB  = 16, /**< Contingent Break Opportunity */
+  UTF8PROC_LINEBREAK_CL  = 17, /**< Close Punctuation */
+  UTF8PROC_LINEBREAK_CP  = 18, /**< Close Parenthesis */
+  UTF8PROC_LINEBREAK_EX  = 19, /**< Exclamation/Interrogation */
+  UTF8PROC_LINEBREAK_IN  = 20, /**< Inseparable */
+  UTF8PROC_LINEBREAK_NS  = 21, /**< Nonstarter */
+  UTF8PROC_LINEBREAK_OP  = 22, /**< Open Punctuation */
+  UTF8PROC_LINEBREAK_QU  = 23, /**< Quotation */
+  UTF8PROC_LINEBREAK_IS  = 24, /**< Infix Numeric Separator */
+  UTF8PROC_LINEBREAK_NU  = 25, /**< Numeric */
+  UTF8PROC_LINEBREAK_PO  = 26, /**< Postfix Numeric */
+  UTF8PROC_LINEBREAK_PR  = 27, /**< Prefix Numeric */
+  UTF8PROC_LINEBREAK_SY  = 28, /**< Symbols Allowing Break After */
+  UTF8PROC_LINEBREAK_AI  = 29, /**< Ambiguous(Alphabetic or Ideographic) */
+  UTF8PROC_LINEBREAK_AL  = 30, /**< Alphabetic */
+  UTF8PROC_LINEBREAK_CJ  = 31, /**< Conditional Japanese Starter */
+  UTF8PROC_LINEBREAK_EB  = 32, /**< Emoji Base */
+  UTF8PROC_LINEBREAK_EM  = 33, /**< Emoji Modifier */
+  UTF8PROC_LINEBREAK_H2  = 34, /**< Hangul LV Syllable */
+  UTF8PROC_LINEBREAK_H3  = 35, /**< Hangul LVT Syllable */
+  UTF8PROC_LINEBREAK_HL  = 36, /**< Hebrew Letter */
+  UTF8PROC_LINEBREAK_ID  = 37, /**< Ideographic */
+  UTF8PROC_LINEBREAK_JL  = 38, /**< Hangul L Jamo */
+  UTF8PROC_LINEBREAK_JV  = 39, /**< Hangul V Jamo */
+  UTF8PROC_LINEBREAK_JT  = 40, /**< Hangul T Jamo */
+  UTF8PROC_LINEBREAK_RI  = 41, /**< Regional Indicator */
+  UTF8PROC_LINEBREAK_SA  = 42, /**< Complex Context Dependent(South East Asian) */
+} utf8proc_linebreak_t;
+
 /**
  * Array containing the byte lengths of a UTF-8 encoded codepoint based
  * on the first byte.
@@ -389,6 +634,34 @@ UTF8PROC_DLLEXPORT extern const utf8proc_int8_t utf8proc_utf8class[256];
  */
 UTF8PROC_DLLEXPORT const char *utf8proc_version(void);
 
+/**
+ * Returns the version of the Unicode data the tables were generated from
+ * as a string MAJOR.MINOR.PATCH.
+ */
+UTF8PROC_DLLEXPORT const char *utf8proc_unicode_version(void);
+
+#if UTF8STR_EXTERNAL_DATA
+/**
+ * Maps the Unicode data file at `path`, written by tools/utf8datafile.c, and
+ * makes all property lookups read its tables.
+ *
+ * Only libraries built with `UTF8STR_EXTERNAL_DATA` read a data file. Until
+ * it is loaded all code points are unassigned and @ref
+ * utf8proc_unicode_version returns an empty string. The file must have the
+ * table layout, byte order and structure sizes of the library, which the
+ * header of the file and the checksum of the tables are checked against.
+ *
+ * Call it once at startup, before other threads use the library: the tables
+ * of a previously loaded file stay mapped, since the results of
+ * utf8proc_get_property may point into them.
+ *
+ * @return 0 on success, or @ref UTF8PROC_ERROR_INVALIDDATA if the file
+ *         cannot be read or does not match the library, in which case the
+ *         tables in use are kept.
+ */
+UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_load_data(const char *path);
+#endif
+
 /**
  * Returns an informative error string for the given utf8proc error code
  * (e.g. the error codes returned by @ref utf8proc_map).
@@ -426,6 +699,7 @@ UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_codepoint_valid(utf8proc_int32_t codep
  */
 UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_encode_char(utf8proc_int32_t codepoint, utf8proc_uint8_t *dst);
 
+#if UTF8STR_WITH_CASE || UTF8STR_WITH_NORMALIZATION
 /**
  * Look up the properties for a given codepoint.
  *
@@ -439,7 +713,9 @@ UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_encode_char(utf8proc_int32_t codepo
  * returned in which `category` is 0 (@ref UTF8PROC_CATEGORY_CN).
  */
 UTF8PROC_DLLEXPORT const utf8proc_property_t *utf8proc_get_property(utf8proc_int32_t codepoint);
+#endif
 
+#if UTF8STR_WITH_NORMALIZATION
 /** Decompose a codepoint into an array of codepoints.
  *
  * @param codepoint the codepoint.
@@ -519,7 +795,9 @@ UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_decompose(
  *          range `0x0000` to `0x10FFFF`. Otherwise, the program might crash!
  */
 UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_reencode(utf8proc_int32_t *buffer, utf8proc_ssize_t length, utf8proc_option_t options);
+#endif
 
+#if UTF8STR_WITH_GRAPHEME
 /**
  * Given a pair of consecutive codepoints, return whether a grapheme break is
  * permitted between them (as defined by the extended grapheme clusters in UAX#29).
@@ -544,7 +822,17 @@ UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_grapheme_break_stateful(
 UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_grapheme_break(
     utf8proc_int32_t codepoint1, utf8proc_int32_t codepoint2);
 
+/**
+ * Same as @ref utf8proc_grapheme_break_stateful for codepoints of the
+ * boundclasses `boundclass1` and `boundclass2` (see @ref utf8proc_width_props),
+ * for callers that have looked them up already.
+ */
+UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_grapheme_break_boundclass(
+    int boundclass1, int boundclass2, utf8proc_int32_t *state);
+#endif
+
 
+#if UTF8STR_WITH_CASE
 /**
  * Given a codepoint `c`, return the codepoint of the corresponding
  * lower-case character, if any; otherwise (if there is no lower-case
@@ -565,7 +853,9 @@ UTF8PROC_DLLEXPORT utf8proc_int32_t utf8proc_toupper(utf8proc_int32_t c);
  * variant, or if `c` is not a valid codepoint) return `c`.
  */
 UTF8PROC_DLLEXPORT utf8proc_int32_t utf8proc_totitle(utf8proc_int32_t c);
+#endif
 
+#if UTF8STR_WITH_WIDTH
 /**
  * Given a codepoint, return a character width analogous to `wcwidth(codepoint)`,
  * except that a width of 0 is returned for non-printable codepoints
@@ -576,6 +866,22 @@ UTF8PROC_DLLEXPORT utf8proc_int32_t utf8proc_totitle(utf8proc_int32_t c);
  * (analogous to `isprint` or `iscntrl`), use @ref utf8proc_category. */
 UTF8PROC_DLLEXPORT int utf8proc_charwidth(utf8proc_int32_t codepoint);
 
+/**
+ * Return whether the codepoint is East Asian Ambiguous (e.g. `±`, `→` and
+ * Greek letters): @ref utf8proc_charwidth counts one column for it, CJK
+ * locales and fonts display it in two.
+ */
+UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_charwidth_ambiguous(utf8proc_int32_t codepoint);
+
+/**
+ * Return what measuring a string reads for the codepoint, with one table
+ * lookup: @ref utf8proc_charwidth in bits 0-1, 4 if the codepoint is East
+ * Asian Ambiguous, the @ref utf8proc_emoji flags in bits 3-7 and the
+ * @ref utf8proc_boundclass_t in bits 8-15.
+ */
+UTF8PROC_DLLEXPORT int utf8proc_width_props(utf8proc_int32_t codepoint);
+#endif
+
 /**
  * Return the Unicode category for the codepoint (one of the
  * @ref utf8proc_category_t constants.)
@@ -588,6 +894,68 @@ UTF8PROC_DLLEXPORT utf8proc_category_t utf8proc_category(utf8proc_int32_t codepo
  */
 UTF8PROC_DLLEXPORT const char *utf8proc_category_string(utf8proc_int32_t codepoint);
 
+/**
+ * Return the emoji properties of the codepoint: a combination of the
+ * @ref utf8proc_emoji_t flags, 0 for codepoints that are not emoji.
+ */
+UTF8PROC_DLLEXPORT int utf8proc_emoji(utf8proc_int32_t codepoint);
+
+/**
+ * Return the @ref utf8proc_quick_t flags of the codepoint with its
+ * canonical combining class in bits 8-15, all read with one table lookup.
+ */
+UTF8PROC_DLLEXPORT int utf8proc_quick_props(utf8proc_int32_t codepoint);
+
+#if UTF8STR_WITH_SCRIPT
+/**
+ * Return the script of the codepoint (one of the @ref utf8proc_script_t
+ * constants): @ref UTF8PROC_SCRIPT_COMMON for characters used with
+ * several scripts, @ref UTF8PROC_SCRIPT_INHERITED for combining marks that
+ * take the script of their base and @ref UTF8PROC_SCRIPT_UNKNOWN for
+ * unassigned or invalid codepoints.
+ */
+UTF8PROC_DLLEXPORT utf8proc_script_t utf8proc_script(utf8proc_int32_t codepoint);
+
+/**
+ * Get the scripts the codepoint is used with (Script_Extensions property),
+ * e.g. Devanagari and Bengali for the danda U+0964. Codepoints without
+ * extensions are used with their script only.
+ *
+ * @param codepoint the codepoint
+ * @param dst receives the scripts in the order of @ref utf8proc_script_t
+ * @param bufsize the number of elements of `dst`
+ * @return the number of scripts, which may be greater than `bufsize`: only
+ *         the first `bufsize` ones are written then.
+ */
+UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_script_extensions(
+  utf8proc_int32_t codepoint, utf8proc_script_t *dst, utf8proc_ssize_t bufsize
+);
+
+/**
+ * Return whether the codepoint is used with the script: whether the script is
+ * one of its @ref utf8proc_script_extensions.
+ */
+UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_has_script(utf8proc_int32_t codepoint, utf8proc_script_t script);
+
+/**
+ * Return the four-letter ISO 15924 code of the script (e.g. `"Latn"`),
+ * `"Zzzz"` for values that are not scripts.
+ */
+UTF8PROC_DLLEXPORT const char *utf8proc_script_code(utf8proc_script_t script);
+#endif
+
+#if UTF8STR_WITH_LINEBREAK
+/**
+ * Return the line breaking class of the codepoint (one of the
+ * @ref utf8proc_linebreak_t constants), @ref UTF8PROC_LINEBREAK_XX for
+ * unassigned or invalid codepoints. The classes are not resolved: e.g.
+ * @ref UTF8PROC_LINEBREAK_AI and @ref UTF8PROC_LINEBREAK_SA are returned as
+ * they are.
+ */
+UTF8PROC_DLLEXPORT utf8proc_linebreak_t utf8proc_linebreak(utf8proc_int32_t codepoint);
+#endif
+
+#if UTF8STR_WITH_NORMALIZATION
 /**
  * Maps the given UTF-8 string pointed to by `str` to a new UTF-8
  * string, allocated dynamically by `malloc` and returned via `dstptr`.
@@ -627,6 +995,7 @@ UTF8PROC_DLLEXPORT utf8proc_uint8_t *utf8proc_NFKD(const utf8proc_uint8_t *str);
 /** NFD normalization (@ref UTF8PROC_COMPOSE and @ref UTF8PROC_COMPAT). */
 UTF8PROC_DLLEXPORT utf8proc_uint8_t *utf8proc_NFKC(const utf8proc_uint8_t *str);
 /** @} */
+#endif
 
 #ifdef __cplusplus
 }
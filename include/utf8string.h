@@ -1,6 +1,34 @@
 #ifndef UTF8STRING_20170130
 #define UTF8STRING_20170130
 
+#include <stddef.h>
+#include <stdint.h>
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
+/* Features built into the library. Setting one to 0(CMake options of the same
+ * names) leaves out its functions and the Unicode tables only they read.
+ * Programs must be compiled with the same definitions as the library */
+#ifndef UTF8STR_WITH_NORMALIZATION
+#define UTF8STR_WITH_NORMALIZATION 1
+#endif
+#ifndef UTF8STR_WITH_CASE
+#define UTF8STR_WITH_CASE 1
+#endif
+#ifndef UTF8STR_WITH_WIDTH
+#define UTF8STR_WITH_WIDTH 1
+#endif
+#ifndef UTF8STR_WITH_GRAPHEME
+#define UTF8STR_WITH_GRAPHEME 1
+#endif
+#ifndef UTF8STR_WITH_SCRIPT
+#define UTF8STR_WITH_SCRIPT 1
+#endif
+#ifndef UTF8STR_WITH_LINEBREAK
+#define UTF8STR_WITH_LINEBREAK 1
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -19,8 +47,129 @@ enum utf8_result {
     UTF8_OUT_OF_MEMORY,
     UTF8_NO_WORDS,
     UTF8_INVALID_ITERATOR,
+    UTF8_NOT_FOUND,
+};
+
+/** Language-specific rules for case conversion. See utf8str_upcase_locale */
+enum utf8_locale {
+    /** Locale-independent simple case mapping */
+    UTF8_LOCALE_DEFAULT,
+    /** Turkish and Azerbaijani: dotted and dotless I */
+    UTF8_LOCALE_TURKIC,
+    /** Lithuanian: keeps the dot above i and j when accents are added */
+    UTF8_LOCALE_LITHUANIAN,
+    /** Greek: final sigma in lowercase, no accents in uppercase */
+    UTF8_LOCALE_GREEK,
+};
+
+/** Word separators for utf8str_titlecase_copy. The flags can be combined */
+enum utf8_title_break {
+    /** Whitespace characters */
+    UTF8_TITLE_SPACE = 1,
+    /** Punctuation except dashes and apostrophes(' and U+2019), so "it's"
+     *  is still one word */
+    UTF8_TITLE_PUNCT = 2,
+    /** Dashes and hyphens */
+    UTF8_TITLE_DASH = 4,
+    UTF8_TITLE_ALL = UTF8_TITLE_SPACE | UTF8_TITLE_PUNCT | UTF8_TITLE_DASH,
 };
 
+/** Options for utf8str_fold_key. The flags can be combined */
+enum utf8_fold_flags {
+    /** Compose the key to Normalization Form C */
+    UTF8_FOLD_NFC = 1,
+    /** Compose the key to Normalization Form KC(compatibility characters
+     *  like ligatures and full-width letters are replaced as well) */
+    UTF8_FOLD_NFKC = 2,
+    /** Remove all combining marks(accents). The key is composed to NFC if
+     *  UTF8_FOLD_NFKC is not set */
+    UTF8_FOLD_STRIP_MARKS = 4,
+};
+
+/** What a string contains, see utf8str_quick_check. The _quick functions
+ *  return at once or take a shortcut when the flags show that there is
+ *  nothing to do */
+enum utf8_quick_flags {
+    /** The flags are computed: 0 passed to a _quick function means that it
+     *  must compute them itself */
+    UTF8_QUICK_DONE = 0x01,
+    /** All characters are ASCII */
+    UTF8_QUICK_ASCII = 0x02,
+    /** The string is in NFC: all characters have NFC_Quick_Check=Yes and
+     *  combining marks are in canonical order */
+    UTF8_QUICK_NFC = 0x04,
+    /** Has characters with non-zero combining class */
+    UTF8_QUICK_COMBINING = 0x08,
+    /** Has characters that case conversion or case folding changes */
+    UTF8_QUICK_CASE_MAP = 0x10,
+    /** Has control characters(Cc) or bidi controls(e.g. U+200F) */
+    UTF8_QUICK_CONTROL = 0x20,
+    /** Every character takes one column */
+    UTF8_QUICK_NARROW = 0x40,
+    /** Has an invalid UTF8 sequence. Other flags describe only the
+     *  characters before it, so the _quick functions do all work */
+    UTF8_QUICK_INVALID = 0x80,
+};
+
+/** The largest lead byte of multibyte characters from utf8str_quick_check
+ *  flags, 0 if all characters are ASCII. E.g, it is below 0xE0 if there are
+ *  no characters longer than 2 bytes */
+#define UTF8_QUICK_MAX_LEAD(flags) (((flags) >> 8) & 0xFF)
+
+/** Character classes for utf8str_isclass. The flags can be combined */
+enum utf8_char_class {
+    /** Nd, Nl, No - see utf8str_isdigit */
+    UTF8_CLASS_DIGIT = 0x0001,
+    /** Zs and codes 0x09-0x0D - see utf8str_isspace */
+    UTF8_CLASS_SPACE = 0x0002,
+    /** Pc, Pd, Ps, Pe, Pi, Pf, Po - see utf8str_ispunct */
+    UTF8_CLASS_PUNCT = 0x0004,
+    /** Lu, Ll, Lt, Lo - see utf8str_isalpha */
+    UTF8_CLASS_ALPHA = 0x0008,
+    /** Lu, Lt - see utf8str_isupper */
+    UTF8_CLASS_UPPER = 0x0010,
+    /** Ll - see utf8str_islower */
+    UTF8_CLASS_LOWER = 0x0020,
+    /** Cc - see utf8str_iscntrl */
+    UTF8_CLASS_CNTRL = 0x0040,
+    /** see utf8str_isprint */
+    UTF8_CLASS_PRINT = 0x0080,
+    /** Characters of identifiers and words: L*, Mn, Mc, Nd, Pc */
+    UTF8_CLASS_WORD = 0x0100,
+    /** Mn, Mc, Me */
+    UTF8_CLASS_MARK = 0x0200,
+    /** Sm, Sc, Sk, So */
+    UTF8_CLASS_SYMBOL = 0x0400,
+    /** Lu, Ll, Lt */
+    UTF8_CLASS_CASED = 0x0800,
+};
+
+/** Custom memory allocator for functions that return newly allocated strings.
+ *  See functions utf8str_*_alloc
+ */
+struct utf8str_alloc_t {
+    /** Works as standard realloc: allocates a new block if ptr is NULL or
+     *  changes the size of the existing one. Returns NULL if it fails
+     */
+    void* (*resize)(void *ctx, void *ptr, size_t size);
+    /** Works as standard free */
+    void (*release)(void *ctx, void *ptr);
+    /** User data that is passed to resize and release as is */
+    void *ctx;
+};
+
+/** A piece of scattered output, e.g. of utf8str_pad_iov: struct iovec that
+ *  writev takes, or a structure of the same fields on Windows
+ */
+#ifdef _WIN32
+typedef struct {
+    void *iov_base;
+    size_t iov_len;
+} utf8str_iovec_t;
+#else
+typedef struct iovec utf8str_iovec_t;
+#endif
+
 struct utf8str_iter_internal_t;
 /** Structure to keep information about word iterator.
  *  See functions utf8str_iter_*
@@ -53,6 +202,232 @@ struct utf8str_iter_t {
     enum utf8_result result;
 };
 
+struct utf8str_needle_t;
+/** Position of a found substring and the point where the next search starts.
+ *  See function utf8str_find_no_case
+ */
+struct utf8str_match_t {
+    /** Offset of the first byte of the match from the haystack beginning */
+    size_t byte_offset;
+    /** Number of UTF8 characters before the match in the haystack */
+    size_t char_offset;
+    /** Length of the match in bytes. It may differ from the needle length,
+     *  e.g. when searching "i" in "ı"
+     */
+    size_t byte_length;
+    /** Length of the match in UTF8 characters */
+    size_t char_length;
+    /** Byte offset in the haystack the next search starts from. It is 0 for
+     *  a zero-initialized structure
+     */
+    size_t next_byte;
+    /** Number of UTF8 characters before next_byte */
+    size_t next_char;
+};
+
+/** Kinds of emoji sequences(UTS #51) found by utf8str_emoji_next */
+enum utf8_emoji_kind {
+    /** A single emoji with an optional variation selector */
+    UTF8_EMOJI_CHAR,
+    /** An emoji with a skin tone modifier */
+    UTF8_EMOJI_MODIFIER,
+    /** A flag: a pair of regional indicators */
+    UTF8_EMOJI_FLAG,
+    /** A keycap: a digit, '#' or '*' followed by U+20E3 */
+    UTF8_EMOJI_KEYCAP,
+    /** An emoji followed by tag characters, e.g. a subdivision flag */
+    UTF8_EMOJI_TAG,
+    /** Emoji joined with ZERO WIDTH JOINER, e.g. a family */
+    UTF8_EMOJI_ZWJ,
+};
+
+/** An emoji sequence found by utf8str_emoji_next */
+struct utf8str_emoji_t {
+    /** Offset of the first byte of the sequence from the string beginning */
+    size_t byte_offset;
+    /** Length of the sequence in bytes */
+    size_t byte_length;
+    /** Length of the sequence in UTF8 characters */
+    size_t char_length;
+    /** Kind of the sequence */
+    enum utf8_emoji_kind kind;
+    /** Byte offset in the string the next search starts from. It is 0 for
+     *  a zero-initialized structure
+     */
+    size_t next_byte;
+};
+
+/** Width rules for utf8str_width_ex. The flags can be combined */
+enum utf8_width_flags {
+    /** East Asian Ambiguous characters(e.g. "\u00B1", "\u2192", Greek
+     *  letters) take two columns as in CJK locales instead of one */
+    UTF8_WIDTH_AMBIGUOUS_WIDE = 0x01,
+    /** Emoji sequences are shown as text, as by terminals without emoji
+     *  support: their characters take their own widths and U+FE0F does not
+     *  widen a character. By default a flag, a keycap, a ZWJ sequence or an
+     *  emoji with U+FE0F or a skin tone modifier takes two columns
+     */
+    UTF8_WIDTH_EMOJI_TEXT = 0x02,
+};
+
+/** Number of slots of utf8str_width_cache_t */
+#define UTF8STR_WIDTH_CACHE_SIZE 64
+/** Longest grapheme cluster in bytes that utf8str_width_cache_t keeps */
+#define UTF8STR_WIDTH_CACHE_BYTES 28
+
+/** Widths of recently measured grapheme clusters of several characters, e.g.
+ *  emoji sequences or letters with accents, for utf8str_width_ex. A cluster
+ *  has one slot chosen by its first two characters and replaces the cluster
+ *  kept there. Zero-initialize it before the first use. It can be kept
+ *  between calls with any strings and flags, but not shared by threads
+ */
+struct utf8str_width_cache_t {
+    /** Internal: the slots, a slot with zero length is empty */
+    struct utf8str_width_slot_t {
+        unsigned char length;
+        unsigned char width;
+        unsigned char flags;
+        unsigned char state;
+        char bytes[UTF8STR_WIDTH_CACHE_BYTES];
+    } slots[UTF8STR_WIDTH_CACHE_SIZE];
+};
+
+/** Modes of utf8str_expand_tabs_ex. They can be combined with
+ *  utf8_width_flags
+ */
+enum utf8_tab_flags {
+    /** A TAB reaches the next tab stop instead of taking tab_sz columns */
+    UTF8_TAB_STOPS = 0x100,
+};
+
+/** Where utf8str_truncate_width leaves text out of a string that is too wide */
+enum utf8_elide_mode {
+    /** Keeps the beginning: "Hello w\u2026" */
+    UTF8_ELIDE_END,
+    /** Keeps the end: "\u2026o world" */
+    UTF8_ELIDE_START,
+    /** Keeps both, the beginning gets the odd column: "Hell\u2026rld" */
+    UTF8_ELIDE_MIDDLE,
+};
+
+/** Where utf8str_pad and the justify functions add the fill */
+enum utf8_pad_mode {
+    /** After the text: "Hello.." */
+    UTF8_PAD_END,
+    /** Before the text: "..Hello" */
+    UTF8_PAD_START,
+    /** On both sides, the end gets the odd column: ".Hello.." */
+    UTF8_PAD_BOTH,
+};
+
+/** Cut points of utf8str_truncate_width. The truncated string is the bytes
+ *  before head_end, the ellipsis and the bytes from tail_start. A string
+ *  that fits has both offsets at its end
+ */
+struct utf8str_truncate_t {
+    /** Byte offset where the kept beginning ends */
+    size_t head_end;
+    /** Byte offset where the kept end starts, the length of the string for
+     *  UTF8_ELIDE_END
+     */
+    size_t tail_start;
+    /** Width of the truncated string in columns with the ellipsis */
+    size_t width;
+    /** Non-zero if the ellipsis goes between the two parts. It is 0 if the
+     *  string fits or the ellipsis alone is too wide
+     */
+    int ellipsis;
+};
+
+/** A fill of utf8str_pad_iov made once by utf8str_fill_init: the pattern
+ *  repeated, which padded strings refer to instead of copying it. It is not
+ *  changed after utf8str_fill_init, so threads can share it
+ */
+struct utf8str_fill_t {
+    /** Whole copies of the pattern, NUL-terminated */
+    char *data;
+    /** Number of copies in data */
+    size_t copies;
+    /** Size in bytes and width in columns of one copy */
+    size_t pattern_sz;
+    size_t pattern_width;
+    /** utf8_width_flags of the padded strings and the pattern */
+    unsigned int flags;
+    /** Internal: the allocator of data */
+    struct utf8str_alloc_t alloc;
+};
+
+/** A position in a line indexed by utf8str_colindex_t */
+struct utf8str_colpos_t {
+    /** Offset from the line beginning in bytes */
+    size_t byte_offset;
+    /** Number of UTF8 characters before the position */
+    size_t char_offset;
+    /** Display column of the position, 0 for the line beginning */
+    size_t column;
+};
+
+/** Column index of a long line: checkpoints every step columns that let
+ *  utf8str_colindex_column_to_byte and utf8str_colindex_byte_to_column
+ *  measure at most about step columns instead of the line from its start.
+ *  Columns are counted as by utf8str_width_ex. See utf8str_colindex_init
+ */
+struct utf8str_colindex_t {
+    /** Columns between checkpoints */
+    size_t step;
+    /** Distance between tab stops in columns, 0 if a tab takes no columns
+     *  as other control characters
+     */
+    size_t tab_size;
+    /** utf8_width_flags */
+    unsigned int flags;
+    /** The end of the indexed text */
+    struct utf8str_colpos_t end;
+    /** Internal: the start of the last grapheme cluster, appended text may
+     *  add to it
+     */
+    struct utf8str_colpos_t last;
+    /** Internal: the checkpoints, the last boundary of grapheme clusters at
+     *  or before the columns 0, step, 2 * step and so on
+     */
+    struct utf8str_colpos_t *marks;
+    size_t count;
+    size_t capacity;
+    /** Internal: the allocator of marks */
+    struct utf8str_alloc_t alloc;
+};
+
+/** A line of utf8str_wrap: the bytes from offset to offset + length of the
+ *  wrapped string. The spaces and the line break after the line are left out
+ */
+struct utf8str_line_t {
+    /** Byte offset of the line in the string */
+    size_t offset;
+    /** Length of the line in bytes */
+    size_t length;
+    /** Width of the line in columns */
+    size_t width;
+};
+
+struct utf8str_paragraph_break_t;
+/** Paragraph formatter of utf8str_paragraph_justify. Its working memory is
+ *  kept between paragraphs, so a formatter that is used for many of them
+ *  allocates only when a paragraph is longer than all before it. See
+ *  utf8str_paragraph_init
+ */
+struct utf8str_paragraph_t {
+    /** Width of the justified lines in columns */
+    size_t max_cols;
+    /** utf8_width_flags */
+    unsigned int flags;
+    /** Internal: the break opportunities of the last paragraph */
+    struct utf8str_paragraph_break_t *breaks;
+    size_t count;
+    size_t capacity;
+    /** Internal: the allocator of breaks */
+    struct utf8str_alloc_t alloc;
+};
+
 /* Basic operations */
 
 /**
@@ -80,6 +455,19 @@ size_t utf8str_char_length(const char *str);
 
 enum utf8_result utf8str_is_valid(const char *str, size_t len);
 
+/** Scans the string once and returns utf8_quick_flags with the largest lead
+ *   byte(see UTF8_QUICK_MAX_LEAD). The flags can be kept with the string and
+ *   passed to the _quick functions, which skip the work the string does not
+ *   need. ASCII text is checked a block of bytes at a time
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * Returns 0 if str is NULL
+ * Examples:
+ *    utf8str_quick_check("hello", 0) - DONE | ASCII | NFC | NARROW | CASE_MAP
+ *    utf8str_quick_check("e\xcc\x81", 0) - DONE | COMBINING | CASE_MAP,
+ *        max lead byte 0xCC
+ */
+unsigned int utf8str_quick_check(const char *str, size_t len);
+
 /** Returns pointer to a bytes that starts UTF8 character at position index
  *  If str is NULL or str points to invalid UTF8 sequence it returns NULL
  * \param[in] index - character index to find in the string. It can be negative,
@@ -91,6 +479,7 @@ enum utf8_result utf8str_is_valid(const char *str, size_t len);
  */
 const char* utf8str_at_index(const char *str, ssize_t index);
 
+#if UTF8STR_WITH_CASE
 /** Transforms the string to uppercase letters. It does not change original string
  * \param[in] src - original string
  * \param[out] dest - uppercased string will be copied to this buffer
@@ -159,6 +548,126 @@ enum utf8_result utf8str_upcase_inplace(char *src, size_t count);
  */
 enum utf8_result utf8str_lowcase_inplace(char *src, size_t count);
 
+/** Transforms the string to uppercase one inplace. Unlike utf8str_upcase_inplace
+ *   it allows the string to grow up to the buffer size, and it is atomic: in
+ *   case of any error the string is left untouched
+ * \param[in] buf_sz - size of the buffer that holds the string in bytes. It
+ *    must be greater than the string length
+ * \param[in] count - number of UTF8 characters to transform. If it is 0 then the whole
+ *    string is transformed
+ * Returns:
+ *   UTF8_OK - conversion is successful
+ *   UTF8_INVALID_ARG - str is NULL or buf_sz is not greater than the string length
+ *   UTF8_INVALID_UTF - str points to the invalid UTF8 sequence
+ *   UTF8_BUFFER_SMALL - the converted string does not fit the buffer
+ */
+enum utf8_result utf8str_upcase_inplace_sz(char *str, size_t buf_sz, size_t count);
+
+/** Transforms the string to lowercase one inplace. See utf8str_upcase_inplace_sz
+ */
+enum utf8_result utf8str_lowcase_inplace_sz(char *str, size_t buf_sz, size_t count);
+
+/** Transforms the string to uppercase letters and puts the result to a newly
+ *   allocated buffer. Unlike utf8str_upcase it needs only one pass: the buffer
+ *   grows while the string is converted
+ *  \param[in] src - original string
+ *  \param[out] dest - receives the pointer to the uppercased string. The caller
+ *     must free it with 'alloc' release function, or with free if 'alloc' is
+ *     NULL. In case of error it is set to NULL
+ *  \param[out] dest_len - if it is not NULL then the function assigns the
+ *     length of the result in bytes(without trailing '\0' character)
+ *  \param[in] alloc - custom allocator. If it is NULL then realloc and free
+ *     are used
+ * Can return:
+ *  UTF8_OK - conversion successful
+ *  UTF8_INVALID_ARG - in case of src or dest is NULL
+ *  UTF8_INVALID_UTF - in case of src is not a valid UTF8 sequence
+ *  UTF8_OUT_OF_MEMORY - the allocator failed
+ */
+enum utf8_result utf8str_upcase_alloc(const char *src, char **dest, size_t *dest_len, const struct utf8str_alloc_t *alloc);
+
+/** Transforms the string to lowercase letters and puts the result to a newly
+ *   allocated buffer. See utf8str_upcase_alloc
+ */
+enum utf8_result utf8str_lowcase_alloc(const char *src, char **dest, size_t *dest_len, const struct utf8str_alloc_t *alloc);
+
+/** Returns the case conversion rules for a locale name. Only the language part
+ *   of the name is checked, so "tr", "tr_TR" and "tr_TR.UTF-8" are the same.
+ *   Unknown languages and NULL return UTF8_LOCALE_DEFAULT
+ *  Examples:
+ *     utf8str_locale("az_AZ") == UTF8_LOCALE_TURKIC
+ *     utf8str_locale("el-GR") == UTF8_LOCALE_GREEK
+ */
+enum utf8_locale utf8str_locale(const char *name);
+
+/** Transforms the string to uppercase letters using language-specific rules.
+ *   Parameters and return values are the same as for utf8str_upcase. With
+ *   UTF8_LOCALE_DEFAULT the function works exactly as utf8str_upcase does.
+ *   Note: a character may be converted to a few characters or removed, e.g.
+ *   in Lithuanian "i" + COMBINING DOT ABOVE becomes "I"
+ *  Examples:
+ *     utf8str_upcase_locale("istanbul", d, NULL, UTF8_LOCALE_TURKIC) - "İSTANBUL"
+ *     utf8str_upcase_locale("άλφα", d, NULL, UTF8_LOCALE_GREEK) - "ΑΛΦΑ"
+ */
+enum utf8_result utf8str_upcase_locale(const char *src, char *dest, size_t *dest_sz, enum utf8_locale locale);
+
+/** Transforms the string to lowercase letters using language-specific rules.
+ *   Parameters and return values are the same as for utf8str_lowcase. With
+ *   UTF8_LOCALE_DEFAULT the function works exactly as utf8str_lowcase does.
+ *  Examples:
+ *     utf8str_lowcase_locale("ISPARTA", d, NULL, UTF8_LOCALE_TURKIC) - "ısparta"
+ *     utf8str_lowcase_locale("ΟΔΟΣ", d, NULL, UTF8_LOCALE_GREEK) - "οδος"
+ *         (the last letter is final sigma)
+ */
+enum utf8_result utf8str_lowcase_locale(const char *src, char *dest, size_t *dest_sz, enum utf8_locale locale);
+
+/** utf8str_upcase and utf8str_lowcase with utf8str_quick_check flags of src:
+ *   a string without UTF8_QUICK_CASE_MAP is copied as is, an ASCII string is
+ *   converted without decoding. Parameters and return values are the same
+ *   \param[in] quick - flags of src, 0 to compute them
+ */
+enum utf8_result utf8str_upcase_quick(const char *src, char *dest, size_t *dest_sz, unsigned int quick);
+enum utf8_result utf8str_lowcase_quick(const char *src, char *dest, size_t *dest_sz, unsigned int quick);
+
+#if UTF8STR_WITH_NORMALIZATION
+/** Builds a caseless key for a string: applies full case folding("ß" becomes
+ *   "ss") and optionally normalization and accent removal in one pass. Two
+ *   strings that differ only in case(and in normalization or accents if
+ *   corresponding flags are set) get the same key. The function never
+ *   allocates memory
+ * \param[in] src - a UTF8 string
+ * \param[in] len - length of src in bytes. If len is 0 then src must be
+ *    zero-terminated
+ * \param[out] dst - buffer for the key. Can be NULL to calculate the size
+ * \param[in] cap - size of dst in bytes. The key is written only if it fits
+ *    dst along with its trailing zero
+ * \param[in] flags - a combination of utf8_fold_flags, 0 means case folding
+ *    only
+ * Returns:
+ *    the key length in bytes without trailing zero. If it is not less than
+ *    cap then the key does not fit the buffer and the buffer contains only
+ *    its beginning, so call the function again with a buffer of return
+ *    value + 1 bytes.
+ *    (size_t)-1 if src is NULL or it is not a valid UTF8 sequence
+ * Note: as in Stream-Safe Text Format, very long sequences of combining
+ *    characters(more than 32 code points) are normalized in chunks
+ * Examples:
+ *    utf8str_fold_key("Straße", 0, d, 16, 0) - 7, "strasse"
+ *    utf8str_fold_key("ＣＡＦÉ", 0, d, 16, UTF8_FOLD_NFKC | UTF8_FOLD_STRIP_MARKS)
+ *       - 4, "cafe"
+ */
+size_t utf8str_fold_key(const char *src, size_t len, char *dst, size_t cap, unsigned int flags);
+
+/** utf8str_fold_key with utf8str_quick_check flags of src: a string that
+ *   folding and the normalization of flags do not change is copied, an
+ *   ASCII string is lowercased without decoding. Parameters and return
+ *   values are the same
+ * \param[in] quick - flags of src, 0 to compute them
+ */
+size_t utf8str_fold_key_quick(const char *src, size_t len, char *dst, size_t cap,
+        unsigned int flags, unsigned int quick);
+#endif
+
 /* Checks if two UTF8 strings equal(ignoring case).
  * Returns:
  *   UTF8_EQUAL - strings are the same
@@ -176,6 +685,7 @@ enum utf8_result utf8str_equal_no_case(const char *orig, const char *cmp);
  *   UTF8_INVALID_UTF - one string(or both strings) has invalid UTF8 sequence
  */
 enum utf8_result utf8str_nequal_no_case(const char *orig, const char *cmp, size_t len);
+#endif
 
 /* Checks if UTF8 string starts with prefix(casesensitive).
  * Returns:
@@ -193,6 +703,51 @@ enum utf8_result utf8str_starts_with(const char *orig, const char *cmp);
  */
 enum utf8_result utf8str_ends_with(const char *orig, const char *cmp);
 
+#if UTF8STR_WITH_CASE
+/** Prepares a string for case-insensitive search with utf8str_find_no_case.
+ *  The needle is converted to uppercase(characters are compared in the same
+ *  way as utf8str_equal_no_case does) and the skip table is built once, so the
+ *  needle can be reused for any number of haystacks. The needle is never
+ *  modified by searching, so it is safe to share it between threads
+ *  \param[in] str - a UTF8 string to search for. It is copied, so it is safe
+ *      to delete it right after initialization
+ *  Returns:
+ *      NULL in case of error (out of memory, str is NULL, empty or has invalid
+ *      UTF8 sequence) or poiner to initalized needle
+ */
+struct utf8str_needle_t* utf8str_needle_init(const char *str);
+/** Frees a memory allocated for the needle by initialization.
+ *  \param[in] needle - an initialized needle. It is safe to free a pointer
+ *      that is NULL
+ *  Returns:
+ *     UTF8_OK - freeing memory is successful
+ */
+enum utf8_result utf8str_needle_free(struct utf8str_needle_t *needle);
+/** Finds the next occurrence of needle in haystack ignoring case. The
+ *  haystack is converted on the fly, the function does not do any memory
+ *  allocations
+ *  \param[in] haystack - a UTF8 string to search in
+ *  \param[in] needle - a needle initialized with utf8str_needle_init
+ *  \param[in,out] match - zero-initialize it before the first search. If the
+ *      needle is found the match position is written to the structure and the
+ *      next call with the same structure continues the search right after the
+ *      match(found occurrences never overlap)
+ *  Returns:
+ *     UTF8_OK - the needle is found
+ *     UTF8_NOT_FOUND - there is no more occurrences, match is not changed
+ *     UTF8_INVALID_ARG - any argument is NULL
+ *     UTF8_INVALID_UTF - haystack has invalid UTF8 sequence before the next
+ *      occurrence
+ *  Examples:
+ *     utf8str_find_no_case("Log: ERROR, error", "error" needle, match):
+ *       the first call - OK, byte_offset = char_offset = 5
+ *       the second call - OK, byte_offset = char_offset = 12
+ *       the third call - NOT_FOUND
+ */
+enum utf8_result utf8str_find_no_case(const char *haystack,
+        const struct utf8str_needle_t *needle, struct utf8str_match_t *match);
+#endif
+
 /** Retuns non-zero value if the first character of str is digit
  * Digit is any character from UTF8 categories:
  *     Nd - Number, Decimal Digit
@@ -253,11 +808,431 @@ int utf8str_isalpha(const char *str);
  */
 int utf8str_isprint(const char *str);
 
+/** Retuns non-zero value if the first character of str belongs to any of
+ *    the classes
+ * \param[in] classes - a combination of utf8_char_class flags
+ * Examples:
+ *    utf8str_isclass("_id", UTF8_CLASS_WORD) - non-zero
+ *    utf8str_isclass("+", UTF8_CLASS_PUNCT | UTF8_CLASS_SYMBOL) - non-zero
+ */
+int utf8str_isclass(const char *str, unsigned int classes);
+
+/* The character class table generated by tools/utf8classgen.c. It is public
+ * only for the inline functions below, use utf8str_class_cp instead */
+#define UTF8STR_CLASS_LEAF_BITS 3
+#define UTF8STR_CLASS_MID_BITS 5
+extern const uint8_t utf8str_class_top[];
+extern const uint16_t utf8str_class_mid[];
+extern const uint16_t utf8str_class_leaf[];
+
+/** Returns the combination of utf8_char_class flags of a code point or 0 if
+ *    cp is not a valid code point. The code point versions of the functions
+ *    above let a loop that already decodes characters(e.g, with
+ *    utf8proc_iterate) classify them without decoding them again
+ * Examples:
+ *    utf8str_class_cp(0x41) - UTF8_CLASS_ALPHA | UTF8_CLASS_UPPER |
+ *        UTF8_CLASS_PRINT | UTF8_CLASS_WORD | UTF8_CLASS_CASED
+ *    utf8str_class_cp(-1) - 0
+ */
+static inline unsigned int utf8str_class_cp(int32_t cp) {
+    if ((uint32_t)cp >= 0x110000) {
+        return 0;
+    }
+
+    uint32_t mid = utf8str_class_top[cp >> (UTF8STR_CLASS_MID_BITS + UTF8STR_CLASS_LEAF_BITS)];
+    uint32_t leaf = utf8str_class_mid[(mid << UTF8STR_CLASS_MID_BITS) |
+        ((cp >> UTF8STR_CLASS_LEAF_BITS) & ((1 << UTF8STR_CLASS_MID_BITS) - 1))];
+    return utf8str_class_leaf[(leaf << UTF8STR_CLASS_LEAF_BITS) |
+        (cp & ((1 << UTF8STR_CLASS_LEAF_BITS) - 1))];
+}
+
+/** Retuns non-zero value if the code point belongs to any of the classes */
+static inline int utf8str_isclass_cp(int32_t cp, unsigned int classes) {
+    return (utf8str_class_cp(cp) & classes) != 0;
+}
+
+/** Retuns non-zero value if the code point is digit. See utf8str_isdigit */
+static inline int utf8str_isdigit_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_DIGIT) != 0;
+}
+
+/** Retuns non-zero value if the code point is whitespace. See utf8str_isspace */
+static inline int utf8str_isspace_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_SPACE) != 0;
+}
+
+/** Retuns non-zero value if the code point is punctuation. See utf8str_ispunct */
+static inline int utf8str_ispunct_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_PUNCT) != 0;
+}
+
+/** Retuns non-zero value if the code point is lowcase letter. See utf8str_islower */
+static inline int utf8str_islower_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_LOWER) != 0;
+}
+
+/** Retuns non-zero value if the code point is uppercase letter. See utf8str_isupper */
+static inline int utf8str_isupper_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_UPPER) != 0;
+}
+
+/** Retuns non-zero value if the code point is control character. See utf8str_iscntrl */
+static inline int utf8str_iscntrl_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_CNTRL) != 0;
+}
+
+/** Retuns non-zero value if the code point is a letter. See utf8str_isalpha */
+static inline int utf8str_isalpha_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_ALPHA) != 0;
+}
+
+/** Retuns non-zero value if the code point is printable. See utf8str_isprint */
+static inline int utf8str_isprint_cp(int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_PRINT) != 0;
+}
+
+/** Returns the length in bytes of the longest prefix of str that consists of
+ *    characters from any of the classes. The span stops at the first
+ *    character out of the classes, at the end of the string, or at an
+ *    invalid UTF8 sequence
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[in] classes - a combination of utf8_char_class flags
+ * \param[out] char_count - receives the number of characters in the span if
+ *    it is not NULL
+ * Examples:
+ *    utf8str_span_class("id42 = 1", 0, UTF8_CLASS_WORD, &n) - 4, n = 4
+ *    utf8str_span_class("мир!", 0, UTF8_CLASS_ALPHA, &n) - 6, n = 3
+ */
+size_t utf8str_span_class(const char *str, size_t len, unsigned int classes, size_t *char_count);
+
+/** Returns the length in bytes of the longest prefix of str that consists of
+ *    characters out of all the classes. The span stops at the first
+ *    character from any of the classes, at the end of the string, or at an
+ *    invalid UTF8 sequence
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[in] classes - a combination of utf8_char_class flags
+ * \param[out] char_count - receives the number of characters in the span if
+ *    it is not NULL
+ * Examples:
+ *    utf8str_cspan_class("мир 2", 0, UTF8_CLASS_SPACE, &n) - 6, n = 3
+ */
+size_t utf8str_cspan_class(const char *str, size_t len, unsigned int classes, size_t *char_count);
+
+#if UTF8STR_WITH_SCRIPT
+/** Returns the length in bytes of the longest prefix of str whose characters
+ *    are of one script(Unicode Script property, see utf8proc_script), so
+ *    calling it in a loop splits text into script runs. Common
+ *    characters(spaces, digits, most punctuation) and Inherited
+ *    ones(combining marks) join the run they are in, a character with
+ *    Script_Extensions joins a run of any of its scripts. The run stops at
+ *    the end of the string or at an invalid UTF8 sequence
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[out] script - receives the script of the run(a utf8proc_script_t
+ *    value) if it is not NULL: UTF8PROC_SCRIPT_COMMON if the run has only
+ *    Common and Inherited characters
+ * \param[out] char_count - receives the number of characters in the run if
+ *    it is not NULL
+ * Examples:
+ *    utf8str_script_run_next("Hi, мир", 0, &s, &n) - 4, s = LATIN, n = 4
+ *    utf8str_script_run_next("мир", 0, &s, &n) - 6, s = CYRILLIC, n = 3
+ */
+size_t utf8str_script_run_next(const char *str, size_t len, int *script, size_t *char_count);
+#endif
+
+/** Finds the next emoji sequence in str: a flag, a keycap, a tag or ZWJ
+ *    sequence, or an emoji that is shown as emoji(Emoji_Presentation, a
+ *    variation selector U+FE0F or a skin tone modifier). Text-style
+ *    characters like "\u00A9" alone are not emoji. The bytes between emoji
+ *    are skipped by their UTF8 prefixes without decoding and validation
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[in,out] emoji - zero-initialize it before the first search. If an
+ *    emoji is found its position is written to the structure and the next
+ *    call with the same structure continues the search after it
+ * Returns:
+ *    UTF8_OK - an emoji is found
+ *    UTF8_NOT_FOUND - there are no more emoji, emoji is not changed
+ *    UTF8_INVALID_ARG - str or emoji is NULL
+ *    UTF8_INVALID_UTF - a character that may start an emoji is an invalid
+ *      UTF8 sequence
+ * Examples:
+ *    utf8str_emoji_next("Hi \U0001F44B\U0001F3FD!", 0, e) - OK,
+ *        byte_offset = 3, byte_length = 8, char_length = 2, kind = MODIFIER
+ *    utf8str_emoji_next("1\uFE0F\u20E3", 0, e) - OK, kind = KEYCAP
+ */
+enum utf8_result utf8str_emoji_next(const char *str, size_t len, struct utf8str_emoji_t *emoji);
+
+#if UTF8STR_WITH_WIDTH
 /** Returns the total width in monospace characters of the first len UTF8
- *   characters of the string
+ *   characters of the string. Every character is measured alone, see
+ *   utf8str_width_ex for grapheme clusters and emoji sequences
  */
 size_t utf8str_width(const char *str, size_t len);
 
+/** utf8str_width with utf8str_quick_check flags of str: the width of a
+ *   string with UTF8_QUICK_NARROW is its length in characters
+ * \param[in] quick - flags of str, 0 to compute them
+ */
+size_t utf8str_width_quick(const char *str, size_t len, unsigned int quick);
+
+#if UTF8STR_WITH_GRAPHEME
+/** Returns the width of the string in monospace columns measured by grapheme
+ *   clusters, as terminals that draw a cluster as one glyph show it. A
+ *   cluster takes the width of its widest character: marks, joiners and
+ *   variation selectors add nothing, and an emoji sequence takes two columns
+ *   (see utf8_width_flags). Runs of printable ASCII are counted a block of
+ *   bytes at a time
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[in] flags - utf8_width_flags
+ * \param[in,out] cache - widths of clusters measured before, it can be NULL.
+ *   Pass the same cache for all cells of a table or screen
+ * Returns 0 if str is NULL, (size_t)-1 if str is not a valid UTF8 sequence
+ * Examples:
+ *    utf8str_width_ex("e\u0301", 0, 0, NULL) - 1
+ *    utf8str_width_ex("\U0001F469\u200D\U0001F4BB", 0, 0, NULL) - 2
+ *    utf8str_width_ex("\u263A\uFE0F", 0, 0, NULL) - 2
+ *    utf8str_width_ex("\u263A\uFE0F", 0, UTF8_WIDTH_EMOJI_TEXT, NULL) - 1
+ *    utf8str_width_ex("\u00B1", 0, UTF8_WIDTH_AMBIGUOUS_WIDE, NULL) - 2
+ */
+size_t utf8str_width_ex(const char *str, size_t len, unsigned int flags,
+        struct utf8str_width_cache_t *cache);
+
+/** Finds where to cut the string to fit it into max_cols columns with the
+ *   ellipsis in place of the left out text, in one pass that stops as soon as
+ *   the cut is known. The cuts are at grapheme cluster boundaries and widths
+ *   are measured as by utf8str_width_ex, so callers can pad the result to
+ *   max_cols with the width in cut
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[in] ellipsis - NUL-terminated text inserted at the cut, e.g.
+ *   "\u2026" or "...". NULL is the empty string. An ellipsis wider than
+ *   max_cols is left out
+ * \param[in] mode - which part of the string is left out
+ * \param[in] flags - utf8_width_flags
+ * \param[out] cut - the cut points and the width
+ * Returns UTF8_OK, UTF8_INVALID_ARG if str or cut is NULL, UTF8_INVALID_UTF if
+ *   the string or the ellipsis is not a valid UTF8 sequence
+ * Examples:
+ *    utf8str_truncate_width("Hello world", 0, 8, "\u2026", UTF8_ELIDE_END, 0, cut) -
+ *        head_end = 7, tail_start = 11, width = 8, ellipsis = 1
+ *    utf8str_truncate_width("Hello world", 0, 8, "\u2026", UTF8_ELIDE_MIDDLE, 0, cut) -
+ *        head_end = 4, tail_start = 8, width = 8, ellipsis = 1
+ *    utf8str_truncate_width("\u65E5\u672C\u8A9E", 0, 4, "\u2026", UTF8_ELIDE_START, 0, cut) -
+ *        head_end = 0, tail_start = 6, width = 3, ellipsis = 1
+ *    utf8str_truncate_width("Hello", 0, 8, "\u2026", UTF8_ELIDE_END, 0, cut) -
+ *        head_end = 5, tail_start = 5, width = 5, ellipsis = 0
+ */
+enum utf8_result utf8str_truncate_width(const char *str, size_t len, size_t max_cols,
+        const char *ellipsis, enum utf8_elide_mode mode, unsigned int flags,
+        struct utf8str_truncate_t *cut);
+
+/** Pads a string with a fill to cols display columns, e.g. to align a table
+ *   cell. The fill is repeated from its start on each side, the clusters of
+ *   its last copy that do not fit are left out and spaces take their
+ *   columns. Columns are counted as by utf8str_width_ex. A fill must not
+ *   join the clusters beside it, so it cannot start with a mark or a joiner
+ *   or end with a joiner or a prepended character. The text is measured on
+ *   its own: a text that ends with a joiner before an emoji fill comes out
+ *   narrower. Nothing is allocated and every byte of the result is written
+ *   once
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[in] fill - the fill, NULL or empty for a space
+ * \param[in] flags - utf8_width_flags
+ * \param[out] dest - the padded string, it can be str if the buffer of str
+ *   is large enough. NULL to get the size only
+ * \param[in,out] dest_sz - if dest_sz is NULL or equal 0 then the function
+ *    does not check the size of the destination buffer. In case of success
+ *    dest_sz is the size of the result in bytes(without trailing zero)
+ * Returns one of:
+ *   UTF8_OK - the string is padded
+ *   UTF8_TOO_LONG - str is already wider than cols, dest gets it as is(not an
+ *     error, just an informative warning)
+ *   UTF8_INVALID_ARG - str is NULL, fill takes no columns or joins the
+ *     clusters beside it
+ *   UTF8_INVALID_UTF - str or fill is not a valid UTF8 sequence
+ *   UTF8_BUFFER_SMALL - the destination buffer is too small
+ * Examples:
+ *    utf8str_pad("Total", 0, 8, NULL, UTF8_PAD_START, 0, d, NULL) - "   Total"
+ *    utf8str_pad("\u65E5\u672C", 0, 9, ".-", UTF8_PAD_END, 0, d, NULL) - "\u65E5\u672C.-.-."
+ *    utf8str_pad("ab", 0, 7, "\u2500\u2550", UTF8_PAD_BOTH, 0, d, NULL) -
+ *        "\u2500\u2550ab\u2500\u2550\u2500"
+ *    utf8str_pad("ab", 0, 5, "\u65E5", UTF8_PAD_END, 0, d, NULL) - "ab\u65E5 "
+ */
+enum utf8_result utf8str_pad(const char *str, size_t len, size_t cols, const char *fill,
+        enum utf8_pad_mode mode, unsigned int flags, char *dest, size_t *dest_sz);
+/** Makes a fill for utf8str_pad_iov. Release it with utf8str_fill_free
+ * \param[in] pattern - the fill, NULL or empty for a space
+ * \param[in] cols - the widest padding that takes one piece of the fill, a
+ *   wider one takes a piece per cols columns
+ * \param[in] flags - utf8_width_flags
+ * \param[in] alloc - allocator of the fill, NULL for realloc and free
+ * Returns one of:
+ *   UTF8_OK - the fill is ready
+ *   UTF8_INVALID_ARG - fill is NULL, the pattern takes no columns or joins
+ *     the clusters beside it as utf8str_pad does not allow
+ *   UTF8_INVALID_UTF - the pattern is not a valid UTF8 sequence
+ *   UTF8_OUT_OF_MEMORY - the fill could not be allocated
+ */
+enum utf8_result utf8str_fill_init(struct utf8str_fill_t *fill, const char *pattern, size_t cols,
+        unsigned int flags, const struct utf8str_alloc_t *alloc);
+/** Pads a string as utf8str_pad does, but without building the result: iov
+ *   gets the pieces to write with writev, the padding before the text, the
+ *   text and the padding after it. Padding refers to the fill, and to static
+ *   spaces where the last copy of the pattern does not fit. Empty pieces are
+ *   left out. Nothing is copied or allocated
+ * \param[in] len - length of str in bytes or 0 if str is NUL-terminated
+ * \param[in] fill - a fill made by utf8str_fill_init, its flags measure str
+ * \param[out] iov - the pieces, NULL to get their number only. They refer to
+ *   str and the fill, which must outlive them
+ * \param[in,out] iov_count - the number of pieces iov can take, 5 is enough
+ *   for padding up to the columns of the fill. On return the number of
+ *   pieces, also if iov is too short
+ * Returns one of:
+ *   UTF8_OK - the string is padded
+ *   UTF8_TOO_LONG - str is already wider than cols, iov gets it as is(not an
+ *     error, just an informative warning)
+ *   UTF8_INVALID_ARG - str, fill or iov_count is NULL
+ *   UTF8_INVALID_UTF - str is not a valid UTF8 sequence
+ *   UTF8_BUFFER_SMALL - iov is too short
+ * Examples(fill ".-"):
+ *    utf8str_pad_iov("\u65E5\u672C", 0, 9, fill, UTF8_PAD_END, iov, n) -
+ *        "\u65E5\u672C", ".-.-.", n = 2
+ *    utf8str_pad_iov("ab", 0, 7, fill, UTF8_PAD_BOTH, iov, n) - ".-", "ab", ".-.", n = 3
+ */
+enum utf8_result utf8str_pad_iov(const char *str, size_t len, size_t cols, const struct utf8str_fill_t *fill,
+        enum utf8_pad_mode mode, utf8str_iovec_t *iov, size_t *iov_count);
+/** Frees the fill. It is safe to free a fill that is NULL
+ * Returns UTF8_OK
+ */
+enum utf8_result utf8str_fill_free(struct utf8str_fill_t *fill);
+
+/** Initializes an empty column index. Index a line with
+ *   utf8str_colindex_append, release it with utf8str_colindex_free
+ * \param[in] step - columns between checkpoints. Lookups measure up to about
+ *   step columns, the index takes 3 * sizeof(size_t) bytes per step columns
+ * \param[in] tab_size - distance between tab stops, 0 if tabs take no columns
+ * \param[in] flags - utf8_width_flags
+ * \param[in] alloc - allocator of the checkpoints, NULL for realloc and free
+ * Returns UTF8_OK or UTF8_INVALID_ARG if index is NULL or step is 0
+ */
+enum utf8_result utf8str_colindex_init(struct utf8str_colindex_t *index, size_t step,
+        size_t tab_size, unsigned int flags, const struct utf8str_alloc_t *alloc);
+/** Indexes the text appended to the line since the last call. The line may
+ *   have moved in memory, only its indexed part must stay the same. The last
+ *   grapheme cluster of the indexed text is measured again, so text can be
+ *   appended in any pieces, even inside a character
+ * \param[in] str - the whole line
+ * \param[in] len - length of the line in bytes or 0 if it is NUL-terminated
+ * Returns one of:
+ *   UTF8_OK - the line is indexed up to len
+ *   UTF8_INVALID_ARG - index or str is NULL, or len is less than the indexed
+ *     length
+ *   UTF8_INVALID_UTF - the line is indexed up to the grapheme cluster with an
+ *     invalid UTF8 sequence, e.g. a character that is not complete yet
+ *   UTF8_OUT_OF_MEMORY - the line is indexed up to the grapheme cluster that
+ *     needed a new checkpoint
+ */
+enum utf8_result utf8str_colindex_append(struct utf8str_colindex_t *index, const char *str, size_t len);
+/** Finds the grapheme cluster that covers the display column, e.g. the first
+ *   one to draw when the line is scrolled to it. A wide character that starts
+ *   before the column is returned with its own column
+ * \param[in] str - the indexed line
+ * \param[out] pos - the start of the cluster, or index->end if the column is
+ *   past the end of the line
+ * Returns UTF8_OK or UTF8_INVALID_ARG if an argument is NULL
+ * Examples(step 8, no tabs):
+ *    "ab\u65E5\u672Ccd", column 3 - byte_offset = 2, char_offset = 2, column = 2
+ *    "ab\u65E5\u672Ccd", column 6 - byte_offset = 8, char_offset = 4, column = 6
+ */
+enum utf8_result utf8str_colindex_column_to_byte(const struct utf8str_colindex_t *index,
+        const char *str, size_t column, struct utf8str_colpos_t *pos);
+/** Finds the grapheme cluster with the byte at byte_offset
+ * \param[in] str - the indexed line
+ * \param[out] pos - the start of the cluster, or index->end if byte_offset is
+ *   past the indexed text
+ * Returns UTF8_OK or UTF8_INVALID_ARG if an argument is NULL
+ * Examples(step 8, tab size 4):
+ *    "a\tb", byte 2 - byte_offset = 2, char_offset = 2, column = 4
+ *    "e\u0301x", byte 2 - byte_offset = 0, char_offset = 0, column = 0
+ */
+enum utf8_result utf8str_colindex_byte_to_column(const struct utf8str_colindex_t *index,
+        const char *str, size_t byte_offset, struct utf8str_colpos_t *pos);
+/** Frees the checkpoints of the index, which is empty after it. It is safe to
+ *   free an index that is NULL
+ * Returns UTF8_OK
+ */
+enum utf8_result utf8str_colindex_free(struct utf8str_colindex_t *index);
+#if UTF8STR_WITH_LINEBREAK
+/** Wraps text into lines of at most max_cols columns and passes them to emit
+ *   in order. The lines are not copied: each is a part of str. Lines break
+ *   where the line breaking rules of UAX #14 allow it: after spaces and
+ *   hyphens, between ideographs and so on, never before closing punctuation
+ *   or inside a number like "-1.5". A line break(LF, CR LF, VT, FF, NEL, LS
+ *   or PS) always ends a line. A word wider than max_cols is broken between
+ *   grapheme clusters. Columns are counted as by utf8str_width_ex, spaces at
+ *   the end of a line are not counted
+ * \param[in] len - number of bytes to wrap, 0 for the whole string
+ * \param[in] flags - utf8_width_flags
+ * \param[in] emit - called with ctx for every line, a non-zero result stops
+ *   the wrapping
+ * Returns one of:
+ *   UTF8_OK - all lines were passed or emit stopped the wrapping
+ *   UTF8_INVALID_ARG - str or emit is NULL or max_cols is 0
+ *   UTF8_INVALID_UTF - str is not a valid UTF8 sequence, the lines before
+ *     the invalid one were passed
+ * Examples(10 columns):
+ *    "The quick brown fox" - "The quick", "brown fox"
+ *    "\u65E5\u672C\u8A9E\u306E\u30C6\u30AD\u30B9\u30C8" -
+ *        "\u65E5\u672C\u8A9E\u306E\u30C6", "\u30AD\u30B9\u30C8"
+ *    "costs $1,000.00 (net)" - "costs", "$1,000.00", "(net)"
+ */
+enum utf8_result utf8str_wrap(const char *str, size_t len, size_t max_cols, unsigned int flags,
+        int (*emit)(void *ctx, const struct utf8str_line_t *line), void *ctx);
+/** Initializes a paragraph formatter. Format paragraphs with
+ *   utf8str_paragraph_justify, release the formatter with
+ *   utf8str_paragraph_free
+ * \param[in] max_cols - width of the justified lines in columns
+ * \param[in] flags - utf8_width_flags
+ * \param[in] alloc - allocator of the working memory, NULL for realloc and
+ *   free
+ * Returns UTF8_OK or UTF8_INVALID_ARG if par is NULL or max_cols is 0
+ */
+enum utf8_result utf8str_paragraph_init(struct utf8str_paragraph_t *par, size_t max_cols,
+        unsigned int flags, const struct utf8str_alloc_t *alloc);
+/** Breaks a paragraph into lines of par->max_cols columns and justifies them.
+ *   Unlike utf8str_wrap, which fills every line as far as it can, the lines
+ *   are chosen together to make the spaces added between words as even as
+ *   possible over the whole paragraph(the total fit method of Knuth and
+ *   Plass). Lines break where utf8str_wrap can break them, the spaces
+ *   between words of every line but the last get extra spaces up to
+ *   max_cols. The last line, lines before a line break and lines without
+ *   spaces are not stretched. The lines are written to dest separated by
+ *   '\n'
+ * \param[in] len - number of bytes to format, 0 for the whole string
+ * \param[out] dest - the justified text, NULL to get its size only
+ * \param[in,out] dest_sz - if dest_sz is NULL or equal 0 then the function
+ *    does not check the size of the destination buffer. In case of success
+ *    dest_sz is the size of the result in bytes(without trailing zero)
+ * Returns one of:
+ *   UTF8_OK - the paragraph is justified
+ *   UTF8_INVALID_ARG - par or str is NULL
+ *   UTF8_INVALID_UTF - str is not a valid UTF8 sequence
+ *   UTF8_BUFFER_SMALL - the destination buffer is too small
+ *   UTF8_OUT_OF_MEMORY - the working memory could not grow
+ * Examples:
+ *    "The quick brown fox jumps", 16 columns - "The quick  brown\nfox jumps"
+ *    "dddd a hhh a bb dddd eeeee", 12 columns - "dddd  a  hhh\na  bb   dddd\neeeee",
+ *        where filling the lines first would leave "bb      dddd"
+ */
+enum utf8_result utf8str_paragraph_justify(struct utf8str_paragraph_t *par, const char *str,
+        size_t len, char *dest, size_t *dest_sz);
+/** Frees the working memory of the formatter. It is safe to free a formatter
+ *   that is NULL
+ * Returns UTF8_OK
+ */
+enum utf8_result utf8str_paragraph_free(struct utf8str_paragraph_t *par);
+#endif
+#endif
+#endif
+
 /** Copies len UTF8 characters from str to dest starting from UTF8 character start.
  *    \param[in] start - UTF8 index of the first character to copy. If start is
  *        greater than string length then UTF8_INVALID_ARG is returned
@@ -311,13 +1286,56 @@ const char* utf8str_char_back_safe(const char *str, const char *stopper);
  */
 enum utf8_result utf8str_reverse(char *str);
 
-/** Make the first characher of every word in the string to uppercase
+#if UTF8STR_WITH_CASE
+/** Make the first characher of every word in the string to titlecase
+ *   (for most letters it is the same as uppercase, but digraphs like "ǆ" become "ǅ")
  * Retuns:
  *    UTF8_OK - if the operation completed successfully
  *    UTF8_INVALID_UTF - if the str is not a valid UTF8 sequence
  */
 enum utf8_result utf8str_titlecase(char *str);
 
+/** Make the first characher of every word in the string to titlecase. Unlike
+ *   utf8str_titlecase it allows the string to grow up to the buffer size, and
+ *   it is atomic: in case of any error the string is left untouched
+ * \param[in] buf_sz - size of the buffer that holds the string in bytes. It
+ *    must be greater than the string length
+ * Retuns:
+ *    UTF8_OK - if the operation completed successfully
+ *    UTF8_INVALID_ARG - str is NULL or buf_sz is not greater than the string length
+ *    UTF8_INVALID_UTF - if the str is not a valid UTF8 sequence
+ *    UTF8_BUFFER_SMALL - the converted string does not fit the buffer
+ */
+enum utf8_result utf8str_titlecase_sz(char *str, size_t buf_sz);
+
+/** Converts a string to title case: the first cased letter of every word is
+ *   converted to titlecase and all other letters of the word to lowercase.
+ *   Unlike utf8str_titlecase the result is written to a separate buffer, so
+ *   characters that change their length are not a problem
+ * \param[in] breaks - a combination of utf8_title_break flags that selects
+ *    which characters separate words
+ * \param[in] extra - a set of characters that separate words in addition to
+ *    breaks. Can be NULL
+ * \param[in,out] dest_sz - if dest_sz is NULL or equal 0 then the function
+ *    does not check the size of the destination buffer. In case of success
+ *    dest_sz is the size of the result in bytes(without trailing zero)
+ * Retuns:
+ *    UTF8_OK - if the operation completed successfully
+ *    UTF8_INVALID_ARG - src is NULL
+ *    UTF8_INVALID_UTF - if the src is not a valid UTF8 sequence
+ *    UTF8_BUFFER_SMALL - the destination buffer is too small
+ * Examples:
+ *    utf8str_titlecase_copy("hELLO wORLD", d, NULL, UTF8_TITLE_SPACE, NULL) - "Hello World"
+ *    utf8str_titlecase_copy("ǆungla", d, NULL, UTF8_TITLE_SPACE, NULL) - "ǅungla"
+ *    utf8str_titlecase_copy("it's jean-luc.picard", d, NULL, UTF8_TITLE_SPACE | UTF8_TITLE_PUNCT, NULL)
+ *       - "It's Jean-luc.Picard"
+ *    utf8str_titlecase_copy("it's jean-luc.picard", d, NULL, UTF8_TITLE_ALL, NULL)
+ *       - "It's Jean-Luc.Picard"
+ */
+enum utf8_result utf8str_titlecase_copy(const char *src, char *dest, size_t *dest_sz,
+        unsigned int breaks, const char *extra);
+#endif
+
 
 /** Make the string a valid UTF8 sequence. If any character is not valid it is
  *   replaced with 'replace'.
@@ -394,6 +1412,23 @@ enum utf8_result utf8str_translate(const char *src, char *dst, size_t *dst_sz, c
  *        result string
  */
 enum utf8_result utf8str_expand_tabs(const char *str, char *dst, size_t *dst_sz, size_t tab_sz);
+/** utf8str_expand_tabs with tab stops: with UTF8_TAB_STOPS a TAB is replaced
+ *  with the spaces up to the next column that is a multiple of tab_sz, as
+ *  expand(1) does. Columns are display widths(see utf8str_width_ex and
+ *  utf8_width_flags, without the width feature every character that is not
+ *  a control one takes a column) and start from 0 after LF, VT, FF, CR,
+ *  U+0085, U+2028 and U+2029. The text between TABs is copied as is, so the size pass
+ *  (dst is NULL) does the same work as the expansion without writing
+ *  \param[in] flags - UTF8_TAB_STOPS combined with utf8_width_flags, 0 to
+ *      expand every TAB to tab_sz spaces
+ *  Returns the same results as utf8str_expand_tabs
+ *  Examples:
+ *     utf8str_expand_tabs_ex("ab\tc", dst, &sz, 4, UTF8_TAB_STOPS) - "ab  c"
+ *     utf8str_expand_tabs_ex("\u65E5\tc\n\td", dst, &sz, 4, UTF8_TAB_STOPS) -
+ *        "\u65E5  c\n    d"
+ */
+enum utf8_result utf8str_expand_tabs_ex(const char *str, char *dst, size_t *dst_sz, size_t tab_sz,
+        unsigned int flags);
 
 /** Deletes adjacent repeated characters. If what is empty or NULL then it deletes
  *      all repeated characters, otherwise it deletes only repeated characters
@@ -438,6 +1473,8 @@ enum utf8_result utf8str_lstrip(char *str, const char *what);
  *     UTF8_TOO_LONG - a string is already longer than sz (not an error, just
  *      an informative warning)
  *     UTF8_INVALID_UTF - src is not a vaild UTF8 sequence
+ *  The length is counted in characters and str must have room for the
+ *  result. utf8str_pad pads to display columns into a buffer of known size
  *  Examples:
  *      utf8str_rjustify("example", NULL, 9) == "example  "
  *      utf8str_rjustify("example", " *>", 12) == "example *> *"
@@ -455,8 +1492,6 @@ enum utf8_result utf8str_rjustify(char *str, const char *with, size_t sz);
  *     UTF8_TOO_LONG - a string is already longer than sz (not an error, just
  *      an informative warning)
  *     UTF8_INVALID_UTF - src is not a vaild UTF8 sequence
- *     UTF8_OUT_OF_MEMORY - the function allocates memory for internal structures,
- *        so it may fail and return this error
  *  Examples:
  *      utf8str_ljustify("example", NULL, 9) == "  example"
  *      utf8str_ljustify("example", " *>", 12) == " *> *example"
@@ -476,8 +1511,6 @@ enum utf8_result utf8str_ljustify(char *str, const char *with, size_t sz);
  *     UTF8_TOO_LONG - a string is already longer than sz (not an error, just
  *      an informative warning)
  *     UTF8_INVALID_UTF - src is not a vaild UTF8 sequence
- *     UTF8_OUT_OF_MEMORY - the function allocates memory for internal structures,
- *        so it may fail and return this error
  *  Examples:
  *      utf8str_justify("example", NULL, 10) == "  example "
  *      utf8str_justify("example", " *>", 12) == " *example *>"
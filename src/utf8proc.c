@@ -42,8 +42,163 @@
 
 
 #include "utf8proc.h"
+
+#if UTF8STR_EXTERNAL_DATA
+#  include <string.h>
+#  ifdef _WIN32
+#    include <stdio.h>
+#  else
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#  endif
+#endif
+
+/* The properties that classification, width, grapheme break and case
+   mapping queries read. utf8proc_hot_properties is indexed in the same way as
+   utf8proc_properties, but its entries take 4 bytes instead of 24, so such
+   queries on multilingual text touch far fewer cache lines. The rest of
+   utf8proc_property_t is read only by normalization and case mapping */
+typedef struct utf8proc_hot_property_struct {
+  unsigned category:5;
+  unsigned charwidth:2;
+  /* uppercase, lowercase, titlecase mapping or case folding exists */
+  unsigned casemap:1;
+  unsigned combining_class:8;
+  unsigned boundclass:8;
+  /* utf8proc_emoji_t flags */
+  unsigned emoji:5;
+  /* NFC_Quick_Check is No or Maybe */
+  unsigned nfc_check:1;
+  /* East_Asian_Width is Ambiguous */
+  unsigned ambiguous:1;
+} utf8proc_hot_property_t;
+
+/* the tables of utf8proc_data.c that the built features read(see
+   UTF8STR_WITH_* in utf8proc.h), the others are left out */
+#define UTF8PROC_WITH_PROPERTIES (UTF8STR_WITH_CASE || UTF8STR_WITH_NORMALIZATION)
+#define UTF8PROC_WITH_SEQUENCES (UTF8STR_WITH_CASE || UTF8STR_WITH_NORMALIZATION)
+#define UTF8PROC_WITH_COMBINATIONS UTF8STR_WITH_NORMALIZATION
+#define UTF8PROC_WITH_SCRIPTS UTF8STR_WITH_SCRIPT
+#define UTF8PROC_WITH_LINEBREAKS UTF8STR_WITH_LINEBREAK
+/* with external data utf8proc_data.c only gives the table layout */
+#define UTF8PROC_WITH_TABLES (!UTF8STR_EXTERNAL_DATA)
+
 #include "utf8proc_data.c"
 
+#if UTF8STR_EXTERNAL_DATA || defined(UTF8PROC_DATA_WRITER)
+/* Header of the data file read by utf8proc_load_data and written by
+   tools/utf8datafile.c. The tables follow it in the order of the table ids,
+   each at an offset aligned to 8 bytes from the start of the file. The file
+   is in the byte order and structure layout of the compiler, which the
+   header records so that a mismatching file is rejected instead of misread */
+#define UTF8PROC_DATA_MAGIC "utf8proc data"
+#define UTF8PROC_DATA_FORMAT 6
+#define UTF8PROC_DATA_BYTE_ORDER 0x01020304
+#define UTF8PROC_DATA_ALIGN 8
+
+enum {
+  UTF8PROC_DATA_SEQUENCES,
+  UTF8PROC_DATA_STAGE1,
+  UTF8PROC_DATA_STAGE2,
+  UTF8PROC_DATA_STAGE3,
+  UTF8PROC_DATA_PROPERTIES,
+  UTF8PROC_DATA_HOT_PROPERTIES,
+  UTF8PROC_DATA_COMBINATIONS,
+  UTF8PROC_DATA_SCRIPT_STAGE1,
+  UTF8PROC_DATA_SCRIPT_STAGE2,
+  UTF8PROC_DATA_SCRIPT_SETS,
+  UTF8PROC_DATA_SCRIPT_SET_INDEX,
+  UTF8PROC_DATA_LINEBREAK_STAGE1,
+  UTF8PROC_DATA_LINEBREAK_STAGE2,
+  UTF8PROC_DATA_TABLES
+};
+
+typedef struct utf8proc_data_header_struct {
+  char magic[16];
+  utf8proc_uint32_t format;
+  utf8proc_uint32_t byte_order;
+  char unicode_version[16];
+  utf8proc_uint32_t stages;
+  utf8proc_uint32_t stage2_bits;
+  /* 0 for 2 stages */
+  utf8proc_uint32_t stage3_bits;
+  utf8proc_uint32_t script_bits;
+  utf8proc_uint32_t script_extension_base;
+  utf8proc_uint32_t linebreak_bits;
+  /* size of the file, the tables end at its end */
+  utf8proc_uint32_t size;
+  /* FNV-1a hash of the bytes after the header */
+  utf8proc_uint32_t checksum;
+  struct {
+    utf8proc_uint32_t offset;
+    utf8proc_uint32_t count;
+    utf8proc_uint32_t item_size;
+  } tables[UTF8PROC_DATA_TABLES];
+} utf8proc_data_header_t;
+
+static utf8proc_uint32_t data_checksum(const utf8proc_uint8_t *data, size_t size) {
+  utf8proc_uint32_t hash = 2166136261U;
+  size_t i;
+  for (i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * 16777619U;
+  }
+  return hash;
+}
+#endif
+
+#if UTF8STR_EXTERNAL_DATA
+/* Until utf8proc_load_data succeeds every code point maps to the properties
+   of unassigned code points. The empty stage tables are writable so that they
+   take no space in the binary */
+#if UTF8PROC_TABLE_STAGES == 3
+static utf8proc_uint16_t data_empty_stage1[0x110000 >> (UTF8PROC_STAGE2_BITS + UTF8PROC_STAGE3_BITS)];
+static utf8proc_uint16_t data_empty_stage3[1 << UTF8PROC_STAGE3_BITS];
+#else
+static utf8proc_uint16_t data_empty_stage1[0x110000 >> UTF8PROC_STAGE2_BITS];
+#endif
+static utf8proc_uint16_t data_empty_stage2[1 << UTF8PROC_STAGE2_BITS];
+static const utf8proc_hot_property_t data_empty_hot_properties[1] = {
+  {UTF8PROC_CATEGORY_CN, 0, false, 0, UTF8PROC_BOUNDCLASS_OTHER, 0, false, false}
+};
+
+#if UTF8PROC_WITH_SEQUENCES
+static const utf8proc_uint16_t *utf8proc_sequences = NULL;
+#endif
+static const utf8proc_uint16_t *utf8proc_stage1table = data_empty_stage1;
+static const utf8proc_uint16_t *utf8proc_stage2table = data_empty_stage2;
+#if UTF8PROC_TABLE_STAGES == 3
+static const utf8proc_uint16_t *utf8proc_stage3table = data_empty_stage3;
+#endif
+#if UTF8PROC_WITH_PROPERTIES
+static const utf8proc_property_t data_empty_properties[1] = {
+  {0, 0, 0, 0, UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX,
+   false, false, false, false, 0, 0, UTF8PROC_BOUNDCLASS_OTHER}
+};
+static const utf8proc_property_t *utf8proc_properties = data_empty_properties;
+#endif
+static const utf8proc_hot_property_t *utf8proc_hot_properties = data_empty_hot_properties;
+#if UTF8PROC_WITH_COMBINATIONS
+static const utf8proc_uint16_t *utf8proc_combinations = NULL;
+#endif
+#if UTF8PROC_WITH_SCRIPTS
+static utf8proc_uint16_t data_empty_script_stage1[0x110000 >> UTF8PROC_SCRIPT_BITS];
+static utf8proc_uint8_t data_empty_script_stage2[1 << UTF8PROC_SCRIPT_BITS];
+static const utf8proc_uint16_t *utf8proc_script_stage1 = data_empty_script_stage1;
+static const utf8proc_uint8_t *utf8proc_script_stage2 = data_empty_script_stage2;
+static const utf8proc_uint8_t *utf8proc_script_sets = NULL;
+static const utf8proc_uint16_t *utf8proc_script_set_index = NULL;
+#endif
+#if UTF8PROC_WITH_LINEBREAKS
+static utf8proc_uint16_t data_empty_linebreak_stage1[0x110000 >> UTF8PROC_LINEBREAK_BITS];
+static utf8proc_uint8_t data_empty_linebreak_stage2[1 << UTF8PROC_LINEBREAK_BITS];
+static const utf8proc_uint16_t *utf8proc_linebreak_stage1 = data_empty_linebreak_stage1;
+static const utf8proc_uint8_t *utf8proc_linebreak_stage2 = data_empty_linebreak_stage2;
+#endif
+static char data_unicode_version[16] = "";
+#endif
+
 
 UTF8PROC_DLLEXPORT const utf8proc_int8_t utf8proc_utf8class[256] = {
   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -92,6 +247,14 @@ UTF8PROC_DLLEXPORT const char *utf8proc_version(void) {
   return STRINGIZE(UTF8PROC_VERSION_MAJOR) "." STRINGIZE(UTF8PROC_VERSION_MINOR) "." STRINGIZE(UTF8PROC_VERSION_PATCH) "";
 }
 
+UTF8PROC_DLLEXPORT const char *utf8proc_unicode_version(void) {
+#if UTF8STR_EXTERNAL_DATA
+  return data_unicode_version;
+#else
+  return UTF8PROC_UNICODE_VERSION;
+#endif
+}
+
 UTF8PROC_DLLEXPORT const char *utf8proc_errmsg(utf8proc_ssize_t errcode) {
   switch (errcode) {
     case UTF8PROC_ERROR_NOMEM:
@@ -104,6 +267,8 @@ UTF8PROC_DLLEXPORT const char *utf8proc_errmsg(utf8proc_ssize_t errcode) {
     return "Unassigned Unicode code point found in UTF-8 string.";
     case UTF8PROC_ERROR_INVALIDOPTS:
     return "Invalid options for UTF-8 processing chosen.";
+    case UTF8PROC_ERROR_INVALIDDATA:
+    return "Unicode data file could not be read or does not match the library.";
     default:
     return "An unknown error occurred while processing UTF-8 data.";
   }
@@ -188,6 +353,7 @@ UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_encode_char(utf8proc_int32_t uc, ut
   } else return 0;
 }
 
+#if UTF8STR_WITH_NORMALIZATION
 /* internal "unsafe" version that does not check whether uc is in range */
 static utf8proc_ssize_t unsafe_encode_char(utf8proc_int32_t uc, utf8proc_uint8_t *dst) {
    if (uc < 0x00) {
@@ -218,21 +384,364 @@ static utf8proc_ssize_t unsafe_encode_char(utf8proc_int32_t uc, utf8proc_uint8_t
       return 4;
    } else return 0;
 }
+#endif
 
+/* internal: index of the properties of uc in both property tables, without
+   checking whether uc is in range. The number of stages and the block sizes
+   are chosen when utf8proc_data.c is generated(tools/utf8datagen.c) */
+static utf8proc_uint16_t unsafe_get_property_index(utf8proc_int32_t uc) {
+  /* ASSERT: uc >= 0 && uc < 0x110000 */
+#if UTF8PROC_TABLE_STAGES == 3
+  return utf8proc_stage3table[
+    utf8proc_stage2table[
+      utf8proc_stage1table[uc >> (UTF8PROC_STAGE2_BITS + UTF8PROC_STAGE3_BITS)] +
+      ((uc >> UTF8PROC_STAGE3_BITS) & ((1 << UTF8PROC_STAGE2_BITS) - 1))
+    ] + (uc & ((1 << UTF8PROC_STAGE3_BITS) - 1))
+  ];
+#else
+  return utf8proc_stage2table[
+    utf8proc_stage1table[uc >> UTF8PROC_STAGE2_BITS] +
+    (uc & ((1 << UTF8PROC_STAGE2_BITS) - 1))
+  ];
+#endif
+}
+
+#if UTF8PROC_WITH_PROPERTIES
 /* internal "unsafe" version that does not check whether uc is in range */
 static const utf8proc_property_t *unsafe_get_property(utf8proc_int32_t uc) {
   /* ASSERT: uc >= 0 && uc < 0x110000 */
-  return utf8proc_properties + (
-    utf8proc_stage2table[
-      utf8proc_stage1table[uc >> 8] + (uc & 0xFF)
-    ]
-  );
+  return utf8proc_properties + unsafe_get_property_index(uc);
 }
 
 UTF8PROC_DLLEXPORT const utf8proc_property_t *utf8proc_get_property(utf8proc_int32_t uc) {
   return uc < 0 || uc >= 0x110000 ? utf8proc_properties : unsafe_get_property(uc);
 }
+#endif
+
+/* internal: index of the properties of uc in both property tables, the
+   index of unassigned code points if uc is out of range */
+static utf8proc_uint16_t get_property_index(utf8proc_int32_t uc) {
+  return uc < 0 || uc >= 0x110000 ? 0 : unsafe_get_property_index(uc);
+}
+
+static const utf8proc_hot_property_t *get_hot_property(utf8proc_int32_t uc) {
+  return utf8proc_hot_properties + get_property_index(uc);
+}
+
+#if UTF8STR_EXTERNAL_DATA
+/* internal: maps or reads the whole file, NULL on failure */
+static const utf8proc_uint8_t *data_map(const char *path, size_t *size) {
+#ifdef _WIN32
+  FILE *file = fopen(path, "rb");
+  long length;
+  utf8proc_uint8_t *data = NULL;
+  if (!file) return NULL;
+  if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) > 0 &&
+      fseek(file, 0, SEEK_SET) == 0) {
+    *size = (size_t)length;
+    data = (utf8proc_uint8_t *) malloc(*size);
+    if (data && fread(data, 1, *size, file) != *size) {
+      free(data);
+      data = NULL;
+    }
+  }
+  fclose(file);
+  return data;
+#else
+  struct stat st;
+  void *data;
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return NULL;
+  }
+  *size = (size_t)st.st_size;
+  data = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  return data == MAP_FAILED ? NULL : (const utf8proc_uint8_t *) data;
+#endif
+}
 
+static void data_unmap(const utf8proc_uint8_t *data, size_t size) {
+#ifdef _WIN32
+  (void) size;
+  free((void *) data);
+#else
+  munmap((void *) data, size);
+#endif
+}
+
+/* internal: whether a table of the file lies in it, aligned */
+static utf8proc_bool data_table_valid(
+  const utf8proc_data_header_t *header, int table, size_t item_size
+) {
+  utf8proc_uint32_t offset = header->tables[table].offset;
+  return header->tables[table].item_size == item_size &&
+    offset % UTF8PROC_DATA_ALIGN == 0 &&
+    offset >= sizeof(utf8proc_data_header_t) && offset <= header->size &&
+    header->tables[table].count <= (header->size - offset) / item_size;
+}
+
+/* internal: whether every entry of the stage table points to a whole block
+   or entry of the next table */
+static utf8proc_bool data_stage_valid(
+  const utf8proc_uint8_t *data, const utf8proc_data_header_t *header,
+  int table, utf8proc_uint32_t block, utf8proc_uint32_t next_count
+) {
+  const utf8proc_uint16_t *entries =
+    (const utf8proc_uint16_t *) (data + header->tables[table].offset);
+  utf8proc_uint32_t i;
+  for (i = 0; i < header->tables[table].count; i++) {
+    if ((utf8proc_uint32_t) entries[i] + block > next_count) return false;
+  }
+  return true;
+}
+
+#if UTF8PROC_WITH_SCRIPTS
+/* internal: whether the script table maps every code point to a script or
+   to an extension set that lies in the table of sets */
+static utf8proc_bool data_scripts_valid(
+  const utf8proc_uint8_t *data, const utf8proc_data_header_t *header
+) {
+  const utf8proc_uint8_t *values =
+    data + header->tables[UTF8PROC_DATA_SCRIPT_STAGE2].offset;
+  const utf8proc_uint8_t *sets =
+    data + header->tables[UTF8PROC_DATA_SCRIPT_SETS].offset;
+  const utf8proc_uint16_t *index = (const utf8proc_uint16_t *)
+    (data + header->tables[UTF8PROC_DATA_SCRIPT_SET_INDEX].offset);
+  utf8proc_uint32_t nsets = header->tables[UTF8PROC_DATA_SCRIPT_SETS].count;
+  utf8proc_uint32_t nindex = header->tables[UTF8PROC_DATA_SCRIPT_SET_INDEX].count;
+  utf8proc_uint32_t i;
+  if (header->script_bits != UTF8PROC_SCRIPT_BITS ||
+      header->script_extension_base != UTF8PROC_SCRIPT_EXTENSION_BASE ||
+      header->tables[UTF8PROC_DATA_SCRIPT_STAGE1].count !=
+        sizeof(data_empty_script_stage1) / sizeof(data_empty_script_stage1[0]) ||
+      !data_stage_valid(data, header, UTF8PROC_DATA_SCRIPT_STAGE1, 1 << UTF8PROC_SCRIPT_BITS,
+                        header->tables[UTF8PROC_DATA_SCRIPT_STAGE2].count)) {
+    return false;
+  }
+  for (i = 0; i < header->tables[UTF8PROC_DATA_SCRIPT_STAGE2].count; i++) {
+    if (values[i] >= UTF8PROC_SCRIPT_EXTENSION_BASE + nindex) return false;
+  }
+  for (i = 0; i < nindex; i++) {
+    if (index[i] + 2 > nsets || index[i] + 2 + sets[index[i] + 1] > nsets) return false;
+  }
+  return true;
+}
+#endif
+
+#if UTF8PROC_WITH_LINEBREAKS
+/* internal: whether the line break table maps every code point to a class */
+static utf8proc_bool data_linebreaks_valid(
+  const utf8proc_uint8_t *data, const utf8proc_data_header_t *header
+) {
+  const utf8proc_uint8_t *values =
+    data + header->tables[UTF8PROC_DATA_LINEBREAK_STAGE2].offset;
+  utf8proc_uint32_t i;
+  if (header->linebreak_bits != UTF8PROC_LINEBREAK_BITS ||
+      header->tables[UTF8PROC_DATA_LINEBREAK_STAGE1].count !=
+        sizeof(data_empty_linebreak_stage1) / sizeof(data_empty_linebreak_stage1[0]) ||
+      !data_stage_valid(data, header, UTF8PROC_DATA_LINEBREAK_STAGE1, 1 << UTF8PROC_LINEBREAK_BITS,
+                        header->tables[UTF8PROC_DATA_LINEBREAK_STAGE2].count)) {
+    return false;
+  }
+  for (i = 0; i < header->tables[UTF8PROC_DATA_LINEBREAK_STAGE2].count; i++) {
+    if (values[i] > UTF8PROC_LINEBREAK_SA) return false;
+  }
+  return true;
+}
+#endif
+
+/* internal: whether count code points from start lie in the sequence table,
+   as the lookup decodes them */
+static utf8proc_bool data_sequence_valid(
+  const utf8proc_uint16_t *sequences, utf8proc_uint32_t nsequences,
+  utf8proc_uint32_t start, utf8proc_uint32_t count
+) {
+  while (count-- > 0) {
+    if (start >= nsequences) return false;
+    if ((sequences[start] & 0xF800) == 0xD800) start++;
+    start++;
+  }
+  return start <= nsequences;
+}
+
+/* internal: whether a decomposition or case folding of the sequence table,
+   a start and a length packed in seqindex, lies in it */
+static utf8proc_bool data_decomposition_valid(
+  const utf8proc_uint16_t *sequences, utf8proc_uint32_t nsequences,
+  utf8proc_uint16_t seqindex
+) {
+  utf8proc_uint32_t start = seqindex & 0x1FFF, len = seqindex >> 13;
+  if (seqindex == UINT16_MAX) return true;
+  if (len >= 7) {
+    if (start >= nsequences) return false;
+    len = sequences[start++];
+  }
+  return data_sequence_valid(sequences, nsequences, start, len + 1);
+}
+
+/* internal: whether the sequences and combinations that the properties refer
+   to lie in their tables. A starter reads the first and last combining index
+   of its entries and the entries between them, the entry of a combining
+   character flagged 0x4000 takes two items */
+static utf8proc_bool data_properties_valid(
+  const utf8proc_uint8_t *data, const utf8proc_data_header_t *header
+) {
+  const utf8proc_property_t *props = (const utf8proc_property_t *)
+    (data + header->tables[UTF8PROC_DATA_PROPERTIES].offset);
+  const utf8proc_uint16_t *sequences = (const utf8proc_uint16_t *)
+    (data + header->tables[UTF8PROC_DATA_SEQUENCES].offset);
+  const utf8proc_uint16_t *combinations = (const utf8proc_uint16_t *)
+    (data + header->tables[UTF8PROC_DATA_COMBINATIONS].offset);
+  utf8proc_uint32_t nsequences = header->tables[UTF8PROC_DATA_SEQUENCES].count;
+  utf8proc_uint32_t ncombinations = header->tables[UTF8PROC_DATA_COMBINATIONS].count;
+  utf8proc_uint32_t nprops = header->tables[UTF8PROC_DATA_PROPERTIES].count;
+  utf8proc_uint8_t wide[0x4000 / 8];
+  utf8proc_uint32_t i;
+  memset(wide, 0, sizeof(wide));
+  for (i = 0; i < nprops; i++) {
+    utf8proc_uint16_t cidx = props[i].comb_index;
+    if (cidx != UINT16_MAX && (cidx & 0xC000) == 0xC000) {
+      wide[(cidx & 0x3FFF) >> 3] |= (utf8proc_uint8_t) (1 << (cidx & 7));
+    }
+  }
+  for (i = 0; i < nprops; i++) {
+    const utf8proc_property_t *prop = &props[i];
+    utf8proc_uint32_t sidx = prop->comb_index, first, last;
+    if (!data_decomposition_valid(sequences, nsequences, prop->decomp_seqindex) ||
+        !data_decomposition_valid(sequences, nsequences, prop->casefold_seqindex) ||
+        (prop->uppercase_seqindex != UINT16_MAX &&
+         !data_sequence_valid(sequences, nsequences, prop->uppercase_seqindex, 1)) ||
+        (prop->lowercase_seqindex != UINT16_MAX &&
+         !data_sequence_valid(sequences, nsequences, prop->lowercase_seqindex, 1)) ||
+        (prop->titlecase_seqindex != UINT16_MAX &&
+         !data_sequence_valid(sequences, nsequences, prop->titlecase_seqindex, 1))) {
+      return false;
+    }
+    if (sidx < 0x8000) {
+      if (sidx + 2 > ncombinations) return false;
+      first = combinations[sidx];
+      last = combinations[sidx + 1];
+      if (first <= last && (last > 0x3FFF ||
+          sidx + 3 + (last - first) + ((wide[last >> 3] >> (last & 7)) & 1) > ncombinations)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static utf8proc_bool data_valid(const utf8proc_uint8_t *data, size_t size) {
+  const utf8proc_data_header_t *header = (const utf8proc_data_header_t *) data;
+  utf8proc_uint32_t nprops;
+  if (size < sizeof(utf8proc_data_header_t) ||
+      memcmp(header->magic, UTF8PROC_DATA_MAGIC, sizeof(UTF8PROC_DATA_MAGIC)) != 0 ||
+      header->format != UTF8PROC_DATA_FORMAT ||
+      header->byte_order != UTF8PROC_DATA_BYTE_ORDER ||
+      header->size != size ||
+      !memchr(header->unicode_version, 0, sizeof(header->unicode_version))) {
+    return false;
+  }
+#if UTF8PROC_TABLE_STAGES == 3
+  if (header->stages != 3 || header->stage2_bits != UTF8PROC_STAGE2_BITS ||
+      header->stage3_bits != UTF8PROC_STAGE3_BITS) return false;
+#else
+  if (header->stages != 2 || header->stage2_bits != UTF8PROC_STAGE2_BITS ||
+      header->stage3_bits != 0) return false;
+#endif
+  if (!data_table_valid(header, UTF8PROC_DATA_SEQUENCES, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_STAGE1, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_STAGE2, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_STAGE3, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_PROPERTIES, sizeof(utf8proc_property_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_HOT_PROPERTIES, sizeof(utf8proc_hot_property_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_COMBINATIONS, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_SCRIPT_STAGE1, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_SCRIPT_STAGE2, sizeof(utf8proc_uint8_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_SCRIPT_SETS, sizeof(utf8proc_uint8_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_SCRIPT_SET_INDEX, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_LINEBREAK_STAGE1, sizeof(utf8proc_uint16_t)) ||
+      !data_table_valid(header, UTF8PROC_DATA_LINEBREAK_STAGE2, sizeof(utf8proc_uint8_t))) {
+    return false;
+  }
+  if (header->checksum != data_checksum(data + sizeof(utf8proc_data_header_t),
+                                        size - sizeof(utf8proc_data_header_t))) {
+    return false;
+  }
+  /* the lookup reads no further checked index, so bound every stage */
+  nprops = header->tables[UTF8PROC_DATA_PROPERTIES].count;
+  if (nprops == 0 || header->tables[UTF8PROC_DATA_HOT_PROPERTIES].count != nprops ||
+      header->tables[UTF8PROC_DATA_STAGE1].count != sizeof(data_empty_stage1) / sizeof(data_empty_stage1[0])) {
+    return false;
+  }
+  if (!data_properties_valid(data, header)) return false;
+#if UTF8PROC_WITH_SCRIPTS
+  if (!data_scripts_valid(data, header)) return false;
+#endif
+#if UTF8PROC_WITH_LINEBREAKS
+  if (!data_linebreaks_valid(data, header)) return false;
+#endif
+#if UTF8PROC_TABLE_STAGES == 3
+  return data_stage_valid(data, header, UTF8PROC_DATA_STAGE1, 1 << UTF8PROC_STAGE2_BITS,
+                          header->tables[UTF8PROC_DATA_STAGE2].count) &&
+    data_stage_valid(data, header, UTF8PROC_DATA_STAGE2, 1 << UTF8PROC_STAGE3_BITS,
+                     header->tables[UTF8PROC_DATA_STAGE3].count) &&
+    data_stage_valid(data, header, UTF8PROC_DATA_STAGE3, 1, nprops);
+#else
+  return header->tables[UTF8PROC_DATA_STAGE3].count == 0 &&
+    data_stage_valid(data, header, UTF8PROC_DATA_STAGE1, 1 << UTF8PROC_STAGE2_BITS,
+                     header->tables[UTF8PROC_DATA_STAGE2].count) &&
+    data_stage_valid(data, header, UTF8PROC_DATA_STAGE2, 1, nprops);
+#endif
+}
+
+UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_load_data(const char *path) {
+  const utf8proc_data_header_t *header;
+  const utf8proc_uint8_t *data;
+  size_t size;
+  data = data_map(path, &size);
+  if (!data) return UTF8PROC_ERROR_INVALIDDATA;
+  if (!data_valid(data, size)) {
+    data_unmap(data, size);
+    return UTF8PROC_ERROR_INVALIDDATA;
+  }
+  header = (const utf8proc_data_header_t *) data;
+#define UTF8PROC_DATA_TABLE(type, table) \
+  ((const type *) (data + header->tables[table].offset))
+#if UTF8PROC_WITH_SEQUENCES
+  utf8proc_sequences = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_SEQUENCES);
+#endif
+  utf8proc_stage1table = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_STAGE1);
+  utf8proc_stage2table = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_STAGE2);
+#if UTF8PROC_TABLE_STAGES == 3
+  utf8proc_stage3table = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_STAGE3);
+#endif
+#if UTF8PROC_WITH_PROPERTIES
+  utf8proc_properties = UTF8PROC_DATA_TABLE(utf8proc_property_t, UTF8PROC_DATA_PROPERTIES);
+#endif
+  utf8proc_hot_properties = UTF8PROC_DATA_TABLE(utf8proc_hot_property_t, UTF8PROC_DATA_HOT_PROPERTIES);
+#if UTF8PROC_WITH_COMBINATIONS
+  utf8proc_combinations = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_COMBINATIONS);
+#endif
+#if UTF8PROC_WITH_SCRIPTS
+  utf8proc_script_stage1 = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_SCRIPT_STAGE1);
+  utf8proc_script_stage2 = UTF8PROC_DATA_TABLE(utf8proc_uint8_t, UTF8PROC_DATA_SCRIPT_STAGE2);
+  utf8proc_script_sets = UTF8PROC_DATA_TABLE(utf8proc_uint8_t, UTF8PROC_DATA_SCRIPT_SETS);
+  utf8proc_script_set_index = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_SCRIPT_SET_INDEX);
+#endif
+#if UTF8PROC_WITH_LINEBREAKS
+  utf8proc_linebreak_stage1 = UTF8PROC_DATA_TABLE(utf8proc_uint16_t, UTF8PROC_DATA_LINEBREAK_STAGE1);
+  utf8proc_linebreak_stage2 = UTF8PROC_DATA_TABLE(utf8proc_uint8_t, UTF8PROC_DATA_LINEBREAK_STAGE2);
+#endif
+#undef UTF8PROC_DATA_TABLE
+  memcpy(data_unicode_version, header->unicode_version, sizeof(data_unicode_version));
+  return 0;
+}
+#endif
+
+#if UTF8STR_WITH_GRAPHEME || UTF8STR_WITH_NORMALIZATION
 /* return whether there is a grapheme break between boundclasses lbc and tbc
    (according to the definition of extended grapheme clusters)
 
@@ -276,43 +785,73 @@ static utf8proc_bool grapheme_break_simple(int lbc, int tbc) {
      tbc == UTF8PROC_BOUNDCLASS_E_MODIFIER) ? false : // ----
     (lbc == UTF8PROC_BOUNDCLASS_ZWJ &&                         // GB11
      (tbc == UTF8PROC_BOUNDCLASS_GLUE_AFTER_ZWJ ||             // ----
-      tbc == UTF8PROC_BOUNDCLASS_E_BASE_GAZ)) ? false :        // ----
+      tbc == UTF8PROC_BOUNDCLASS_E_BASE_GAZ ||                 // ----
+      tbc == UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC)) ? false : // (requires additional handling below)
     (lbc == UTF8PROC_BOUNDCLASS_REGIONAL_INDICATOR &&          // GB12/13 (requires additional handling below)
      tbc == UTF8PROC_BOUNDCLASS_REGIONAL_INDICATOR) ? false :  // ----
     true; // GB999
 }
 
+/* internal state value: a ZWJ that does not follow an emoji, which joins
+   Glue_After_Zwj characters but not Extended_Pictographic ones */
+#define GRAPHEME_STATE_LONE_ZWJ 0x40
+
+static utf8proc_bool grapheme_is_emoji_class(int bc)
+{
+  return bc == UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC ||
+    bc == UTF8PROC_BOUNDCLASS_E_BASE ||
+    bc == UTF8PROC_BOUNDCLASS_E_BASE_GAZ ||
+    bc == UTF8PROC_BOUNDCLASS_GLUE_AFTER_ZWJ ||
+    bc == UTF8PROC_BOUNDCLASS_E_MODIFIER;
+}
+
 static utf8proc_bool grapheme_break_extended(int lbc, int tbc, utf8proc_int32_t *state)
 {
   int lbc_override = lbc;
+  utf8proc_bool break_permitted;
   if (state && *state != UTF8PROC_BOUNDCLASS_START)
     lbc_override = *state;
-  utf8proc_bool break_permitted = grapheme_break_simple(lbc_override, tbc);
+  if (lbc_override == GRAPHEME_STATE_LONE_ZWJ)
+    break_permitted = tbc == UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC ||
+      grapheme_break_simple(UTF8PROC_BOUNDCLASS_ZWJ, tbc);
+  else
+    break_permitted = grapheme_break_simple(lbc_override, tbc);
   if (state) {
     // Special support for GB 12/13 made possible by GB999. After two RI
     // class codepoints we want to force a break. Do this by resetting the
     // second RI's bound class to UTF8PROC_BOUNDCLASS_OTHER, to force a break
     // after that character according to GB999 (unless of course such a break is
     // forbidden by a different rule such as GB9).
-    if (*state == tbc && tbc == UTF8PROC_BOUNDCLASS_REGIONAL_INDICATOR)
+    if (lbc_override == tbc && tbc == UTF8PROC_BOUNDCLASS_REGIONAL_INDICATOR)
       *state = UTF8PROC_BOUNDCLASS_OTHER;
     // Special support for GB10. Fold any EXTEND codepoints into the previous
     // boundclass if we're dealing with an emoji base boundclass.
-    else if ((*state == UTF8PROC_BOUNDCLASS_E_BASE      ||
-              *state == UTF8PROC_BOUNDCLASS_E_BASE_GAZ) &&
+    else if ((lbc_override == UTF8PROC_BOUNDCLASS_E_BASE      ||
+              lbc_override == UTF8PROC_BOUNDCLASS_E_BASE_GAZ) &&
              tbc == UTF8PROC_BOUNDCLASS_EXTEND)
       *state = UTF8PROC_BOUNDCLASS_E_BASE;
+    // Likewise for emoji ZWJ sequences: EXTEND codepoints keep an
+    // Extended_Pictographic, and a ZWJ only joins the next one to it (GB11 of
+    // later Unicode versions).
+    else if (lbc_override == UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC &&
+             tbc == UTF8PROC_BOUNDCLASS_EXTEND)
+      *state = UTF8PROC_BOUNDCLASS_EXTENDED_PICTOGRAPHIC;
+    else if (tbc == UTF8PROC_BOUNDCLASS_ZWJ &&
+             (break_permitted || !grapheme_is_emoji_class(lbc_override)))
+      *state = GRAPHEME_STATE_LONE_ZWJ;
     else
       *state = tbc;
   }
   return break_permitted;
 }
+#endif
 
+#if UTF8STR_WITH_GRAPHEME
 UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_grapheme_break_stateful(
     utf8proc_int32_t c1, utf8proc_int32_t c2, utf8proc_int32_t *state) {
 
-  return grapheme_break_extended(utf8proc_get_property(c1)->boundclass,
-                                 utf8proc_get_property(c2)->boundclass,
+  return grapheme_break_extended(get_hot_property(c1)->boundclass,
+                                 get_hot_property(c2)->boundclass,
                                  state);
 }
 
@@ -322,6 +861,13 @@ UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_grapheme_break(
   return utf8proc_grapheme_break_stateful(c1, c2, NULL);
 }
 
+UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_grapheme_break_boundclass(
+    int boundclass1, int boundclass2, utf8proc_int32_t *state) {
+  return grapheme_break_extended(boundclass1, boundclass2, state);
+}
+#endif
+
+#if UTF8PROC_WITH_SEQUENCES
 static utf8proc_int32_t seqindex_decode_entry(const utf8proc_uint16_t **entry)
 {
   utf8proc_int32_t entry_cp = **entry;
@@ -332,13 +878,17 @@ static utf8proc_int32_t seqindex_decode_entry(const utf8proc_uint16_t **entry)
   }
   return entry_cp;
 }
+#endif
 
+#if UTF8STR_WITH_CASE
 static utf8proc_int32_t seqindex_decode_index(const utf8proc_uint32_t seqindex)
 {
   const utf8proc_uint16_t *entry = &utf8proc_sequences[seqindex];
   return seqindex_decode_entry(&entry);
 }
+#endif
 
+#if UTF8STR_WITH_NORMALIZATION
 static utf8proc_ssize_t seqindex_write_char_decomposed(utf8proc_uint16_t seqindex, utf8proc_int32_t *dst, utf8proc_ssize_t bufsize, utf8proc_option_t options, int *last_boundclass) {
   utf8proc_ssize_t written = 0;
   const utf8proc_uint16_t *entry = &utf8proc_sequences[seqindex & 0x1FFF];
@@ -357,33 +907,77 @@ static utf8proc_ssize_t seqindex_write_char_decomposed(utf8proc_uint16_t seqinde
   }
   return written;
 }
+#endif
 
+#if UTF8STR_WITH_CASE
 UTF8PROC_DLLEXPORT utf8proc_int32_t utf8proc_tolower(utf8proc_int32_t c)
 {
-  utf8proc_int32_t cl = utf8proc_get_property(c)->lowercase_seqindex;
+  utf8proc_uint16_t index = get_property_index(c);
+  utf8proc_int32_t cl;
+  if (!utf8proc_hot_properties[index].casemap) return c;
+  cl = utf8proc_properties[index].lowercase_seqindex;
   return cl != UINT16_MAX ? seqindex_decode_index(cl) : c;
 }
 
 UTF8PROC_DLLEXPORT utf8proc_int32_t utf8proc_toupper(utf8proc_int32_t c)
 {
-  utf8proc_int32_t cu = utf8proc_get_property(c)->uppercase_seqindex;
+  utf8proc_uint16_t index = get_property_index(c);
+  utf8proc_int32_t cu;
+  if (!utf8proc_hot_properties[index].casemap) return c;
+  cu = utf8proc_properties[index].uppercase_seqindex;
   return cu != UINT16_MAX ? seqindex_decode_index(cu) : c;
 }
 
 UTF8PROC_DLLEXPORT utf8proc_int32_t utf8proc_totitle(utf8proc_int32_t c)
 {
-  utf8proc_int32_t cu = utf8proc_get_property(c)->titlecase_seqindex;
+  utf8proc_uint16_t index = get_property_index(c);
+  utf8proc_int32_t cu;
+  if (!utf8proc_hot_properties[index].casemap) return c;
+  cu = utf8proc_properties[index].titlecase_seqindex;
   return cu != UINT16_MAX ? seqindex_decode_index(cu) : c;
 }
+#endif
 
+#if UTF8STR_WITH_WIDTH
 /* return a character width analogous to wcwidth (except portable and
    hopefully less buggy than most system wcwidth functions). */
 UTF8PROC_DLLEXPORT int utf8proc_charwidth(utf8proc_int32_t c) {
-  return utf8proc_get_property(c)->charwidth;
+  return get_hot_property(c)->charwidth;
 }
 
+UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_charwidth_ambiguous(utf8proc_int32_t c) {
+  return get_hot_property(c)->ambiguous;
+}
+
+UTF8PROC_DLLEXPORT int utf8proc_width_props(utf8proc_int32_t c) {
+  const utf8proc_hot_property_t *property = get_hot_property(c);
+  return property->charwidth | (property->ambiguous << 2) |
+    (property->emoji << 3) | (property->boundclass << 8);
+}
+#endif
+
 UTF8PROC_DLLEXPORT utf8proc_category_t utf8proc_category(utf8proc_int32_t c) {
-  return utf8proc_get_property(c)->category;
+  return get_hot_property(c)->category;
+}
+
+UTF8PROC_DLLEXPORT int utf8proc_emoji(utf8proc_int32_t c) {
+  return get_hot_property(c)->emoji;
+}
+
+UTF8PROC_DLLEXPORT int utf8proc_quick_props(utf8proc_int32_t c) {
+  const utf8proc_hot_property_t *property = get_hot_property(c);
+  int props = property->combining_class << 8;
+  if (property->combining_class) props |= UTF8PROC_QUICK_COMBINING;
+  if (property->nfc_check) props |= UTF8PROC_QUICK_NFC_CHECK;
+  if (property->casemap) props |= UTF8PROC_QUICK_CASEMAP;
+  if (property->charwidth != 1) props |= UTF8PROC_QUICK_NOT_NARROW;
+  /* Bidi_Control characters are all format characters */
+  if (property->category == UTF8PROC_CATEGORY_CC ||
+      (property->category == UTF8PROC_CATEGORY_CF &&
+       (c == 0x061C || c == 0x200E || c == 0x200F ||
+        (c >= 0x202A && c <= 0x202E) || (c >= 0x2066 && c <= 0x2069))))
+    props |= UTF8PROC_QUICK_CONTROL;
+  return props;
 }
 
 UTF8PROC_DLLEXPORT const char *utf8proc_category_string(utf8proc_int32_t c) {
@@ -391,8 +985,74 @@ UTF8PROC_DLLEXPORT const char *utf8proc_category_string(utf8proc_int32_t c) {
   return s[utf8proc_category(c)];
 }
 
+#if UTF8STR_WITH_SCRIPT
+/* internal: the script of c, or UTF8PROC_SCRIPT_EXTENSION_BASE plus the index
+   of its script extension set */
+static utf8proc_uint8_t get_script_value(utf8proc_int32_t c) {
+  if (c < 0 || c >= 0x110000) return UTF8PROC_SCRIPT_UNKNOWN;
+  return utf8proc_script_stage2[
+    utf8proc_script_stage1[c >> UTF8PROC_SCRIPT_BITS] + (c & ((1 << UTF8PROC_SCRIPT_BITS) - 1))
+  ];
+}
 
+/* internal: the script, the number of scripts and the scripts of the set */
+static const utf8proc_uint8_t *get_script_extension(utf8proc_uint8_t value) {
+  return utf8proc_script_sets +
+    utf8proc_script_set_index[value - UTF8PROC_SCRIPT_EXTENSION_BASE];
+}
 
+UTF8PROC_DLLEXPORT utf8proc_script_t utf8proc_script(utf8proc_int32_t c) {
+  utf8proc_uint8_t value = get_script_value(c);
+  if (value < UTF8PROC_SCRIPT_EXTENSION_BASE) return (utf8proc_script_t) value;
+  return (utf8proc_script_t) get_script_extension(value)[0];
+}
+
+UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_script_extensions(
+  utf8proc_int32_t c, utf8proc_script_t *dst, utf8proc_ssize_t bufsize
+) {
+  utf8proc_uint8_t value = get_script_value(c);
+  const utf8proc_uint8_t *ext;
+  utf8proc_ssize_t i;
+  if (value < UTF8PROC_SCRIPT_EXTENSION_BASE) {
+    if (bufsize > 0) dst[0] = (utf8proc_script_t) value;
+    return 1;
+  }
+  ext = get_script_extension(value);
+  for (i = 0; i < ext[1] && i < bufsize; i++) {
+    dst[i] = (utf8proc_script_t) ext[2 + i];
+  }
+  return ext[1];
+}
+
+UTF8PROC_DLLEXPORT utf8proc_bool utf8proc_has_script(utf8proc_int32_t c, utf8proc_script_t script) {
+  utf8proc_uint8_t value = get_script_value(c);
+  const utf8proc_uint8_t *ext;
+  int i;
+  if (value < UTF8PROC_SCRIPT_EXTENSION_BASE) return value == (utf8proc_uint8_t) script;
+  ext = get_script_extension(value);
+  for (i = 0; i < ext[1]; i++) {
+    if (ext[2 + i] == (utf8proc_uint8_t) script) return true;
+  }
+  return false;
+}
+
+UTF8PROC_DLLEXPORT const char *utf8proc_script_code(utf8proc_script_t script) {
+  if ((unsigned int) script >= UTF8PROC_SCRIPT_EXTENSION_BASE) return "Zzzz";
+  return utf8proc_script_codes[script];
+}
+#endif
+
+#if UTF8STR_WITH_LINEBREAK
+UTF8PROC_DLLEXPORT utf8proc_linebreak_t utf8proc_linebreak(utf8proc_int32_t c) {
+  if (c < 0 || c >= 0x110000) return UTF8PROC_LINEBREAK_XX;
+  return (utf8proc_linebreak_t) utf8proc_linebreak_stage2[
+    utf8proc_linebreak_stage1[c >> UTF8PROC_LINEBREAK_BITS] + (c & ((1 << UTF8PROC_LINEBREAK_BITS) - 1))
+  ];
+}
+#endif
+
+
+#if UTF8STR_WITH_NORMALIZATION
 #define utf8proc_decompose_lump(replacement_uc) \
   return utf8proc_decompose_char((replacement_uc), dst, bufsize, \
   options & ~UTF8PROC_LUMP, last_boundclass)
@@ -527,11 +1187,11 @@ UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_decompose(
     utf8proc_ssize_t pos = 0;
     while (pos < wpos-1) {
       utf8proc_int32_t uc1, uc2;
-      const utf8proc_property_t *property1, *property2;
+      const utf8proc_hot_property_t *property1, *property2;
       uc1 = buffer[pos];
       uc2 = buffer[pos+1];
-      property1 = unsafe_get_property(uc1);
-      property2 = unsafe_get_property(uc2);
+      property1 = get_hot_property(uc1);
+      property2 = get_hot_property(uc2);
       if (property1->combining_class > property2->combining_class &&
           property2->combining_class > 0) {
         buffer[pos] = uc2;
@@ -625,7 +1285,7 @@ UTF8PROC_DLLEXPORT utf8proc_ssize_t utf8proc_reencode(utf8proc_int32_t *buffer,
             current_property->comb_index >= 0x8000) {
           int sidx = starter_property->comb_index;
           int idx = (current_property->comb_index & 0x3FFF) - utf8proc_combinations[sidx];
-          if (idx >= 0 && idx <= utf8proc_combinations[sidx + 1] ) {
+          if (idx >= 0 && idx <= utf8proc_combinations[sidx + 1] - utf8proc_combinations[sidx]) {
             idx += sidx + 2;
             if (current_property->comb_index & 0x4000) {
               composition = (utf8proc_combinations[idx] << 16) | utf8proc_combinations[idx+1];
@@ -730,4 +1390,4 @@ UTF8PROC_DLLEXPORT utf8proc_uint8_t *utf8proc_NFKC(const utf8proc_uint8_t *str)
     UTF8PROC_COMPOSE | UTF8PROC_COMPAT);
   return retval;
 }
-
+#endif
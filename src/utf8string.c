@@ -1,9 +1,18 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "utf8proc.h"
 #include "utf8string.h"
+#include "utf8string_data.c"
 
 /* Information about word iterator used only by internal functions */
 struct utf8str_iter_internal_t {
@@ -151,6 +160,52 @@ static size_t cp_length(utf8proc_uint32_t cp) {
     }
 }
 
+/* Writes size bytes of the pattern repeated from its start: the pattern is
+ * copied once, then the bytes written so far are copied after themselves */
+static void fill_repeat(char *dest, const char *pattern, size_t pattern_sz, size_t size) {
+    size_t done = (size < pattern_sz) ? size : pattern_sz;
+    memcpy(dest, pattern, done);
+    while (done < size) {
+        size_t n = (done < size - done) ? done : size - done;
+        memcpy(dest + done, dest, n);
+        done += n;
+    }
+}
+
+/* Size in bytes of count characters of the valid UTF8 fill of fill_len
+ * characters and fill_sz bytes repeated from its start */
+static size_t fill_chars_size(const char *fill, size_t fill_sz, size_t fill_len, size_t count) {
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)fill;
+    size_t rest;
+    for (rest = count % fill_len; rest > 0; rest--) {
+        do {
+            p++;
+        } while ((*p & 0xC0) == 0x80);
+    }
+    return count / fill_len * fill_sz + (size_t)(p - (const utf8proc_uint8_t*)fill);
+}
+
+static void* default_resize(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    return realloc(ptr, size);
+}
+
+static void default_release(void *ctx, void *ptr) {
+    (void)ctx;
+    free(ptr);
+}
+
+/* realloc and free for the functions given a NULL allocator. It does not
+ * belong to a feature, and builds without the allocating ones leave it unused */
+#if defined(__GNUC__) || defined(__clang__)
+#define DEFAULT_ALLOC_UNUSED __attribute__((unused))
+#else
+#define DEFAULT_ALLOC_UNUSED
+#endif
+DEFAULT_ALLOC_UNUSED
+static const struct utf8str_alloc_t default_alloc = {default_resize, default_release, NULL};
+
+#if UTF8STR_WITH_CASE
 static enum utf8_result process_utf8str(const char *src, char *dest, size_t *dest_sz, utf8str_func fn) {
     if (src == NULL) {
         return UTF8_INVALID_ARG;
@@ -230,272 +285,3192 @@ static enum utf8_result process_utf8str_inplace(char *src, utf8str_func fn, size
     return UTF8_OK;
 }
 
-enum utf8_result utf8str_upcase(const char *src, char *dest, size_t *dest_sz) {
-    return process_utf8str(src, dest, dest_sz, utf8proc_toupper);
-}
+/* Maps a character for process_utf8str_inplace_sz. state is 0 before the first
+ * character and it is kept between calls */
+typedef utf8proc_int32_t (*utf8str_state_func) (utf8proc_int32_t, int *);
 
-enum utf8_result utf8str_lowcase(const char *src, char *dest, size_t *dest_sz) {
-    return process_utf8str(src, dest, dest_sz, utf8proc_tolower);
+static utf8proc_int32_t map_upper(utf8proc_int32_t cp, int *state) {
+    (void)state;
+    return utf8proc_toupper(cp);
 }
 
-enum utf8_result utf8str_upcase_inplace(char *src, size_t count) {
-    return process_utf8str_inplace(src, utf8proc_toupper, count);
+static utf8proc_int32_t map_lower(utf8proc_int32_t cp, int *state) {
+    (void)state;
+    return utf8proc_tolower(cp);
 }
 
-enum utf8_result utf8str_lowcase_inplace(char *src, size_t count) {
-    return process_utf8str_inplace(src, utf8proc_tolower, count);
-}
+static enum utf8_result process_utf8str_inplace_sz(char *str, size_t buf_sz, size_t count, utf8str_state_func fn) {
+    if (str == NULL) {
+        return UTF8_INVALID_ARG;
+    }
 
+    /* the first pass validates the string, calculates the result size and
+     * how far the result gets ahead of the source at most */
+    size_t len, processed = 0, pos, dst_len = 0, ahead = 0, grow_from = 0;
+    utf8proc_uint8_t *ustr = (utf8proc_uint8_t*)str;
+    utf8proc_uint8_t *usrc = ustr;
+    utf8proc_int32_t cp;
+    int state = 0;
 
-enum utf8_result utf8str_equal_no_case(const char *orig, const char *cmp) {
-    return utf8str_nequal_no_case(orig, cmp, 0);
+    while (*usrc && (count == 0 || processed < count)) {
+        len = utf8proc_iterate(usrc, -1, &cp);
+
+        if (cp == -1) {
+            return UTF8_INVALID_UTF;
+        }
+
+        dst_len += cp_length((*fn)(cp, &state));
+        usrc += len;
+        ++processed;
+
+        pos = usrc - ustr;
+        if (dst_len > pos && dst_len - pos > ahead) {
+            if (ahead == 0) {
+                grow_from = pos - len;
+            }
+            ahead = dst_len - pos;
+        }
+    }
+
+    size_t proc_len = usrc - ustr;
+    size_t rest = strlen((char *)usrc);
+    if (buf_sz <= proc_len + rest) {
+        return UTF8_INVALID_ARG;
+    }
+    if (dst_len + rest >= buf_sz || proc_len + rest + ahead > buf_sz) {
+        return UTF8_BUFFER_SMALL;
+    }
+
+    /* the second pass cannot fail. Right before the first character that makes
+     * the result longer the source tail is shifted once, so the result never
+     * overwrites characters that are not processed yet */
+    size_t shift = 0;
+    utf8proc_uint8_t *udst = ustr;
+    state = 0;
+    pos = 0;
+
+    while (pos < proc_len) {
+        if (ahead != 0 && shift == 0 && pos == grow_from) {
+            memmove(ustr + pos + ahead, ustr + pos, proc_len + rest - pos);
+            shift = ahead;
+        }
+
+        len = utf8proc_iterate(ustr + pos + shift, -1, &cp);
+        udst += utf8proc_encode_char((*fn)(cp, &state), udst);
+        pos += len;
+    }
+
+    memmove(udst, ustr + pos + shift, rest);
+    udst[rest] = '\0';
+
+    return UTF8_OK;
 }
 
-enum utf8_result utf8str_nequal_no_case(const char *orig, const char *cmp, size_t maxlen) {
-    if (orig == NULL && cmp == NULL) {
-        return UTF8_EQUAL;
+static enum utf8_result process_utf8str_alloc(const char *src, char **dest, size_t *dest_len,
+        utf8str_func fn, const struct utf8str_alloc_t *alloc) {
+    if (src == NULL || dest == NULL) {
+        return UTF8_INVALID_ARG;
     }
-    if (orig == NULL || cmp == NULL) {
-        return UTF8_NEQUAL;
+    if (alloc == NULL) {
+        alloc = &default_alloc;
     }
 
-    size_t cnt, compared = 0;
-    utf8proc_uint8_t *uorig = (utf8proc_uint8_t*)orig;
-    utf8proc_uint8_t *ucmp = (utf8proc_uint8_t*)cmp;
-    utf8proc_int32_t cporig, cpcmp;
+    /* most conversions do not change the length, so start with the original
+     * size and grow the buffer geometrically if it is not enough */
+    size_t cap = strlen(src) + 1;
+    size_t len, used = 0, lendst;
+    utf8proc_uint8_t *usrc = (utf8proc_uint8_t*)src;
+    utf8proc_uint8_t *buf = (utf8proc_uint8_t*)alloc->resize(alloc->ctx, NULL, cap);
+    utf8proc_int32_t cpsrc, cpdst;
 
-    while (*uorig && *ucmp) {
-        cnt = utf8proc_iterate(uorig, -1, &cporig);
-        if (cporig == -1) {
-            return UTF8_INVALID_UTF;
-        }
-        uorig += cnt;
-        cporig = utf8proc_toupper(cporig);
+    *dest = NULL;
+    if (buf == NULL) {
+        return UTF8_OUT_OF_MEMORY;
+    }
 
-        cnt = utf8proc_iterate(ucmp, -1, &cpcmp);
-        if (cpcmp == -1) {
+    while (*usrc) {
+        len = utf8proc_iterate(usrc, -1, &cpsrc);
+
+        if (cpsrc == -1) {
+            alloc->release(alloc->ctx, buf);
             return UTF8_INVALID_UTF;
         }
-        ucmp += cnt;
-        cpcmp = utf8proc_toupper(cpcmp);
 
-        if (cporig != cpcmp) {
-            return UTF8_NEQUAL;
+        cpdst = (*fn)(cpsrc);
+        usrc += len;
+
+        lendst = cp_length(cpdst);
+        if (used + lendst >= cap) {
+            utf8proc_uint8_t *grown = (utf8proc_uint8_t*)alloc->resize(alloc->ctx, buf, cap * 2);
+            if (grown == NULL) {
+                alloc->release(alloc->ctx, buf);
+                return UTF8_OUT_OF_MEMORY;
+            }
+            buf = grown;
+            cap *= 2;
         }
 
-        compared++;
-        if (compared >= maxlen && maxlen != 0) {
-            return UTF8_EQUAL;
+        used += utf8proc_encode_char(cpdst, buf + used);
+    }
+
+    buf[used] = '\0';
+    *dest = (char *)buf;
+    if (dest_len) {
+        *dest_len = used;
+    }
+
+    return UTF8_OK;
+}
+
+/* Conditions from SpecialCasing.txt that must be met to apply an override */
+enum case_cond {
+    CASE_ALWAYS,
+    CASE_AFTER_I,
+    CASE_AFTER_SOFT_DOTTED,
+    CASE_AFTER_GREEK,
+    CASE_NOT_BEFORE_DOT,
+    CASE_MORE_ABOVE,
+    CASE_FINAL_SIGMA,
+};
+
+/* Language-specific case mapping of one character. The character is replaced
+ * with up to 3 code points from map(unused ones are 0). If map is all zeroes
+ * the character is removed */
+struct case_override {
+    utf8proc_int32_t cp;
+    enum case_cond cond;
+    utf8proc_int32_t map[3];
+};
+
+static const struct case_override turkic_upper[] = {
+    {0x0069, CASE_ALWAYS, {0x0130}},
+};
+static const struct case_override turkic_lower[] = {
+    {0x0049, CASE_NOT_BEFORE_DOT, {0x0131}},
+    {0x0307, CASE_AFTER_I, {0}},
+};
+static const struct case_override lithuanian_upper[] = {
+    {0x0307, CASE_AFTER_SOFT_DOTTED, {0}},
+};
+static const struct case_override lithuanian_lower[] = {
+    {0x0049, CASE_MORE_ABOVE, {0x0069, 0x0307}},
+    {0x004A, CASE_MORE_ABOVE, {0x006A, 0x0307}},
+    {0x00CC, CASE_ALWAYS, {0x0069, 0x0307, 0x0300}},
+    {0x00CD, CASE_ALWAYS, {0x0069, 0x0307, 0x0301}},
+    {0x0128, CASE_ALWAYS, {0x0069, 0x0307, 0x0303}},
+    {0x012E, CASE_MORE_ABOVE, {0x012F, 0x0307}},
+};
+static const struct case_override greek_upper[] = {
+    {0x0301, CASE_AFTER_GREEK, {0}},
+    {0x0342, CASE_AFTER_GREEK, {0}},
+    {0x0344, CASE_AFTER_GREEK, {0x0308}},
+    {0x0386, CASE_ALWAYS, {0x0391}},
+    {0x0388, CASE_ALWAYS, {0x0395}},
+    {0x0389, CASE_ALWAYS, {0x0397}},
+    {0x038A, CASE_ALWAYS, {0x0399}},
+    {0x038C, CASE_ALWAYS, {0x039F}},
+    {0x038E, CASE_ALWAYS, {0x03A5}},
+    {0x038F, CASE_ALWAYS, {0x03A9}},
+    {0x0390, CASE_ALWAYS, {0x03AA}},
+    {0x03AC, CASE_ALWAYS, {0x0391}},
+    {0x03AD, CASE_ALWAYS, {0x0395}},
+    {0x03AE, CASE_ALWAYS, {0x0397}},
+    {0x03AF, CASE_ALWAYS, {0x0399}},
+    {0x03B0, CASE_ALWAYS, {0x03AB}},
+    {0x03CC, CASE_ALWAYS, {0x039F}},
+    {0x03CD, CASE_ALWAYS, {0x03A5}},
+    {0x03CE, CASE_ALWAYS, {0x03A9}},
+};
+static const struct case_override greek_lower[] = {
+    {0x03A3, CASE_FINAL_SIGMA, {0x03C2}},
+};
+
+#define OVERRIDE_COUNT(tbl) (sizeof(tbl) / sizeof(tbl[0]))
+
+static const struct case_override* find_case_override(const struct case_override *tbl,
+        size_t cnt, utf8proc_int32_t cp) {
+    size_t i;
+    for (i = 0; i < cnt; ++i) {
+        if (tbl[i].cp == cp) {
+            return &tbl[i];
+        }
+        if (tbl[i].cp > cp) {
+            break;
         }
     }
 
-    return (*uorig == '\0' && *ucmp == '\0') ? UTF8_EQUAL : UTF8_NEQUAL;
+    return NULL;
 }
 
+static int is_soft_dotted(utf8proc_int32_t cp) {
+    return cp == 0x0069 || cp == 0x006A || cp == 0x012F || cp == 0x0249 ||
+           cp == 0x0268 || cp == 0x029D || cp == 0x02B2 || cp == 0x03F3 ||
+           cp == 0x0456 || cp == 0x0458 || cp == 0x1D62 || cp == 0x1D96 ||
+           cp == 0x1DA4 || cp == 0x1DA8 || cp == 0x1E2D || cp == 0x1ECB ||
+           cp == 0x2071 || cp == 0x2148 || cp == 0x2149 || cp == 0x2C7C;
+}
 
-enum utf8_result utf8str_starts_with(const char *orig, const char *cmp) {
-    if (orig == NULL && cmp == NULL) {
-        return UTF8_EQUAL;
+static int is_cased(utf8proc_int32_t cp) {
+    return (utf8str_class_cp(cp) & UTF8_CLASS_CASED) != 0;
+}
+
+static int is_case_ignorable(utf8proc_int32_t cp) {
+    utf8proc_category_t ctg = utf8proc_category(cp);
+    return ctg == UTF8PROC_CATEGORY_MN ||
+           ctg == UTF8PROC_CATEGORY_ME ||
+           ctg == UTF8PROC_CATEGORY_CF ||
+           ctg == UTF8PROC_CATEGORY_LM ||
+           ctg == UTF8PROC_CATEGORY_SK ||
+           cp == 0x0027 || cp == 0x002E || cp == 0x003A || cp == 0x00B7 ||
+           cp == 0x2018 || cp == 0x2019 || cp == 0x2024 || cp == 0x2027;
+}
+
+/* Returns the code point that precedes pos or -1 if pos is the string start.
+ * The string is already validated up to pos */
+static utf8proc_int32_t case_prev_cp(const utf8proc_uint8_t *start, const utf8proc_uint8_t **pos) {
+    const utf8proc_uint8_t *p = *pos;
+    utf8proc_int32_t cp;
+
+    if (p == start) {
+        return -1;
     }
-    if (orig == NULL || cmp == NULL) {
-        return UTF8_NEQUAL;
+    do {
+        --p;
+    } while (p != start && (*p & 0xC0) == 0x80);
+
+    utf8proc_iterate(p, -1, &cp);
+    *pos = p;
+    return cp;
+}
+
+/* Returns the code point at pos and moves pos to the next one. Returns 0 at
+ * the string end or -1 if the string is not a valid UTF8 sequence */
+static utf8proc_int32_t case_next_cp(const utf8proc_uint8_t **pos) {
+    utf8proc_int32_t cp;
+
+    if (**pos == '\0') {
+        return 0;
     }
+    utf8proc_ssize_t len = utf8proc_iterate(*pos, -1, &cp);
+    if (cp != -1) {
+        *pos += len;
+    }
+    return cp;
+}
 
-    size_t cnt = 0;
-    utf8proc_uint8_t *uorig = (utf8proc_uint8_t*)orig;
-    utf8proc_uint8_t *ucmp = (utf8proc_uint8_t*)cmp;
-    utf8proc_int32_t cporig, cpcmp;
+static int case_cond_met(enum case_cond cond, const utf8proc_uint8_t *start,
+        const utf8proc_uint8_t *pos, const utf8proc_uint8_t *next) {
+    utf8proc_int32_t cp;
+    int ccc;
 
-    while (*uorig && *ucmp) {
-        cnt = utf8proc_iterate(uorig, -1, &cporig);
-        if (cporig == -1) {
-            return UTF8_INVALID_UTF;
+    switch (cond) {
+    case CASE_ALWAYS:
+        return 1;
+    case CASE_AFTER_I:
+    case CASE_AFTER_SOFT_DOTTED:
+        while ((cp = case_prev_cp(start, &pos)) != -1) {
+            if (cond == CASE_AFTER_I ? cp == 0x0049 : is_soft_dotted(cp)) {
+                return 1;
+            }
+            ccc = utf8proc_get_property(cp)->combining_class;
+            if (ccc == 0 || ccc == 230) {
+                return 0;
+            }
         }
-        uorig += cnt;
+        return 0;
+    case CASE_AFTER_GREEK:
+        while ((cp = case_prev_cp(start, &pos)) != -1) {
+            if (utf8proc_get_property(cp)->combining_class == 0) {
+                return (cp >= 0x0370 && cp <= 0x03FF) || (cp >= 0x1F00 && cp <= 0x1FFF);
+            }
+        }
+        return 0;
+    case CASE_NOT_BEFORE_DOT:
+    case CASE_MORE_ABOVE:
+        while ((cp = case_next_cp(&next)) > 0) {
+            if (cond == CASE_NOT_BEFORE_DOT && cp == 0x0307) {
+                return 0;
+            }
+            ccc = utf8proc_get_property(cp)->combining_class;
+            if (ccc == 230) {
+                return 1;
+            }
+            if (ccc == 0) {
+                break;
+            }
+        }
+        return cond == CASE_NOT_BEFORE_DOT;
+    case CASE_FINAL_SIGMA:
+        while ((cp = case_prev_cp(start, &pos)) != -1 && is_case_ignorable(cp)) {
+        }
+        if (cp == -1 || !is_cased(cp)) {
+            return 0;
+        }
+        while ((cp = case_next_cp(&next)) > 0 && is_case_ignorable(cp)) {
+        }
+        return cp <= 0 || !is_cased(cp);
+    }
 
-        cnt = utf8proc_iterate(ucmp, -1, &cpcmp);
-        if (cpcmp == -1) {
+    return 0;
+}
+
+static enum utf8_result process_utf8str_locale(const char *src, char *dest, size_t *dest_sz,
+        utf8str_func fn, const struct case_override *tbl, size_t tbl_sz) {
+    if (src == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    size_t len = 0, used = 0, lendst, i;
+    const utf8proc_uint8_t *ustart = (const utf8proc_uint8_t*)src;
+    utf8proc_uint8_t *usrc = (utf8proc_uint8_t*)src;
+    utf8proc_uint8_t *udst = (utf8proc_uint8_t*)dest;
+    utf8proc_int32_t cpsrc, simple[3] = {0};
+    const utf8proc_int32_t *cpdst;
+    const struct case_override *ovr;
+
+    while (*usrc) {
+        len = utf8proc_iterate(usrc, -1, &cpsrc);
+
+        if (cpsrc == -1) {
             return UTF8_INVALID_UTF;
         }
-        ucmp += cnt;
 
-        if (cporig != cpcmp) {
-            return UTF8_NEQUAL;
+        ovr = find_case_override(tbl, tbl_sz, cpsrc);
+        if (ovr != NULL && case_cond_met(ovr->cond, ustart, usrc, usrc + len)) {
+            cpdst = ovr->map;
+        } else {
+            simple[0] = (*fn)(cpsrc);
+            cpdst = simple;
+        }
+        usrc += len;
+
+        for (i = 0; i < 3 && cpdst[i] != 0; ++i) {
+            lendst = cp_length(cpdst[i]);
+
+            if (dest != NULL && dest_sz != NULL && *dest_sz != 0) {
+                if (lendst + used >= *dest_sz) {
+                    return UTF8_BUFFER_SMALL;
+                }
+            }
+
+            if (dest != NULL) {
+                lendst = utf8proc_encode_char(cpdst[i], udst);
+                udst += lendst;
+            }
+
+            used += lendst;
         }
     }
 
-    return (*ucmp == '\0') ? UTF8_EQUAL : UTF8_NEQUAL;
+    if (dest != NULL) {
+        *udst = '\0';
+    }
+    if (dest_sz) {
+        *dest_sz = used;
+    }
+
+    return UTF8_OK;
 }
 
-enum utf8_result utf8str_ends_with(const char *orig, const char *cmp) {
-    if (orig == NULL && cmp == NULL) {
-        return UTF8_EQUAL;
+static int is_locale_separator(char c) {
+    return c == '\0' || c == '_' || c == '-' || c == '.' || c == '@';
+}
+
+enum utf8_locale utf8str_locale(const char *name) {
+    if (name == NULL) {
+        return UTF8_LOCALE_DEFAULT;
     }
-    if (orig == NULL || cmp == NULL) {
-        return UTF8_NEQUAL;
+
+    char lang[4] = {0};
+    size_t i;
+    for (i = 0; !is_locale_separator(name[i]); ++i) {
+        if (i == 3) {
+            return UTF8_LOCALE_DEFAULT;
+        }
+        lang[i] = (name[i] >= 'A' && name[i] <= 'Z') ? name[i] - 'A' + 'a' : name[i];
     }
 
-    size_t cmplen = utf8str_count(cmp);
-    if (cmplen == (size_t)-1) {
-        return UTF8_INVALID_UTF;
+    if (strcmp(lang, "tr") == 0 || strcmp(lang, "az") == 0 ||
+        strcmp(lang, "tur") == 0 || strcmp(lang, "aze") == 0) {
+        return UTF8_LOCALE_TURKIC;
     }
-    const char *ends = utf8str_at_index(orig, -(ssize_t)cmplen);
-    if (ends == NULL) {
-        return UTF8_NEQUAL;
+    if (strcmp(lang, "lt") == 0 || strcmp(lang, "lit") == 0) {
+        return UTF8_LOCALE_LITHUANIAN;
+    }
+    if (strcmp(lang, "el") == 0 || strcmp(lang, "ell") == 0) {
+        return UTF8_LOCALE_GREEK;
     }
 
-    return utf8str_starts_with(ends, cmp);
+    return UTF8_LOCALE_DEFAULT;
 }
 
-static utf8proc_category_t utf8str_get_category(const char *str) {
-    if (str == NULL || *str == '\0') {
-        return -1;
+enum utf8_result utf8str_upcase_locale(const char *src, char *dest, size_t *dest_sz, enum utf8_locale locale) {
+    switch (locale) {
+    case UTF8_LOCALE_TURKIC:
+        return process_utf8str_locale(src, dest, dest_sz, utf8proc_toupper,
+                turkic_upper, OVERRIDE_COUNT(turkic_upper));
+    case UTF8_LOCALE_LITHUANIAN:
+        return process_utf8str_locale(src, dest, dest_sz, utf8proc_toupper,
+                lithuanian_upper, OVERRIDE_COUNT(lithuanian_upper));
+    case UTF8_LOCALE_GREEK:
+        return process_utf8str_locale(src, dest, dest_sz, utf8proc_toupper,
+                greek_upper, OVERRIDE_COUNT(greek_upper));
+    default:
+        return process_utf8str(src, dest, dest_sz, utf8proc_toupper);
     }
+}
 
-    utf8proc_uint8_t *ustr = (utf8proc_uint8_t*)str;
-    utf8proc_int32_t cp;
-    utf8proc_iterate(ustr, -1, &cp);
-    if (cp == -1) {
-        return -1;
+enum utf8_result utf8str_lowcase_locale(const char *src, char *dest, size_t *dest_sz, enum utf8_locale locale) {
+    switch (locale) {
+    case UTF8_LOCALE_TURKIC:
+        return process_utf8str_locale(src, dest, dest_sz, utf8proc_tolower,
+                turkic_lower, OVERRIDE_COUNT(turkic_lower));
+    case UTF8_LOCALE_LITHUANIAN:
+        return process_utf8str_locale(src, dest, dest_sz, utf8proc_tolower,
+                lithuanian_lower, OVERRIDE_COUNT(lithuanian_lower));
+    case UTF8_LOCALE_GREEK:
+        return process_utf8str_locale(src, dest, dest_sz, utf8proc_tolower,
+                greek_lower, OVERRIDE_COUNT(greek_lower));
+    default:
+        return process_utf8str(src, dest, dest_sz, utf8proc_tolower);
     }
-
-    return utf8proc_category(cp);
 }
 
-int utf8str_isdigit(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
-    }
+enum utf8_result utf8str_upcase(const char *src, char *dest, size_t *dest_sz) {
+    return process_utf8str(src, dest, dest_sz, utf8proc_toupper);
+}
 
-    return ctg == UTF8PROC_CATEGORY_ND ||
-           ctg == UTF8PROC_CATEGORY_NL ||
-           ctg == UTF8PROC_CATEGORY_NO;
+enum utf8_result utf8str_lowcase(const char *src, char *dest, size_t *dest_sz) {
+    return process_utf8str(src, dest, dest_sz, utf8proc_tolower);
 }
 
-int utf8str_isspace(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
-    }
+enum utf8_result utf8str_upcase_alloc(const char *src, char **dest, size_t *dest_len, const struct utf8str_alloc_t *alloc) {
+    return process_utf8str_alloc(src, dest, dest_len, utf8proc_toupper, alloc);
+}
 
-    return ctg == UTF8PROC_CATEGORY_ZS ||
-           (*str >= 0x09 && *str <= 0x0D);
+enum utf8_result utf8str_lowcase_alloc(const char *src, char **dest, size_t *dest_len, const struct utf8str_alloc_t *alloc) {
+    return process_utf8str_alloc(src, dest, dest_len, utf8proc_tolower, alloc);
 }
 
-static int utf8str_isspace_cp(utf8proc_int32_t cp) {
-    utf8proc_category_t ctg = utf8proc_category(cp);
-    if (ctg == -1) {
-        return 0;
-    }
+enum utf8_result utf8str_upcase_inplace(char *src, size_t count) {
+    return process_utf8str_inplace(src, utf8proc_toupper, count);
+}
 
-    return ctg == UTF8PROC_CATEGORY_ZS ||
-           (cp >= 0x09 && cp <= 0x0D);
+enum utf8_result utf8str_lowcase_inplace(char *src, size_t count) {
+    return process_utf8str_inplace(src, utf8proc_tolower, count);
 }
 
-int utf8str_ispunct(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
-    }
+enum utf8_result utf8str_upcase_inplace_sz(char *str, size_t buf_sz, size_t count) {
+    return process_utf8str_inplace_sz(str, buf_sz, count, map_upper);
+}
 
-    return ctg == UTF8PROC_CATEGORY_PC ||
-           ctg == UTF8PROC_CATEGORY_PD ||
-           ctg == UTF8PROC_CATEGORY_PS ||
-           ctg == UTF8PROC_CATEGORY_PE ||
-           ctg == UTF8PROC_CATEGORY_PF ||
-           ctg == UTF8PROC_CATEGORY_PO ||
-           ctg == UTF8PROC_CATEGORY_PI;
+enum utf8_result utf8str_lowcase_inplace_sz(char *str, size_t buf_sz, size_t count) {
+    return process_utf8str_inplace_sz(str, buf_sz, count, map_lower);
 }
 
-int utf8str_islower(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
+/* Converts a string without case changes or of ASCII characters only the way
+ * process_utf8str does. upper is 'a' to convert to uppercase and 'A' to
+ * lowercase */
+static enum utf8_result process_utf8str_quick(const char *src, char *dest, size_t *dest_sz,
+        utf8str_func fn, unsigned int quick, char upper) {
+    if (src == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+    if (quick == 0) {
+        quick = utf8str_quick_check(src, 0);
+    }
+    if ((quick & UTF8_QUICK_INVALID)
+            || ((quick & UTF8_QUICK_CASE_MAP) && !(quick & UTF8_QUICK_ASCII))) {
+        return process_utf8str(src, dest, dest_sz, fn);
+    }
+
+    size_t len = strlen(src), i;
+    if (dest != NULL) {
+        if (dest_sz != NULL && len != 0 && len >= *dest_sz) {
+            return UTF8_BUFFER_SMALL;
+        }
+        if (quick & UTF8_QUICK_CASE_MAP) {
+            for (i = 0; i < len; i++) {
+                char c = src[i];
+                dest[i] = (c >= upper && c <= upper + 25) ? (char)(c ^ 0x20) : c;
+            }
+            dest[len] = '\0';
+        } else {
+            memcpy(dest, src, len + 1);
+        }
+    }
+    if (dest_sz) {
+        *dest_sz = len;
+    }
+
+    return UTF8_OK;
+}
+
+enum utf8_result utf8str_upcase_quick(const char *src, char *dest, size_t *dest_sz, unsigned int quick) {
+    return process_utf8str_quick(src, dest, dest_sz, utf8proc_toupper, quick, 'a');
+}
+
+enum utf8_result utf8str_lowcase_quick(const char *src, char *dest, size_t *dest_sz, unsigned int quick) {
+    return process_utf8str_quick(src, dest, dest_sz, utf8proc_tolower, quick, 'A');
+}
+#endif
+
+#if UTF8STR_WITH_CASE && UTF8STR_WITH_NORMALIZATION
+/* Maximum number of code points in a normalization segment and in a
+ * decomposition of a single character for utf8str_fold_key */
+#define FOLD_SEGMENT 32
+#define FOLD_CHAR_MAX 32
+
+/* Returns non-zero if composition never joins cp with the preceding code
+ * points, so everything before cp can be normalized separately */
+static int fold_segment_start(utf8proc_int32_t cp) {
+    const utf8proc_property_t *prop = utf8proc_get_property(cp);
+
+    if (prop->combining_class != 0) {
+        return 0;
+    }
+    /* Hangul vowels and trailing consonants join a preceding syllable */
+    if ((cp >= 0x1161 && cp < 0x1161 + 21) || (cp >= 0x11A7 && cp < 0x11A7 + 28)) {
+        return 0;
+    }
+
+    return prop->comb_index == UINT16_MAX || prop->comb_index < 0x8000;
+}
+
+/* Puts combining marks of a segment in canonical order, composes it if it is
+ * required and appends the result to dst if it fits. used is the key size
+ * before the segment, written - how much of it is in dst. Returns the size of
+ * the segment in bytes */
+static size_t fold_flush(utf8proc_int32_t *seg, utf8proc_ssize_t n, utf8proc_option_t options,
+        utf8proc_uint8_t *dst, size_t cap, size_t used, size_t *written) {
+    utf8proc_ssize_t pos = 0;
+
+    while (pos < n - 1) {
+        utf8proc_propval_t ccc1 = utf8proc_get_property(seg[pos])->combining_class;
+        utf8proc_propval_t ccc2 = utf8proc_get_property(seg[pos + 1])->combining_class;
+        if (ccc1 > ccc2 && ccc2 > 0) {
+            utf8proc_int32_t tmp = seg[pos];
+            seg[pos] = seg[pos + 1];
+            seg[pos + 1] = tmp;
+            if (pos > 0) {
+                pos--;
+            } else {
+                pos++;
+            }
+        } else {
+            pos++;
+        }
+    }
+
+    /* the segment buffer has a spare element, as utf8proc_reencode requires */
+    size_t len = (size_t)utf8proc_reencode(seg, n, options & (UTF8PROC_COMPOSE | UTF8PROC_STABLE));
+    if (dst != NULL && *written == used && used + len < cap) {
+        memcpy(dst + *written, seg, len);
+        *written += len;
+    }
+
+    return len;
+}
+
+size_t utf8str_fold_key(const char *src, size_t len, char *dst, size_t cap, unsigned int flags) {
+    if (src == NULL) {
+        return (size_t)-1;
+    }
+
+    utf8proc_option_t options = UTF8PROC_CASEFOLD;
+    if (flags & (UTF8_FOLD_NFC | UTF8_FOLD_NFKC | UTF8_FOLD_STRIP_MARKS)) {
+        options |= UTF8PROC_COMPOSE | UTF8PROC_STABLE;
+    }
+    if (flags & UTF8_FOLD_NFKC) {
+        options |= UTF8PROC_COMPAT;
+    }
+    if (flags & UTF8_FOLD_STRIP_MARKS) {
+        options |= UTF8PROC_STRIPMARK;
+    }
+
+    /* a character is case folded and decomposed at once, and the result is
+     * collected in a segment until the next code point that cannot compose
+     * with anything before it, so the key is built without any intermediate
+     * string */
+    utf8proc_int32_t seg[FOLD_SEGMENT + 1], chr[FOLD_CHAR_MAX];
+    utf8proc_ssize_t n = 0, cnt, i;
+    utf8proc_int32_t cp;
+    size_t used = 0, written = 0;
+    int boundclass = 0;
+    const utf8proc_uint8_t *usrc = (const utf8proc_uint8_t*)src;
+    const utf8proc_uint8_t *uend = (len != 0) ? usrc + len : NULL;
+    utf8proc_uint8_t *udst = (cap != 0) ? (utf8proc_uint8_t*)dst : NULL;
+
+    while (uend != NULL ? usrc < uend : *usrc != '\0') {
+        cnt = utf8proc_iterate(usrc, uend != NULL ? uend - usrc : -1, &cp);
+        if (cp == -1) {
+            return (size_t)-1;
+        }
+        usrc += cnt;
+
+        cnt = utf8proc_decompose_char(cp, chr, FOLD_CHAR_MAX, options, &boundclass);
+        if (cnt < 0 || cnt > FOLD_CHAR_MAX) {
+            return (size_t)-1;
+        }
+
+        for (i = 0; i < cnt; i++) {
+            if (!(options & UTF8PROC_COMPOSE)) {
+                size_t lendst = cp_length(chr[i]);
+                if (udst != NULL && written == used && used + lendst < cap) {
+                    written += utf8proc_encode_char(chr[i], udst + written);
+                }
+                used += lendst;
+                continue;
+            }
+
+            if (n != 0 && (n == FOLD_SEGMENT || fold_segment_start(chr[i]))) {
+                used += fold_flush(seg, n, options, udst, cap, used, &written);
+                n = 0;
+            }
+            seg[n++] = chr[i];
+        }
+    }
+
+    if (n != 0) {
+        used += fold_flush(seg, n, options, udst, cap, used, &written);
+    }
+    if (udst != NULL) {
+        udst[written] = '\0';
+    }
+
+    return used;
+}
+
+size_t utf8str_fold_key_quick(const char *src, size_t len, char *dst, size_t cap,
+        unsigned int flags, unsigned int quick) {
+    if (src == NULL) {
+        return (size_t)-1;
+    }
+    if (quick == 0) {
+        quick = utf8str_quick_check(src, len);
+    }
+
+    /* compatibility mappings and marks with zero combining class are not in
+     * the flags, so only ASCII is known to have none */
+    int same = !(quick & UTF8_QUICK_CASE_MAP)
+        && (!(flags & UTF8_FOLD_NFC) || (quick & UTF8_QUICK_NFC));
+    if ((quick & UTF8_QUICK_INVALID)
+            || (!(quick & UTF8_QUICK_ASCII) && (!same || (flags & (UTF8_FOLD_NFKC | UTF8_FOLD_STRIP_MARKS))))) {
+        return utf8str_fold_key(src, len, dst, cap, flags);
+    }
+
+    size_t size = (len != 0) ? len : strlen(src);
+    if (dst != NULL && cap != 0) {
+        size_t copied = (size < cap) ? size : 0, i;
+        for (i = 0; i < copied; i++) {
+            char c = src[i];
+            dst[i] = (c >= 'A' && c <= 'Z') ? (char)(c ^ 0x20) : c;
+        }
+        dst[copied] = '\0';
+    }
+
+    return size;
+}
+#endif
+
+#if UTF8STR_WITH_CASE
+enum utf8_result utf8str_equal_no_case(const char *orig, const char *cmp) {
+    return utf8str_nequal_no_case(orig, cmp, 0);
+}
+#endif
+
+/* Block size of the ASCII fast paths(ascii_equal_prefix, quick_ascii_block,
+ * the width and span blocks). 0 - there is no fast block check for the
+ * target. They are shared by the features, so they are defined for all */
+#if defined(__AVX2__)
+#define ASCII_BLOCK 32
+#elif defined(__SSE2__)
+#define ASCII_BLOCK 16
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ASCII_BLOCK 8
+#else
+#define ASCII_BLOCK 0
+#endif
+
+#if ASCII_BLOCK != 0
+/* A block read never crosses a page boundary, so reading past the terminating
+ * zero cannot fault. The bytes after the zero are loaded but never used */
+#define ASCII_PAGE_SIZE 4096
+#define ASCII_BLOCK_SAFE(p) \
+    (((uintptr_t)(p) & (ASCII_PAGE_SIZE - 1)) <= ASCII_PAGE_SIZE - ASCII_BLOCK)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ASCII_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define ASCII_NO_ASAN
+#endif
+
+#if UTF8STR_WITH_CASE
+/* Returns how many first bytes of the blocks are ASCII characters(not zero)
+ * that are equal ignoring case. Only letters A-Z are folded, so '@' and '`'
+ * still differ */
+ASCII_NO_ASAN
+static size_t ascii_equal_prefix(const utf8proc_uint8_t *a, const utf8proc_uint8_t *b) {
+#if defined(__AVX2__)
+    __m256i va = _mm256_loadu_si256((const __m256i*)a);
+    __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+    __m256i before_a = _mm256_set1_epi8('A' - 1);
+    __m256i after_z = _mm256_set1_epi8('Z' + 1);
+    __m256i bit = _mm256_set1_epi8(0x20);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i la = _mm256_or_si256(va, _mm256_and_si256(bit, _mm256_and_si256(
+                    _mm256_cmpgt_epi8(va, before_a), _mm256_cmpgt_epi8(after_z, va))));
+    __m256i lb = _mm256_or_si256(vb, _mm256_and_si256(bit, _mm256_and_si256(
+                    _mm256_cmpgt_epi8(vb, before_a), _mm256_cmpgt_epi8(after_z, vb))));
+    uint32_t good = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(la, lb));
+    uint32_t stop = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(va, vb))
+        | (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, zero))
+        | ~good;
+    return stop == 0 ? ASCII_BLOCK : (size_t)__builtin_ctz(stop);
+#elif defined(__SSE2__)
+    __m128i va = _mm_loadu_si128((const __m128i*)a);
+    __m128i vb = _mm_loadu_si128((const __m128i*)b);
+    __m128i before_a = _mm_set1_epi8('A' - 1);
+    __m128i after_z = _mm_set1_epi8('Z' + 1);
+    __m128i bit = _mm_set1_epi8(0x20);
+    __m128i zero = _mm_setzero_si128();
+    __m128i la = _mm_or_si128(va, _mm_and_si128(bit, _mm_and_si128(
+                    _mm_cmpgt_epi8(va, before_a), _mm_cmpgt_epi8(after_z, va))));
+    __m128i lb = _mm_or_si128(vb, _mm_and_si128(bit, _mm_and_si128(
+                    _mm_cmpgt_epi8(vb, before_a), _mm_cmpgt_epi8(after_z, vb))));
+    unsigned int good = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(la, lb));
+    unsigned int stop = (unsigned int)_mm_movemask_epi8(_mm_or_si128(va, vb))
+        | (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(va, zero))
+        | (~good & 0xFFFF);
+    return stop == 0 ? ASCII_BLOCK : (size_t)__builtin_ctz(stop);
+#else
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    const uint64_t high = 0x8080808080808080ULL;
+    uint64_t wa, wb;
+    memcpy(&wa, a, sizeof(wa));
+    memcpy(&wb, b, sizeof(wb));
+
+    /* sums do not overflow a byte as long as the byte is ASCII, and carries
+     * from non-ASCII bytes go only to the bytes after the first stop */
+    uint64_t ua = ((wa + 0x3F3F3F3F3F3F3F3FULL) & ~(wa + 0x2525252525252525ULL) & high) >> 2;
+    uint64_t ub = ((wb + 0x3F3F3F3F3F3F3F3FULL) & ~(wb + 0x2525252525252525ULL) & high) >> 2;
+    uint64_t diff = (wa | ua) ^ (wb | ub);
+    uint64_t stop = ((wa | wb) & high)
+        | (~(((wa & low7) + low7) | wa) & high)
+        | ((((diff & low7) + low7) | diff) & high);
+    return stop == 0 ? ASCII_BLOCK : (size_t)__builtin_ctzll(stop) / 8;
+#endif
+}
+#endif
+#endif
+
+#if UTF8STR_WITH_CASE
+enum utf8_result utf8str_nequal_no_case(const char *orig, const char *cmp, size_t maxlen) {
+    if (orig == NULL && cmp == NULL) {
+        return UTF8_EQUAL;
+    }
+    if (orig == NULL || cmp == NULL) {
+        return UTF8_NEQUAL;
+    }
+
+    size_t cnt, compared = 0;
+    utf8proc_uint8_t *uorig = (utf8proc_uint8_t*)orig;
+    utf8proc_uint8_t *ucmp = (utf8proc_uint8_t*)cmp;
+    utf8proc_int32_t cporig, cpcmp;
+
+    while (*uorig && *ucmp) {
+        if (*uorig < 0x80 && *ucmp < 0x80) {
+#if ASCII_BLOCK != 0
+            /* skip long runs of equal ASCII characters at once */
+            if ((maxlen == 0 || maxlen - compared >= ASCII_BLOCK)
+                    && ASCII_BLOCK_SAFE(uorig) && ASCII_BLOCK_SAFE(ucmp)) {
+                cnt = ascii_equal_prefix(uorig, ucmp);
+                if (cnt != 0) {
+                    uorig += cnt;
+                    ucmp += cnt;
+                    compared += cnt;
+                    if (compared >= maxlen && maxlen != 0) {
+                        return UTF8_EQUAL;
+                    }
+                    continue;
+                }
+            }
+#endif
+            cporig = (*uorig >= 'a' && *uorig <= 'z') ? *uorig - ('a' - 'A') : *uorig;
+            cpcmp = (*ucmp >= 'a' && *ucmp <= 'z') ? *ucmp - ('a' - 'A') : *ucmp;
+            if (cporig != cpcmp) {
+                return UTF8_NEQUAL;
+            }
+            uorig++;
+            ucmp++;
+            compared++;
+            if (compared >= maxlen && maxlen != 0) {
+                return UTF8_EQUAL;
+            }
+            continue;
+        }
+
+        cnt = utf8proc_iterate(uorig, -1, &cporig);
+        if (cporig == -1) {
+            return UTF8_INVALID_UTF;
+        }
+        uorig += cnt;
+        cporig = utf8proc_toupper(cporig);
+
+        cnt = utf8proc_iterate(ucmp, -1, &cpcmp);
+        if (cpcmp == -1) {
+            return UTF8_INVALID_UTF;
+        }
+        ucmp += cnt;
+        cpcmp = utf8proc_toupper(cpcmp);
+
+        if (cporig != cpcmp) {
+            return UTF8_NEQUAL;
+        }
+
+        compared++;
+        if (compared >= maxlen && maxlen != 0) {
+            return UTF8_EQUAL;
+        }
+    }
+
+    return (*uorig == '\0' && *ucmp == '\0') ? UTF8_EQUAL : UTF8_NEQUAL;
+}
+#endif
+
+/* utf8_quick_flags that a string keeps only if all its characters have
+ * them, the others are set by any character */
+#define QUICK_ALL (UTF8_QUICK_ASCII | UTF8_QUICK_NFC | UTF8_QUICK_NARROW)
+
+#if ASCII_BLOCK != 0
+/* Returns the utf8_quick_flags of a block of ASCII characters(not zero) or 0
+ * if the block has other bytes */
+ASCII_NO_ASAN
+static unsigned int quick_ascii_block(const utf8proc_uint8_t *p) {
+    unsigned int flags = QUICK_ALL;
+#if defined(__AVX2__)
+    __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+    if (_mm256_movemask_epi8(_mm256_or_si256(v, _mm256_cmpeq_epi8(v, _mm256_setzero_si256()))) != 0) {
+        return 0;
+    }
+    int control = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v),
+                _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F))));
+    int letter = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower)));
+#elif defined(__SSE2__)
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    if (_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, _mm_setzero_si128()))) != 0) {
+        return 0;
+    }
+    int control = _mm_movemask_epi8(_mm_or_si128(_mm_cmplt_epi8(v, _mm_set1_epi8(0x20)),
+                _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F))));
+    int letter = _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1))));
+#else
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    const uint64_t high = 0x8080808080808080ULL;
+    uint64_t w, del, lower;
+    memcpy(&w, p, sizeof(w));
+    if ((w & high) || (~(((w & low7) + low7) | w) & high)) {
+        return 0;
+    }
+    /* the bytes are ASCII, so the sums below do not carry to the next byte */
+    del = w ^ low7;
+    lower = w | 0x2020202020202020ULL;
+    uint64_t control = (~(w + 0x6060606060606060ULL) | ~((del + low7) | del)) & high;
+    uint64_t letter = (lower + 0x1F1F1F1F1F1F1F1FULL) & ~(lower + 0x0505050505050505ULL) & high;
+#endif
+    if (control) {
+        flags = (flags & ~UTF8_QUICK_NARROW) | UTF8_QUICK_CONTROL;
+    }
+    if (letter) {
+        flags |= UTF8_QUICK_CASE_MAP;
+    }
+    return flags;
+}
+#endif
+
+unsigned int utf8str_quick_check(const char *str, size_t len) {
+    if (str == NULL) {
+        return 0;
+    }
+
+    /* the flags of QUICK_ALL are collected inverted and the others as is,
+     * so every character only adds bits */
+    unsigned int flags = 0, max_lead = 0, ccc, last_ccc = 0;
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)str;
+    const utf8proc_uint8_t *end = (len == 0) ? NULL : p + len;
+    utf8proc_int32_t cp;
+
+    while (end == NULL || p < end) {
+        if (*p < 0x80) {
+            if (*p == 0 && end == NULL) {
+                break;
+            }
+#if ASCII_BLOCK != 0
+            if (end == NULL ? ASCII_BLOCK_SAFE(p) : (size_t)(end - p) >= ASCII_BLOCK) {
+                unsigned int block = quick_ascii_block(p);
+                if (block != 0) {
+                    flags |= block ^ QUICK_ALL;
+                    last_ccc = 0;
+                    p += ASCII_BLOCK;
+                    continue;
+                }
+            }
+#endif
+            if (*p < 0x20 || *p == 0x7F) {
+                flags |= UTF8_QUICK_CONTROL | UTF8_QUICK_NARROW;
+            } else if ((unsigned int)((*p | 0x20) - 'a') < 26) {
+                flags |= UTF8_QUICK_CASE_MAP;
+            }
+            last_ccc = 0;
+            p++;
+            continue;
+        }
+
+        utf8proc_ssize_t cnt = utf8proc_iterate(p, end == NULL ? -1 : end - p, &cp);
+        if (cp == -1) {
+            flags |= UTF8_QUICK_INVALID | UTF8_QUICK_ASCII;
+            break;
+        }
+        if (*p > max_lead) {
+            max_lead = *p;
+        }
+        int props = utf8proc_quick_props(cp);
+        ccc = (unsigned int)props >> 8;
+        if ((props & UTF8PROC_QUICK_NFC_CHECK) || (ccc != 0 && last_ccc > ccc)) {
+            flags |= UTF8_QUICK_NFC;
+        }
+        if (props & UTF8PROC_QUICK_COMBINING) {
+            flags |= UTF8_QUICK_COMBINING;
+        }
+        if (props & UTF8PROC_QUICK_CASEMAP) {
+            flags |= UTF8_QUICK_CASE_MAP;
+        }
+        if (props & UTF8PROC_QUICK_CONTROL) {
+            flags |= UTF8_QUICK_CONTROL;
+        }
+        if (props & UTF8PROC_QUICK_NOT_NARROW) {
+            flags |= UTF8_QUICK_NARROW;
+        }
+        last_ccc = ccc;
+        p += cnt;
+    }
+
+    if (max_lead != 0) {
+        flags |= UTF8_QUICK_ASCII;
+    }
+    return (flags ^ QUICK_ALL) | UTF8_QUICK_DONE | (max_lead << 8);
+}
+
+enum utf8_result utf8str_starts_with(const char *orig, const char *cmp) {
+    if (orig == NULL && cmp == NULL) {
+        return UTF8_EQUAL;
+    }
+    if (orig == NULL || cmp == NULL) {
+        return UTF8_NEQUAL;
+    }
+
+    size_t cnt = 0;
+    utf8proc_uint8_t *uorig = (utf8proc_uint8_t*)orig;
+    utf8proc_uint8_t *ucmp = (utf8proc_uint8_t*)cmp;
+    utf8proc_int32_t cporig, cpcmp;
+
+    while (*uorig && *ucmp) {
+        cnt = utf8proc_iterate(uorig, -1, &cporig);
+        if (cporig == -1) {
+            return UTF8_INVALID_UTF;
+        }
+        uorig += cnt;
+
+        cnt = utf8proc_iterate(ucmp, -1, &cpcmp);
+        if (cpcmp == -1) {
+            return UTF8_INVALID_UTF;
+        }
+        ucmp += cnt;
+
+        if (cporig != cpcmp) {
+            return UTF8_NEQUAL;
+        }
+    }
+
+    return (*ucmp == '\0') ? UTF8_EQUAL : UTF8_NEQUAL;
+}
+
+enum utf8_result utf8str_ends_with(const char *orig, const char *cmp) {
+    if (orig == NULL && cmp == NULL) {
+        return UTF8_EQUAL;
+    }
+    if (orig == NULL || cmp == NULL) {
+        return UTF8_NEQUAL;
+    }
+
+    size_t cmplen = utf8str_count(cmp);
+    if (cmplen == (size_t)-1) {
+        return UTF8_INVALID_UTF;
+    }
+    const char *ends = utf8str_at_index(orig, -(ssize_t)cmplen);
+    if (ends == NULL) {
+        return UTF8_NEQUAL;
+    }
+
+    return utf8str_starts_with(ends, cmp);
+}
+
+#if UTF8STR_WITH_CASE
+/* Compiled needle for case-insensitive search: uppercase UTF8 bytes and
+ * Horspool skip table over them */
+struct utf8str_needle_t {
+    size_t skip[256];
+    size_t char_count;
+    size_t len;
+    utf8proc_uint8_t folded[];
+};
+
+/* Decodes a character and writes its uppercase form(the same that
+ * utf8str_nequal_no_case compares) to dst. Returns the length of the source
+ * character or 0 if the character is invalid */
+static size_t fold_char_upper(const utf8proc_uint8_t *src, utf8proc_uint8_t *dst, size_t *dst_len) {
+    if (*src < 0x80) {
+        *dst = (*src >= 'a' && *src <= 'z') ? *src - ('a' - 'A') : *src;
+        *dst_len = 1;
+        return 1;
+    }
+
+    utf8proc_int32_t cp;
+    size_t len = utf8proc_iterate(src, -1, &cp);
+    if (cp == -1) {
+        return 0;
+    }
+    *dst_len = utf8proc_encode_char(utf8proc_toupper(cp), dst);
+
+    return len;
+}
+
+struct utf8str_needle_t* utf8str_needle_init(const char *str) {
+    if (str == NULL || *str == '\0') {
+        return NULL;
+    }
+
+    utf8proc_uint8_t buf[4];
+    const utf8proc_uint8_t *usrc = (const utf8proc_uint8_t*)str;
+    size_t len = 0, chars = 0, srclen, dstlen, i;
+
+    while (*usrc) {
+        srclen = fold_char_upper(usrc, buf, &dstlen);
+        if (srclen == 0) {
+            return NULL;
+        }
+        usrc += srclen;
+        len += dstlen;
+        chars++;
+    }
+
+    struct utf8str_needle_t *needle =
+        (struct utf8str_needle_t*)malloc(sizeof(*needle) + len);
+    if (needle == NULL) {
+        return NULL;
+    }
+
+    needle->len = len;
+    needle->char_count = chars;
+    usrc = (const utf8proc_uint8_t*)str;
+    utf8proc_uint8_t *udst = needle->folded;
+    while (*usrc) {
+        usrc += fold_char_upper(usrc, udst, &dstlen);
+        udst += dstlen;
+    }
+
+    for (i = 0; i < 256; i++) {
+        needle->skip[i] = len;
+    }
+    for (i = 0; i + 1 < len; i++) {
+        needle->skip[needle->folded[i]] = len - 1 - i;
+    }
+
+    return needle;
+}
+
+enum utf8_result utf8str_needle_free(struct utf8str_needle_t *needle) {
+    free(needle);
+    return UTF8_OK;
+}
+
+enum utf8_result utf8str_find_no_case(const char *haystack,
+        const struct utf8str_needle_t *needle, struct utf8str_match_t *match) {
+    if (haystack == NULL || needle == NULL || match == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    /* Horspool search over the uppercase haystack that is never stored: the
+     * cursor moves forward converting one character at a time, and a possible
+     * match is verified backwards by converting the characters once more */
+    const utf8proc_uint8_t *start = (const utf8proc_uint8_t*)haystack;
+    const utf8proc_uint8_t *from = start + match->next_byte;
+    const utf8proc_uint8_t *cur = from;
+    const utf8proc_uint8_t *needle_end = needle->folded + needle->len;
+    utf8proc_uint8_t fb[4], tb[4];
+    size_t curlen, fl, tl, pos = needle->len - 1;
+    size_t chars = match->next_char;
+
+    if (*cur == '\0') {
+        return UTF8_NOT_FOUND;
+    }
+    curlen = fold_char_upper(cur, fb, &fl);
+    if (curlen == 0) {
+        return UTF8_INVALID_UTF;
+    }
+
+    while (1) {
+        while (pos >= fl) {
+            pos -= fl;
+            cur += curlen;
+            chars++;
+            if (*cur == '\0') {
+                return UTF8_NOT_FOUND;
+            }
+            curlen = fold_char_upper(cur, fb, &fl);
+            if (curlen == 0) {
+                return UTF8_INVALID_UTF;
+            }
+        }
+
+        utf8proc_uint8_t last = fb[pos];
+        if (last == needle_end[-1]) {
+            /* the needle is valid UTF8, so equal bytes always start and end
+             * at character boundaries */
+            const utf8proc_uint8_t *nptr = needle_end;
+            const utf8proc_uint8_t *first = cur;
+            size_t i = pos + 1;
+
+            while (i > 0 && nptr > needle->folded && fb[i - 1] == nptr[-1]) {
+                i--;
+                nptr--;
+            }
+            if (i == 0) {
+                while (nptr > needle->folded && first > from) {
+                    do {
+                        first--;
+                    } while ((*first & 0xC0) == 0x80);
+
+                    fold_char_upper(first, tb, &tl);
+                    if (tl > (size_t)(nptr - needle->folded)
+                            || memcmp(tb, nptr - tl, tl) != 0) {
+                        break;
+                    }
+                    nptr -= tl;
+                }
+            }
+
+            if (nptr == needle->folded && i == 0) {
+                match->byte_offset = first - start;
+                match->byte_length = cur + curlen - first;
+                match->char_length = needle->char_count;
+                match->char_offset = chars + 1 - needle->char_count;
+                match->next_byte = cur + curlen - start;
+                match->next_char = chars + 1;
+                return UTF8_OK;
+            }
+        }
+
+        pos += needle->skip[last];
+    }
+}
+#endif
+
+/* Returns the class mask of the first character of str or 0 if str is empty
+ * or invalid */
+static unsigned int utf8str_get_class(const char *str) {
+    if (str == NULL || *str == '\0') {
+        return 0;
+    }
+
+    utf8proc_uint8_t *ustr = (utf8proc_uint8_t*)str;
+    utf8proc_int32_t cp = *ustr;
+    if (cp >= 0x80) {
+        utf8proc_iterate(ustr, -1, &cp);
+    }
+
+    return utf8str_class_cp(cp);
+}
+
+int utf8str_isclass(const char *str, unsigned int classes) {
+    return (utf8str_get_class(str) & classes) != 0;
+}
+
+int utf8str_isdigit(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_DIGIT) != 0;
+}
+
+int utf8str_isspace(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_SPACE) != 0;
+}
+
+int utf8str_ispunct(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_PUNCT) != 0;
+}
+
+int utf8str_islower(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_LOWER) != 0;
+}
+
+int utf8str_isupper(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_UPPER) != 0;
+}
+
+int utf8str_iscntrl(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_CNTRL) != 0;
+}
+
+int utf8str_isalpha(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_ALPHA) != 0;
+}
+
+int utf8str_isprint(const char *str) {
+    return (utf8str_get_class(str) & UTF8_CLASS_PRINT) != 0;
+}
+
+/* Block size for ascii_span. 0 - there is no fast block check for the
+ * target. SPAN_SHUFFLE - the block is checked against the set with byte
+ * shuffles, otherwise against the ranges of characters in the set */
+#if defined(__AVX2__)
+#define SPAN_BLOCK 32
+#define SPAN_SHUFFLE 1
+#elif defined(__SSSE3__)
+#define SPAN_BLOCK 16
+#define SPAN_SHUFFLE 1
+#else
+#define SPAN_BLOCK ASCII_BLOCK
+#define SPAN_SHUFFLE 0
+#endif
+
+#if SPAN_BLOCK != 0
+/* A set of ASCII characters for ascii_span: bit N of bits[c & 0x0F] is on if
+ * character with code c and c >> 4 == N is in the set. The layout allows
+ * to check a block of characters with two byte shuffles. Without shuffles
+ * the set is a list of ranges, and sets of more ranges are checked one
+ * character at a time */
+#define SPAN_SET_SIZE 16
+#define SPAN_MAX_RANGES 16
+struct span_set_t {
+    utf8proc_uint8_t bits[SPAN_SET_SIZE];
+#if ! SPAN_SHUFFLE
+    size_t ranges;
+    utf8proc_uint8_t first[SPAN_MAX_RANGES];
+    utf8proc_uint8_t last[SPAN_MAX_RANGES];
+#endif
+};
+/* Spans switch to block checks after so many ASCII characters: most words
+ * are shorter and it is cheaper to check them one by one than to prepare
+ * the set. Ranges take longer to prepare than shuffle tables */
+#if SPAN_SHUFFLE
+#define SPAN_MIN_RUN 8
+#else
+#define SPAN_MIN_RUN 16
+#endif
+
+/* the same guard as ASCII_BLOCK_SAFE: SPAN_BLOCK is never defined without
+ * ASCII_BLOCK */
+#define SPAN_BLOCK_SAFE(p) \
+    (((uintptr_t)(p) & (ASCII_PAGE_SIZE - 1)) <= ASCII_PAGE_SIZE - SPAN_BLOCK)
+
+/* Fills set with ASCII characters that belong to any of classes or, if
+ * complement is not zero, to none of them. Returns 0 if the set cannot be
+ * checked in blocks */
+static int span_set(struct span_set_t *set, unsigned int classes, int complement, int nul_terminated) {
+    size_t nclasses = sizeof(utf8str_class_ascii) / sizeof(utf8str_class_ascii[0]);
+    size_t b, i;
+    memset(set->bits, 0, SPAN_SET_SIZE);
+    for (b = 0; b < nclasses; b++) {
+        if (classes & (1u << b)) {
+            for (i = 0; i < SPAN_SET_SIZE; i++) {
+                set->bits[i] |= utf8str_class_ascii[b][i];
+            }
+        }
+    }
+    if (complement) {
+        for (i = 0; i < SPAN_SET_SIZE; i++) {
+            set->bits[i] = (utf8proc_uint8_t)~set->bits[i];
+        }
+    }
+    /* the terminating zero always stops a span */
+    if (nul_terminated) {
+        set->bits[0] &= 0xFE;
+    }
+
+#if ! SPAN_SHUFFLE
+    /* chars[h] has bit n on if character 64 * h + n is in the set: bit b of
+     * each byte of the set is gathered into the row of 16 characters b * 16.
+     * A range starts at a character that follows one not in the set and ends
+     * at a character followed by one not in the set */
+    const uint64_t ones = 0x0101010101010101ULL;
+    uint64_t half[2], chars[2] = {0, 0}, starts[2], ends[2];
+    memcpy(half, set->bits, sizeof(half));
+    for (b = 0; b < 8; b++) {
+        for (i = 0; i < 2; i++) {
+            uint64_t row = (((half[i] >> b) & ones) * 0x0102040810204080ULL) >> 56;
+            chars[b / 4] |= row << (b % 4 * 16 + i * 8);
+        }
+    }
+    starts[0] = chars[0] & ~(chars[0] << 1);
+    starts[1] = chars[1] & ~((chars[1] << 1) | (chars[0] >> 63));
+    ends[0] = chars[0] & ~((chars[0] >> 1) | (chars[1] << 63));
+    ends[1] = chars[1] & ~(chars[1] >> 1);
+
+    size_t n = 0;
+    set->ranges = 0;
+    for (i = 0; i < 2; i++) {
+        for (; starts[i] != 0; starts[i] &= starts[i] - 1) {
+            if (set->ranges == SPAN_MAX_RANGES) {
+                return 0;
+            }
+            set->first[set->ranges++] = (utf8proc_uint8_t)(64 * i + (size_t)__builtin_ctzll(starts[i]));
+        }
+        for (; ends[i] != 0; ends[i] &= ends[i] - 1) {
+            set->last[n++] = (utf8proc_uint8_t)(64 * i + (size_t)__builtin_ctzll(ends[i]));
+        }
+    }
+#endif
+    return 1;
+}
+
+/* Returns how many first bytes of the block are ASCII characters from set */
+ASCII_NO_ASAN
+static size_t ascii_span(const utf8proc_uint8_t *p, const struct span_set_t *set) {
+#if defined(__AVX2__)
+    __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    __m256i tbl = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->bits));
+    /* non-ASCII bytes have high nibble 8-15 that selects zero bit */
+    __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+            1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i row = _mm256_shuffle_epi8(tbl, _mm256_and_si256(v, low_nibble));
+    __m256i col = _mm256_shuffle_epi8(bits, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibble));
+    uint32_t stop = (uint32_t)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_and_si256(row, col), _mm256_setzero_si256()));
+    return stop == 0 ? SPAN_BLOCK : (size_t)__builtin_ctz(stop);
+#elif defined(__SSSE3__)
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i low_nibble = _mm_set1_epi8(0x0F);
+    __m128i tbl = _mm_loadu_si128((const __m128i*)set->bits);
+    /* non-ASCII bytes have high nibble 8-15 that selects zero bit */
+    __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i row = _mm_shuffle_epi8(tbl, _mm_and_si128(v, low_nibble));
+    __m128i col = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble));
+    unsigned int stop = (unsigned int)_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_and_si128(row, col), _mm_setzero_si128()));
+    return stop == 0 ? SPAN_BLOCK : (size_t)__builtin_ctz(stop);
+#elif defined(__SSE2__)
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    __m128i in = _mm_setzero_si128();
+    size_t i;
+    /* non-ASCII bytes compare as negative, below every range */
+    for (i = 0; i < set->ranges; i++) {
+        __m128i from = _mm_cmpgt_epi8(v, _mm_set1_epi8((char)(set->first[i] - 1)));
+        __m128i past = _mm_cmpgt_epi8(v, _mm_set1_epi8((char)set->last[i]));
+        in = _mm_or_si128(in, _mm_andnot_si128(past, from));
+    }
+    unsigned int stop = ~(unsigned int)_mm_movemask_epi8(in) & 0xFFFF;
+    return stop == 0 ? SPAN_BLOCK : (size_t)__builtin_ctz(stop);
+#else
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t high = 0x8080808080808080ULL;
+    uint64_t w, in = 0;
+    size_t i;
+    memcpy(&w, p, sizeof(w));
+
+    /* the high bit of a byte of low + 0x80 - first is on if the byte is not
+     * below first, of low + 0x7F - last if it is past last. The sums do not
+     * overflow a byte, and non-ASCII bytes are left out at the end */
+    uint64_t low = w & ~high;
+    for (i = 0; i < set->ranges; i++) {
+        in |= (low + ones * (0x80u - set->first[i])) & ~(low + ones * (0x7Fu - set->last[i]));
+    }
+    uint64_t stop = ~(in & ~w) & high;
+    return stop == 0 ? SPAN_BLOCK : (size_t)__builtin_ctzll(stop) / 8;
+#endif
+}
+#endif
+
+/* Common part of utf8str_span_class and utf8str_cspan_class: skips characters
+ * while their membership in classes is not equal to complement */
+static size_t span_class(const char *str, size_t len, unsigned int classes, int complement, size_t *char_count) {
+    size_t chars = 0;
+    if (str == NULL) {
+        if (char_count != NULL) {
+            *char_count = 0;
+        }
+        return 0;
+    }
+
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)str;
+    const utf8proc_uint8_t *end = (len == 0) ? NULL : p + len;
+    utf8proc_int32_t cp;
+#if SPAN_BLOCK != 0
+    struct span_set_t set;
+    size_t ascii_run = 0;
+    /* 0 - the set is not made yet, -1 - it cannot be checked in blocks */
+    int have_set = 0;
+#endif
+
+    while (end == NULL || p < end) {
+        if (*p < 0x80) {
+            if (*p == 0 && end == NULL) {
+                break;
+            }
+            if (((utf8str_class_cp(*p) & classes) != 0) == complement) {
+                break;
+            }
+            p++;
+            chars++;
+#if SPAN_BLOCK != 0
+            ascii_run++;
+            if (have_set >= 0 && ascii_run >= SPAN_MIN_RUN
+                    && (end == NULL ? SPAN_BLOCK_SAFE(p) : (size_t)(end - p) >= SPAN_BLOCK)) {
+                if (have_set == 0) {
+                    have_set = span_set(&set, classes, complement, end == NULL) ? 1 : -1;
+                }
+                if (have_set == 1) {
+                    size_t cnt = ascii_span(p, &set);
+                    p += cnt;
+                    chars += cnt;
+                }
+            }
+#endif
+            continue;
+        }
+
+        utf8proc_ssize_t cnt = utf8proc_iterate(p, end == NULL ? -1 : end - p, &cp);
+        if (cp == -1 || ((utf8str_class_cp(cp) & classes) != 0) == complement) {
+            break;
+        }
+        p += cnt;
+        chars++;
+    }
+
+    if (char_count != NULL) {
+        *char_count = chars;
+    }
+    return (size_t)(p - (const utf8proc_uint8_t*)str);
+}
+
+size_t utf8str_span_class(const char *str, size_t len, unsigned int classes, size_t *char_count) {
+    return span_class(str, len, classes, 0, char_count);
+}
+
+size_t utf8str_cspan_class(const char *str, size_t len, unsigned int classes, size_t *char_count) {
+    return span_class(str, len, classes, 1, char_count);
+}
+
+#if UTF8STR_WITH_SCRIPT
+/* Letters of Latin-1 Supplement and Latin Extended-A and B: Latin without
+ * script extensions, so Latin text needs no table lookup */
+#define SCRIPT_LATIN_FAST(cp) \
+    ((cp) >= 0xC0 && (cp) < 0x250 && (cp) != 0xD7 && (cp) != 0xF7)
+
+/* Returns non-zero if the character of script sc continues a run of script
+ * run. The first character of a real script decides the script of the run */
+static int script_run_continues(utf8proc_int32_t cp, utf8proc_script_t sc, utf8proc_script_t *run) {
+    if (sc == *run) {
+        return 1;
+    }
+    if (sc == UTF8PROC_SCRIPT_COMMON || sc == UTF8PROC_SCRIPT_INHERITED) {
+        /* a character without extensions has only its own script */
+        return *run == UTF8PROC_SCRIPT_COMMON || utf8proc_has_script(cp, sc)
+            || utf8proc_has_script(cp, *run);
+    }
+    if (*run == UTF8PROC_SCRIPT_COMMON) {
+        *run = sc;
+        return 1;
+    }
+    return utf8proc_has_script(cp, *run);
+}
+
+size_t utf8str_script_run_next(const char *str, size_t len, int *script, size_t *char_count) {
+    utf8proc_script_t run = UTF8PROC_SCRIPT_COMMON;
+    size_t chars = 0;
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)str;
+
+    if (str != NULL) {
+        const utf8proc_uint8_t *end = (len == 0) ? NULL : p + len;
+        utf8proc_int32_t cp;
+
+        while (end == NULL || p < end) {
+            /* ASCII letters are Latin, the rest of ASCII is Common without
+             * extensions */
+            if (*p < 0x80) {
+                if (*p == 0 && end == NULL) {
+                    break;
+                }
+                if ((unsigned int)((*p | 0x20) - 'a') < 26) {
+                    if (run == UTF8PROC_SCRIPT_COMMON) {
+                        run = UTF8PROC_SCRIPT_LATIN;
+                    } else if (run != UTF8PROC_SCRIPT_LATIN) {
+                        break;
+                    }
+                }
+                p++;
+                chars++;
+                continue;
+            }
+
+            utf8proc_ssize_t cnt = utf8proc_iterate(p, end == NULL ? -1 : end - p, &cp);
+            if (cp == -1) {
+                break;
+            }
+            utf8proc_script_t sc = SCRIPT_LATIN_FAST(cp) ? UTF8PROC_SCRIPT_LATIN : utf8proc_script(cp);
+            if (! script_run_continues(cp, sc, &run)) {
+                break;
+            }
+            p += cnt;
+            chars++;
+        }
+    }
+
+    if (script != NULL) {
+        *script = (int)run;
+    }
+    if (char_count != NULL) {
+        *char_count = chars;
+    }
+    return (size_t)(p - (const utf8proc_uint8_t*)str);
+}
+#endif
+
+#define EMOJI_ZWJ 0x200D
+#define EMOJI_KEYCAP 0x20E3
+#define EMOJI_TEXT_STYLE 0xFE0E
+#define EMOJI_STYLE 0xFE0F
+#define EMOJI_RI_FIRST 0x1F1E6
+#define EMOJI_RI_LAST 0x1F1FF
+#define EMOJI_TAG_FIRST 0xE0020
+#define EMOJI_TAG_LAST 0xE007E
+#define EMOJI_CANCEL_TAG 0xE007F
+
+/* Non-zero if the two bytes at p may start an emoji, see utf8str_emoji_prefix */
+#define EMOJI_PREFIX(p) ((utf8str_emoji_prefix[(p)[0] & 0x3F] >> ((p)[1] & 0x3F)) & 1)
+#define EMOJI_KEYCAP_BASE(c) (((c) >= '0' && (c) <= '9') || (c) == '#' || (c) == '*')
+
+/* Decodes the character at p, returns -1 at the end of the string or at an
+ * invalid UTF8 sequence */
+static utf8proc_int32_t emoji_peek(const utf8proc_uint8_t *p, const utf8proc_uint8_t *end,
+        utf8proc_ssize_t *cnt) {
+    utf8proc_int32_t cp = -1;
+    if (end != NULL && p >= end) {
+        *cnt = 0;
+        return -1;
+    }
+    *cnt = utf8proc_iterate(p, end == NULL ? -1 : end - p, &cp);
+    return cp;
+}
+
+/* Reads an emoji with its variation selector or skin tone modifier at p.
+ * Returns the byte length, 0 if p is not an emoji. Sets presented if the
+ * emoji is shown as emoji by itself */
+static size_t emoji_element(const utf8proc_uint8_t *p, const utf8proc_uint8_t *end,
+        size_t *chars, enum utf8_emoji_kind *kind, int *presented) {
+    utf8proc_ssize_t cnt, next_cnt;
+    utf8proc_int32_t cp = emoji_peek(p, end, &cnt);
+    int flags = (cp < 0x80) ? 0 : utf8proc_emoji(cp);
+
+    if (! (flags & (UTF8PROC_EMOJI | UTF8PROC_EXTENDED_PICTOGRAPHIC))) {
+        return 0;
+    }
+    *chars = 1;
+    *kind = UTF8_EMOJI_CHAR;
+    *presented = (flags & UTF8PROC_EMOJI_PRESENTATION) != 0;
+
+    utf8proc_int32_t next = emoji_peek(p + cnt, end, &next_cnt);
+    if (next == EMOJI_STYLE || next == EMOJI_TEXT_STYLE) {
+        *presented = next == EMOJI_STYLE;
+        (*chars)++;
+        cnt += next_cnt;
+    } else if ((flags & UTF8PROC_EMOJI_MODIFIER_BASE) && next != -1
+            && (utf8proc_emoji(next) & UTF8PROC_EMOJI_MODIFIER)) {
+        *kind = UTF8_EMOJI_MODIFIER;
+        *presented = 1;
+        (*chars)++;
+        cnt += next_cnt;
+    }
+    return (size_t)cnt;
+}
+
+/* Reads the emoji sequence at p. Returns its byte length, 0 if there is none */
+static size_t emoji_sequence(const utf8proc_uint8_t *p, const utf8proc_uint8_t *end,
+        size_t *chars, enum utf8_emoji_kind *kind) {
+    utf8proc_ssize_t cnt, next_cnt;
+    utf8proc_int32_t cp = emoji_peek(p, end, &cnt);
+    utf8proc_int32_t next = emoji_peek(p + cnt, end, &next_cnt);
+    size_t len;
+    int presented = 0;
+
+    if (EMOJI_KEYCAP_BASE(cp)) {
+        len = 1;
+        *chars = 1;
+        if (next == EMOJI_STYLE) {
+            len += next_cnt;
+            (*chars)++;
+            next = emoji_peek(p + len, end, &next_cnt);
+        }
+        if (next != EMOJI_KEYCAP) {
+            return 0;
+        }
+        *kind = UTF8_EMOJI_KEYCAP;
+        (*chars)++;
+        return len + next_cnt;
+    }
+    if (cp >= EMOJI_RI_FIRST && cp <= EMOJI_RI_LAST && next >= EMOJI_RI_FIRST && next <= EMOJI_RI_LAST) {
+        *kind = UTF8_EMOJI_FLAG;
+        *chars = 2;
+        return (size_t)(cnt + next_cnt);
+    }
+
+    len = emoji_element(p, end, chars, kind, &presented);
+    if (len == 0) {
+        return 0;
+    }
+
+    /* a tag sequence ends with CANCEL TAG, otherwise the tags are not part
+     * of the emoji */
+    if (*kind == UTF8_EMOJI_CHAR) {
+        size_t tag_len = len, tag_chars = *chars;
+        next = emoji_peek(p + tag_len, end, &next_cnt);
+        while (next >= EMOJI_TAG_FIRST && next <= EMOJI_TAG_LAST) {
+            tag_len += next_cnt;
+            tag_chars++;
+            next = emoji_peek(p + tag_len, end, &next_cnt);
+        }
+        if (next == EMOJI_CANCEL_TAG && tag_chars > *chars) {
+            *kind = UTF8_EMOJI_TAG;
+            *chars = tag_chars + 1;
+            return tag_len + next_cnt;
+        }
+    }
+
+    for (;;) {
+        size_t element_chars;
+        enum utf8_emoji_kind element_kind;
+        int element_presented;
+        if (emoji_peek(p + len, end, &next_cnt) != EMOJI_ZWJ) {
+            break;
+        }
+        size_t element_len = emoji_element(p + len + next_cnt, end, &element_chars,
+                &element_kind, &element_presented);
+        if (element_len == 0) {
+            break;
+        }
+        len += next_cnt + element_len;
+        *chars += element_chars + 1;
+        *kind = UTF8_EMOJI_ZWJ;
+        presented = 1;
+    }
+
+    return presented ? len : 0;
+}
+
+enum utf8_result utf8str_emoji_next(const char *str, size_t len, struct utf8str_emoji_t *emoji) {
+    if (str == NULL || emoji == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    const utf8proc_uint8_t *start = (const utf8proc_uint8_t*)str;
+    const utf8proc_uint8_t *end = (len == 0) ? NULL : start + len;
+    const utf8proc_uint8_t *p = start + emoji->next_byte;
+    if (end != NULL && p >= end) {
+        return UTF8_NOT_FOUND;
+    }
+
+    while (end == NULL || p < end) {
+        /* skip the bytes that cannot start an emoji: ASCII except keycap
+         * bases, continuation bytes and the characters of other prefixes */
+        if (*p < 0xC0) {
+            if (*p == 0 && end == NULL) {
+                break;
+            }
+            if (! EMOJI_KEYCAP_BASE(*p)) {
+                p++;
+                continue;
+            }
+        } else if ((end != NULL && end - p < 2) || ! EMOJI_PREFIX(p)) {
+            p++;
+            continue;
+        }
+
+        utf8proc_ssize_t cnt;
+        if (emoji_peek(p, end, &cnt) == -1) {
+            return UTF8_INVALID_UTF;
+        }
+        size_t chars;
+        enum utf8_emoji_kind kind;
+        size_t seq_len = emoji_sequence(p, end, &chars, &kind);
+        if (seq_len != 0) {
+            emoji->byte_offset = (size_t)(p - start);
+            emoji->byte_length = seq_len;
+            emoji->char_length = chars;
+            emoji->kind = kind;
+            emoji->next_byte = emoji->byte_offset + seq_len;
+            return UTF8_OK;
+        }
+        p += cnt;
+    }
+
+    return UTF8_NOT_FOUND;
+}
+
+#if UTF8STR_WITH_WIDTH
+size_t utf8str_width(const char *str, size_t len) {
+    if (str == NULL || *str == '\0') {
+        return 0;
+    }
+
+    size_t width = 0;
+    size_t cnt = 0, sz;
+    utf8proc_uint8_t *ustr = (utf8proc_uint8_t*)str;
+    utf8proc_int32_t cp;
+    while (*ustr) {
+        sz = utf8proc_iterate(ustr, -1, &cp);
+
+        if (cp == -1) {
+            return (size_t)-1;
+        }
+
+        width += utf8proc_charwidth(cp);
+        ustr += sz;
+        cnt++;
+
+        if (len > 0 && cnt == len) {
+            return width;
+        }
+    }
+
+    return width;
+}
+
+size_t utf8str_width_quick(const char *str, size_t len, unsigned int quick) {
+    if (str == NULL || *str == '\0') {
+        return 0;
+    }
+    if (quick == 0) {
+        quick = utf8str_quick_check(str, 0);
+    }
+    if ((quick & UTF8_QUICK_INVALID) || !(quick & UTF8_QUICK_NARROW)) {
+        return utf8str_width(str, len);
+    }
+
+    /* every character is one column: count the bytes that start them */
+    size_t width = 0;
+    const utf8proc_uint8_t *ustr = (const utf8proc_uint8_t*)str;
+    if (quick & UTF8_QUICK_ASCII) {
+        width = strlen(str);
+    } else {
+        for (; *ustr; ustr++) {
+            width += (*ustr & 0xC0) != 0x80;
+        }
+    }
+
+    return (len > 0 && len < width) ? len : width;
+}
+
+#if UTF8STR_WITH_GRAPHEME
+#define WIDTH_END(p, end) ((end) == NULL ? *(p) == 0 : (p) >= (end))
+#define WIDTH_PRINTABLE(c) ((c) >= 0x20 && (c) < 0x7F)
+/* fields of utf8proc_width_props */
+#define WIDTH_AMBIGUOUS 4
+#define WIDTH_EMOJI(props) (((props) >> 3) & 0x1F)
+#define WIDTH_BOUNDCLASS(props) ((props) >> 8)
+/* Slot of utf8str_width_cache_t for a cluster starting with cp and next */
+#define WIDTH_CACHE_SLOT(cp, next) \
+    (((((utf8proc_uint32_t)(cp) * 0x9E3779B1u) ^ (utf8proc_uint32_t)(next)) * 0x9E3779B1u >> 16) \
+        & (UTF8STR_WIDTH_CACHE_SIZE - 1))
+
+/* The width of a character by the utf8_width_flags rules */
+static int width_char(int props, unsigned int flags) {
+    int width = props & 3;
+    if (width == 1 && (props & WIDTH_AMBIGUOUS) && (flags & UTF8_WIDTH_AMBIGUOUS_WIDE)) {
+        return 2;
+    }
+    return width;
+}
+
+/* Measures the grapheme clusters from p up to the next one that starts with
+ * printable ASCII, or only the first one if single is set, and adds their
+ * widths to width. Returns the byte length, 0 at an invalid UTF8 sequence.
+ * Every character is decoded and looked up once. Clusters of several
+ * characters are looked up in cache first and kept there: the kept bytes are
+ * the cluster if the character after them breaks with the grapheme break
+ * state saved with them */
+static size_t width_run(const utf8proc_uint8_t *p, const utf8proc_uint8_t *end,
+        unsigned int flags, struct utf8str_width_cache_t *cache, int single, size_t *width) {
+    const utf8proc_uint8_t *start = p;
+    utf8proc_ssize_t cnt, next_cnt;
+    utf8proc_int32_t cp = emoji_peek(p, end, &cnt), next;
+    if (cp == -1) {
+        return 0;
+    }
+    int props = utf8proc_width_props(cp), next_props = 0;
+    /* the grapheme break state at cp. The start state reads the class of cp,
+     * but a ZWJ after the printable ASCII character before the run joins no
+     * emoji, which its state after such a character tells */
+    utf8proc_int32_t state = UTF8PROC_BOUNDCLASS_START;
+    if (WIDTH_BOUNDCLASS(props) == UTF8PROC_BOUNDCLASS_ZWJ) {
+        utf8proc_grapheme_break_boundclass(UTF8PROC_BOUNDCLASS_OTHER, UTF8PROC_BOUNDCLASS_ZWJ, &state);
+    }
+
+    for (;;) {
+        /* p and cp start a cluster */
+        int cluster = width_char(props, flags);
+        size_t length = (size_t)cnt;
+        int joined = 0;
+        next = -1;
+        if (!WIDTH_END(p + length, end)) {
+            next = emoji_peek(p + length, end, &next_cnt);
+            if (next == -1) {
+                return 0;
+            }
+            next_props = utf8proc_width_props(next);
+            /* most characters are Other, which only a Prepend one joins */
+            if (WIDTH_BOUNDCLASS(next_props) != UTF8PROC_BOUNDCLASS_OTHER
+                    || WIDTH_BOUNDCLASS(props) == UTF8PROC_BOUNDCLASS_PREPEND) {
+                joined = !utf8proc_grapheme_break_boundclass(WIDTH_BOUNDCLASS(props),
+                        WIDTH_BOUNDCLASS(next_props), &state);
+            } else {
+                state = UTF8PROC_BOUNDCLASS_OTHER;
+            }
+        }
+
+        struct utf8str_width_slot_t *slot = NULL;
+        if (joined && cache != NULL) {
+            slot = &cache->slots[WIDTH_CACHE_SLOT(cp, next)];
+            size_t kept = slot->length;
+            size_t same = 0;
+            if (kept != 0 && slot->flags == (unsigned char)flags
+                    && (end == NULL || (size_t)(end - p) >= kept)) {
+                /* the kept bytes have no zero, so the terminating one differs */
+                while (same < kept && p[same] == (utf8proc_uint8_t)slot->bytes[same]) {
+                    same++;
+                }
+            }
+            if (kept != 0 && same == kept) {
+                utf8proc_int32_t after = -1, after_state = slot->state;
+                utf8proc_ssize_t after_cnt = 0;
+                int after_props = 0;
+                if (!WIDTH_END(p + kept, end)) {
+                    after = emoji_peek(p + kept, end, &after_cnt);
+                    after_props = (after == -1) ? 0 : utf8proc_width_props(after);
+                }
+                if (after == -1 ? WIDTH_END(p + kept, end)
+                        : utf8proc_grapheme_break_boundclass(slot->state,
+                            WIDTH_BOUNDCLASS(after_props), &after_state)) {
+                    cluster = slot->width;
+                    length = kept;
+                    state = after_state;
+                    joined = 0;
+                    slot = NULL;
+                    next = after;
+                    next_cnt = after_cnt;
+                    next_props = after_props;
+                }
+            }
+        }
+
+        if (joined) {
+            utf8proc_int32_t first = cp, last = cp;
+            int last_props = props;
+            int widest = cluster, sum = cluster, sequence = 0;
+            utf8proc_int32_t kept_state = state;
+            while (joined) {
+                int emoji = WIDTH_EMOJI(next_props);
+                int w = width_char(next_props, flags);
+                sum += w;
+                if (w > widest) {
+                    widest = w;
+                }
+                /* an emoji presentation or a joined emoji sequence, see
+                 * utf8str_emoji_next */
+                if ((next == EMOJI_STYLE && (WIDTH_EMOJI(last_props) & UTF8PROC_EMOJI))
+                        || (next == EMOJI_KEYCAP && EMOJI_KEYCAP_BASE(first))
+                        || ((emoji & UTF8PROC_EMOJI_MODIFIER)
+                            && (WIDTH_EMOJI(last_props) & UTF8PROC_EMOJI_MODIFIER_BASE))
+                        || ((emoji & UTF8PROC_EXTENDED_PICTOGRAPHIC) && last == EMOJI_ZWJ)
+                        || (first >= EMOJI_RI_FIRST && first <= EMOJI_RI_LAST
+                            && next >= EMOJI_RI_FIRST && next <= EMOJI_RI_LAST)) {
+                    sequence = 1;
+                }
+                length += (size_t)next_cnt;
+                last = next;
+                last_props = next_props;
+
+                next = -1;
+                kept_state = state;
+                if (WIDTH_END(p + length, end)) {
+                    break;
+                }
+                next = emoji_peek(p + length, end, &next_cnt);
+                if (next == -1) {
+                    return 0;
+                }
+                next_props = utf8proc_width_props(next);
+                joined = !utf8proc_grapheme_break_boundclass(WIDTH_BOUNDCLASS(last_props),
+                        WIDTH_BOUNDCLASS(next_props), &state);
+            }
+
+            if (!sequence) {
+                cluster = widest;
+            } else {
+                cluster = (flags & UTF8_WIDTH_EMOJI_TEXT) ? sum : 2;
+            }
+            if (slot != NULL && length <= UTF8STR_WIDTH_CACHE_BYTES) {
+                slot->length = (unsigned char)length;
+                slot->width = (unsigned char)cluster;
+                slot->flags = (unsigned char)flags;
+                slot->state = (unsigned char)kept_state;
+                memcpy(slot->bytes, p, length);
+            }
+        }
+
+        *width += (size_t)cluster;
+        p += length;
+        if (single || next == -1 || WIDTH_PRINTABLE(*p)) {
+            return (size_t)(p - start);
+        }
+        cp = next;
+        cnt = next_cnt;
+        props = next_props;
+    }
+}
+
+size_t utf8str_width_ex(const char *str, size_t len, unsigned int flags,
+        struct utf8str_width_cache_t *cache) {
+    if (str == NULL) {
+        return 0;
+    }
+
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)str;
+    const utf8proc_uint8_t *end = (len == 0) ? NULL : p + len;
+    size_t width = 0;
+    while (!WIDTH_END(p, end)) {
+        if (WIDTH_PRINTABLE(*p)) {
+            /* printable ASCII before another ASCII byte is a cluster alone */
+            size_t left = (size_t)-1;
+#if ASCII_BLOCK != 0
+            /* the last byte of the block is left for the check below: a mark
+             * or a variation selector may follow it */
+            if ((end == NULL ? ASCII_BLOCK_SAFE(p) : (size_t)(end - p) >= ASCII_BLOCK)
+                    && (quick_ascii_block(p) & UTF8_QUICK_NARROW)) {
+                width += ASCII_BLOCK - 1;
+                p += ASCII_BLOCK - 1;
+                continue;
+            }
+            /* other bytes are in the block, try the next one after it */
+            left = ASCII_BLOCK;
+#endif
+            const utf8proc_uint8_t *from = p;
+            while (left-- > 0 && p != end && WIDTH_PRINTABLE(*p) && (p + 1 == end || p[1] < 0x80)) {
+                width++;
+                p++;
+            }
+            if (p != from) {
+                continue;
+            }
+        }
+
+        size_t cnt = width_run(p, end, flags, cache, 0, &width);
+        if (cnt == 0) {
+            return (size_t)-1;
+        }
+        p += cnt;
+    }
+
+    return width;
+}
+
+/* Measures the grapheme cluster at p, which is not the end of the string, as
+ * utf8str_width_ex does. Returns the byte length, 0 at an invalid UTF8
+ * sequence. The start state of width_run gives the same breaks as the state
+ * after the cluster before p */
+static size_t width_next(const utf8proc_uint8_t *p, const utf8proc_uint8_t *end,
+        unsigned int flags, size_t *width) {
+    if (WIDTH_PRINTABLE(*p) && (p + 1 == end || p[1] < 0x80)) {
+        *width = 1;
+        return 1;
+    }
+    *width = 0;
+    return width_run(p, end, flags, NULL, 1, width);
+}
+
+enum utf8_result utf8str_truncate_width(const char *str, size_t len, size_t max_cols,
+        const char *ellipsis, enum utf8_elide_mode mode, unsigned int flags,
+        struct utf8str_truncate_t *cut) {
+    if (str == NULL || cut == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    size_t ellipsis_width = (ellipsis == NULL) ? 0 : utf8str_width_ex(ellipsis, 0, flags, NULL);
+    if (ellipsis_width == (size_t)-1) {
+        return UTF8_INVALID_UTF;
+    }
+    int with_ellipsis = (ellipsis != NULL && *ellipsis != '\0');
+    if (ellipsis_width > max_cols) {
+        ellipsis_width = 0;
+        with_ellipsis = 0;
+    }
+    size_t avail = max_cols - ellipsis_width;
+    size_t head_max = (mode == UTF8_ELIDE_END) ? avail
+        : (mode == UTF8_ELIDE_MIDDLE) ? avail - avail / 2 : 0;
+
+    const utf8proc_uint8_t *start = (const utf8proc_uint8_t*)str;
+    const utf8proc_uint8_t *end = (len == 0) ? NULL : start + len;
+    /* p measures the whole string. The head grows while its clusters fit,
+     * then the tail is the clusters from tail to p and drops its first ones
+     * while it is wider than the columns the head leaves */
+    const utf8proc_uint8_t *p = start, *head_end = start, *tail = start;
+    size_t total = 0, head_width = 0, tail_width = 0;
+    int head_open = (mode != UTF8_ELIDE_START);
+    while (!WIDTH_END(p, end)) {
+        size_t w;
+        size_t cnt = width_next(p, end, flags, &w);
+        if (cnt == 0) {
+            return UTF8_INVALID_UTF;
+        }
+        total += w;
+        if (head_open) {
+            if (head_width + w <= head_max) {
+                head_width += w;
+                p += cnt;
+                head_end = p;
+                continue;
+            }
+            head_open = 0;
+            tail = p;
+        }
+        p += cnt;
+
+        if (mode == UTF8_ELIDE_END) {
+            if (total > max_cols) {
+                break;
+            }
+            continue;
+        }
+        tail_width += w;
+        while (tail_width > avail - head_width) {
+            /* the bytes were checked before */
+            tail += width_next(tail, end, flags, &w);
+            tail_width -= w;
+        }
+    }
+
+    if (total <= max_cols) {
+        cut->head_end = cut->tail_start = (size_t)(p - start);
+        cut->width = total;
+        cut->ellipsis = 0;
+        return UTF8_OK;
+    }
+
+    cut->head_end = (size_t)(head_end - start);
+    if (mode == UTF8_ELIDE_END) {
+        cut->tail_start = (end == NULL) ? (size_t)(p - start) + strlen((const char*)p) : len;
+    } else {
+        cut->tail_start = (size_t)(tail - start);
+    }
+    cut->width = head_width + ellipsis_width + tail_width;
+    cut->ellipsis = with_ellipsis;
+    return UTF8_OK;
+}
+
+/* Size in bytes of the copies of the fill, which is fill_width columns
+ * wide, in cols columns of it: the fill is repeated from its start and the
+ * clusters of its last copy that do not fit are left out. rest gets the
+ * columns they leave for spaces */
+static size_t pad_repeat_size(const char *fill, size_t fill_sz, size_t fill_width,
+        size_t cols, unsigned int flags, size_t *rest) {
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)fill;
+    size_t w;
+    *rest = cols % fill_width;
+    while (*rest > 0) {
+        /* the fill was checked before */
+        size_t cnt = width_next(p, NULL, flags, &w);
+        if (w > *rest) {
+            break;
+        }
+        *rest -= w;
+        p += cnt;
+    }
+    return cols / fill_width * fill_sz + (size_t)(p - (const utf8proc_uint8_t*)fill);
+}
+
+/* Writes cols columns of the fill to dest and returns their size in bytes,
+ * only the size if dest is NULL */
+static size_t pad_fill(char *dest, const char *fill, size_t fill_sz, size_t fill_width,
+        size_t cols, unsigned int flags) {
+    size_t rest;
+    size_t size = pad_repeat_size(fill, fill_sz, fill_width, cols, flags, &rest);
+    if (dest != NULL) {
+        fill_repeat(dest, fill, fill_sz, size);
+        memset(dest + size, ' ', rest);
+    }
+    return size + rest;
+}
+
+/* Whether a valid fill of fill_sz bytes joins the clusters beside it: its
+ * first character extends the cluster before it or its last one joins the
+ * cluster after it, so the copies would not take the columns measured */
+static int pad_fill_joins(const char *fill, size_t fill_sz) {
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)fill;
+    const utf8proc_uint8_t *last = p + fill_sz - 1;
+    utf8proc_int32_t cp;
+    int boundclass;
+
+    utf8proc_iterate(p, -1, &cp);
+    boundclass = WIDTH_BOUNDCLASS(utf8proc_width_props(cp));
+    if (boundclass == UTF8PROC_BOUNDCLASS_EXTEND || boundclass == UTF8PROC_BOUNDCLASS_SPACINGMARK
+            || boundclass == UTF8PROC_BOUNDCLASS_ZWJ || boundclass == UTF8PROC_BOUNDCLASS_E_MODIFIER) {
+        return 1;
+    }
+    while (last > p && (*last & 0xC0) == 0x80) {
+        last--;
+    }
+    utf8proc_iterate(last, -1, &cp);
+    boundclass = WIDTH_BOUNDCLASS(utf8proc_width_props(cp));
+    return boundclass == UTF8PROC_BOUNDCLASS_ZWJ || boundclass == UTF8PROC_BOUNDCLASS_PREPEND;
+}
+
+enum utf8_result utf8str_pad(const char *str, size_t len, size_t cols, const char *fill,
+        enum utf8_pad_mode mode, unsigned int flags, char *dest, size_t *dest_sz) {
+    if (str == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    if (fill == NULL || *fill == '\0') {
+        fill = " ";
+    }
+    size_t width = utf8str_width_ex(str, len, flags, NULL);
+    size_t fill_width = utf8str_width_ex(fill, 0, flags, NULL);
+    if (width == (size_t)-1 || fill_width == (size_t)-1) {
+        return UTF8_INVALID_UTF;
+    }
+    size_t fill_sz = strlen(fill);
+    if (fill_width == 0 || pad_fill_joins(fill, fill_sz)) {
+        return UTF8_INVALID_ARG;
+    }
+
+    size_t add = (width < cols) ? cols - width : 0;
+    size_t before = (mode == UTF8_PAD_START) ? add : (mode == UTF8_PAD_BOTH) ? add / 2 : 0;
+    size_t str_sz = (len == 0) ? strlen(str) : len;
+    size_t before_sz = pad_fill(NULL, fill, fill_sz, fill_width, before, flags);
+    size_t after_sz = pad_fill(NULL, fill, fill_sz, fill_width, add - before, flags);
+    size_t size = before_sz + str_sz + after_sz;
+    if (dest != NULL && dest_sz != NULL && *dest_sz != 0 && size >= *dest_sz) {
+        return UTF8_BUFFER_SMALL;
+    }
+
+    if (dest != NULL) {
+        /* the text moves first, dest can be str */
+        memmove(dest + before_sz, str, str_sz);
+        pad_fill(dest, fill, fill_sz, fill_width, before, flags);
+        pad_fill(dest + before_sz + str_sz, fill, fill_sz, fill_width, add - before, flags);
+        dest[size] = '\0';
+    }
+    if (dest_sz != NULL) {
+        *dest_sz = size;
+    }
+    return (width > cols) ? UTF8_TOO_LONG : UTF8_OK;
+}
+
+/* the columns of a fill that its last copy leaves */
+static const char pad_spaces[] = "        ";
+
+/* Adds a piece to iov, which can take cap of them, and counts it in n */
+static void pad_iov_add(utf8str_iovec_t *iov, size_t cap, size_t *n, const char *base, size_t len) {
+    if (*n < cap) {
+        iov[*n].iov_base = (void*)base;
+        iov[*n].iov_len = len;
+    }
+    (*n)++;
+}
+
+/* Adds the pieces of cols columns of the fill to iov: the data of the fill
+ * as many times as it takes, then spaces */
+static void pad_iov_fill(const struct utf8str_fill_t *fill, size_t cols, utf8str_iovec_t *iov,
+        size_t cap, size_t *n) {
+    size_t rest;
+    size_t size = pad_repeat_size(fill->data, fill->pattern_sz, fill->pattern_width, cols, fill->flags, &rest);
+    size_t piece = fill->copies * fill->pattern_sz;
+    while (size > 0) {
+        size_t take = (size < piece) ? size : piece;
+        pad_iov_add(iov, cap, n, fill->data, take);
+        size -= take;
+    }
+    while (rest > 0) {
+        size_t take = (rest < sizeof(pad_spaces) - 1) ? rest : sizeof(pad_spaces) - 1;
+        pad_iov_add(iov, cap, n, pad_spaces, take);
+        rest -= take;
+    }
+}
+
+enum utf8_result utf8str_fill_init(struct utf8str_fill_t *fill, const char *pattern, size_t cols,
+        unsigned int flags, const struct utf8str_alloc_t *alloc) {
+    if (fill == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    memset(fill, 0, sizeof(*fill));
+    if (pattern == NULL || *pattern == '\0') {
+        pattern = " ";
+    }
+    size_t width = utf8str_width_ex(pattern, 0, flags, NULL);
+    if (width == (size_t)-1) {
+        return UTF8_INVALID_UTF;
+    }
+    if (width == 0 || pad_fill_joins(pattern, strlen(pattern))) {
+        return UTF8_INVALID_ARG;
+    }
+
+    fill->alloc = (alloc == NULL) ? default_alloc : *alloc;
+    fill->pattern_sz = strlen(pattern);
+    fill->pattern_width = width;
+    fill->flags = flags;
+    fill->copies = (cols <= width) ? 1 : (cols + width - 1) / width;
+    size_t size = fill->copies * fill->pattern_sz;
+    fill->data = (char*)fill->alloc.resize(fill->alloc.ctx, NULL, size + 1);
+    if (fill->data == NULL) {
+        return UTF8_OUT_OF_MEMORY;
+    }
+    fill_repeat(fill->data, pattern, fill->pattern_sz, size);
+    fill->data[size] = '\0';
+    return UTF8_OK;
+}
+
+enum utf8_result utf8str_pad_iov(const char *str, size_t len, size_t cols, const struct utf8str_fill_t *fill,
+        enum utf8_pad_mode mode, utf8str_iovec_t *iov, size_t *iov_count) {
+    if (str == NULL || fill == NULL || fill->data == NULL || iov_count == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    size_t width = utf8str_width_ex(str, len, fill->flags, NULL);
+    if (width == (size_t)-1) {
+        return UTF8_INVALID_UTF;
+    }
+
+    size_t add = (width < cols) ? cols - width : 0;
+    size_t before = (mode == UTF8_PAD_START) ? add : (mode == UTF8_PAD_BOTH) ? add / 2 : 0;
+    size_t str_sz = (len == 0) ? strlen(str) : len;
+    size_t cap = (iov == NULL) ? 0 : *iov_count, n = 0;
+    pad_iov_fill(fill, before, iov, cap, &n);
+    if (str_sz > 0) {
+        pad_iov_add(iov, cap, &n, str, str_sz);
+    }
+    pad_iov_fill(fill, add - before, iov, cap, &n);
+
+    *iov_count = n;
+    if (iov != NULL && n > cap) {
+        return UTF8_BUFFER_SMALL;
+    }
+    return (width > cols) ? UTF8_TOO_LONG : UTF8_OK;
+}
+
+enum utf8_result utf8str_fill_free(struct utf8str_fill_t *fill) {
+    if (fill == NULL) {
+        return UTF8_OK;
+    }
+
+    if (fill->data != NULL) {
+        fill->alloc.release(fill->alloc.ctx, fill->data);
+    }
+    fill->data = NULL;
+    fill->copies = 0;
+    return UTF8_OK;
+}
+
+/* Measures the grapheme cluster at p, which is before end and starts at
+ * column, for a column index: a tab reaches the next tab stop. Returns the
+ * byte length, 0 at an invalid UTF8 sequence */
+static size_t colindex_cluster(const struct utf8str_colindex_t *index, const utf8proc_uint8_t *p,
+        const utf8proc_uint8_t *end, size_t column, size_t *width) {
+    size_t cnt = width_next(p, end, index->flags, width);
+    if (*p == '\t' && index->tab_size != 0) {
+        *width = index->tab_size - column % index->tab_size;
+    }
+    return cnt;
+}
+
+/* Moves pos over the cluster of cnt bytes at p */
+static void colpos_advance(struct utf8str_colpos_t *pos, const utf8proc_uint8_t *p, size_t cnt, size_t width) {
+    pos->byte_offset += cnt;
+    pos->column += width;
+    for (; cnt > 0; cnt--, p++) {
+        pos->char_offset += (*p & 0xC0) != 0x80;
+    }
+}
+
+/* Adds the checkpoints of the columns before pos->column + width: pos for a
+ * cluster, or the position of each column for a run of one-byte characters
+ * one column wide if narrow is set */
+static enum utf8_result colindex_mark(struct utf8str_colindex_t *index,
+        const struct utf8str_colpos_t *pos, size_t width, int narrow) {
+    while (index->count * index->step < pos->column + width) {
+        if (index->count == index->capacity) {
+            size_t capacity = (index->capacity == 0) ? 16 : index->capacity * 2;
+            struct utf8str_colpos_t *marks = (struct utf8str_colpos_t*)index->alloc.resize(index->alloc.ctx,
+                    index->marks, capacity * sizeof(*marks));
+            if (marks == NULL) {
+                return UTF8_OUT_OF_MEMORY;
+            }
+            index->marks = marks;
+            index->capacity = capacity;
+        }
+        struct utf8str_colpos_t *mark = &index->marks[index->count];
+        size_t skip = narrow ? index->count * index->step - pos->column : 0;
+        mark->byte_offset = pos->byte_offset + skip;
+        mark->char_offset = pos->char_offset + skip;
+        mark->column = pos->column + skip;
+        index->count++;
+    }
+    return UTF8_OK;
+}
+
+enum utf8_result utf8str_colindex_init(struct utf8str_colindex_t *index, size_t step,
+        size_t tab_size, unsigned int flags, const struct utf8str_alloc_t *alloc) {
+    if (index == NULL || step == 0) {
+        return UTF8_INVALID_ARG;
+    }
+
+    memset(index, 0, sizeof(*index));
+    index->step = step;
+    index->tab_size = tab_size;
+    index->flags = flags;
+    index->alloc = (alloc == NULL) ? default_alloc : *alloc;
+    return UTF8_OK;
+}
+
+enum utf8_result utf8str_colindex_append(struct utf8str_colindex_t *index, const char *str, size_t len) {
+    if (index == NULL || str == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+    if (len == 0) {
+        len = strlen(str);
+    }
+    if (len < index->end.byte_offset) {
+        return UTF8_INVALID_ARG;
+    }
+
+    /* the last cluster is measured again with its checkpoints: all of them
+     * are at its start */
+    while (index->count > 0 && index->marks[index->count - 1].byte_offset >= index->last.byte_offset) {
+        index->count--;
+    }
+    struct utf8str_colpos_t pos = index->last;
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)str + pos.byte_offset;
+    const utf8proc_uint8_t *end = (const utf8proc_uint8_t*)str + len;
+    enum utf8_result result = UTF8_OK;
+    while (p < end) {
+        /* printable ASCII before another ASCII byte is a cluster alone, the
+         * last byte of the line is not: text appended later may join it */
+        const utf8proc_uint8_t *run = p;
+        while (run + 1 < end && WIDTH_PRINTABLE(*run) && run[1] < 0x80) {
+            run++;
+        }
+        if (run != p) {
+            size_t cnt = (size_t)(run - p);
+            result = colindex_mark(index, &pos, cnt, 1);
+            if (result != UTF8_OK) {
+                break;
+            }
+            pos.byte_offset += cnt;
+            pos.char_offset += cnt;
+            pos.column += cnt;
+            p = run;
+            continue;
+        }
+
+        size_t width;
+        size_t cnt = colindex_cluster(index, p, end, pos.column, &width);
+        if (cnt == 0) {
+            result = UTF8_INVALID_UTF;
+            break;
+        }
+        result = colindex_mark(index, &pos, width, 0);
+        if (result != UTF8_OK) {
+            break;
+        }
+        index->last = pos;
+        colpos_advance(&pos, p, cnt, width);
+        p += cnt;
+    }
+
+    if (result != UTF8_OK) {
+        index->last = pos;
+    }
+    index->end = pos;
+    return result;
+}
+
+enum utf8_result utf8str_colindex_column_to_byte(const struct utf8str_colindex_t *index,
+        const char *str, size_t column, struct utf8str_colpos_t *pos) {
+    if (index == NULL || str == NULL || pos == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+    if (column >= index->end.column) {
+        *pos = index->end;
+        return UTF8_OK;
+    }
+
+    /* the checkpoint at or before the column, then the clusters after it */
+    struct utf8str_colpos_t at = {0, 0, 0};
+    if (index->count > 0) {
+        size_t k = column / index->step;
+        at = index->marks[k < index->count ? k : index->count - 1];
+    }
+    const utf8proc_uint8_t *end = (const utf8proc_uint8_t*)str + index->end.byte_offset;
+    for (;;) {
+        const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)str + at.byte_offset;
+        size_t width;
+        size_t cnt = colindex_cluster(index, p, end, at.column, &width);
+        if (cnt == 0 || at.column + width > column) {
+            break;
+        }
+        colpos_advance(&at, p, cnt, width);
+    }
+    *pos = at;
+    return UTF8_OK;
+}
+
+enum utf8_result utf8str_colindex_byte_to_column(const struct utf8str_colindex_t *index,
+        const char *str, size_t byte_offset, struct utf8str_colpos_t *pos) {
+    if (index == NULL || str == NULL || pos == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+    if (byte_offset >= index->end.byte_offset) {
+        *pos = index->end;
+        return UTF8_OK;
+    }
+
+    /* the last checkpoint at or before the byte */
+    struct utf8str_colpos_t at = {0, 0, 0};
+    size_t low = 0, high = index->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (index->marks[mid].byte_offset <= byte_offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low > 0) {
+        at = index->marks[low - 1];
+    }
+    const utf8proc_uint8_t *end = (const utf8proc_uint8_t*)str + index->end.byte_offset;
+    for (;;) {
+        const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)str + at.byte_offset;
+        size_t width;
+        size_t cnt = colindex_cluster(index, p, end, at.column, &width);
+        if (cnt == 0 || at.byte_offset + cnt > byte_offset) {
+            break;
+        }
+        colpos_advance(&at, p, cnt, width);
+    }
+    *pos = at;
+    return UTF8_OK;
+}
+
+enum utf8_result utf8str_colindex_free(struct utf8str_colindex_t *index) {
+    if (index == NULL) {
+        return UTF8_OK;
+    }
+
+    if (index->marks != NULL) {
+        index->alloc.release(index->alloc.ctx, index->marks);
+    }
+    index->marks = NULL;
+    index->count = index->capacity = 0;
+    memset(&index->end, 0, sizeof(index->end));
+    memset(&index->last, 0, sizeof(index->last));
+    return UTF8_OK;
+}
+
+#if UTF8STR_WITH_LINEBREAK
+#define LB(c) UTF8PROC_LINEBREAK_##c
+#define LB_BIT(c) ((uint64_t)1 << UTF8PROC_LINEBREAK_##c)
+#define LB_IN(c, set) ((((uint64_t)(set)) >> (c)) & 1)
+/* the start of a line, which has no class */
+#define LB_NONE (-1)
+#define WRAP_LETTER(c) ((unsigned int)(((c) | 0x20) - 'a') < 26)
+
+/* Line breaking classes of printable ASCII, from U+0020 */
+static const signed char wrap_ascii_class[95] = {
+    LB(SP), LB(EX), LB(QU), LB(AL), LB(PR), LB(PO), LB(AL), LB(QU),
+    LB(OP), LB(CP), LB(AL), LB(PR), LB(IS), LB(HY), LB(IS), LB(SY),
+    LB(NU), LB(NU), LB(NU), LB(NU), LB(NU), LB(NU), LB(NU), LB(NU),
+    LB(NU), LB(NU), LB(IS), LB(IS), LB(AL), LB(AL), LB(AL), LB(EX),
+    LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL),
+    LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL),
+    LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL),
+    LB(AL), LB(AL), LB(AL), LB(OP), LB(PR), LB(CP), LB(AL), LB(AL),
+    LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL),
+    LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL),
+    LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL), LB(AL),
+    LB(AL), LB(AL), LB(AL), LB(OP), LB(BA), LB(CL), LB(AL),
+};
+
+/* The line breaking class of c resolved by rule LB1: ambiguous, surrogate,
+ * unknown and South East Asian characters are alphabetic, except for marks,
+ * and conditional Japanese starters are nonstarters */
+static int wrap_class(utf8proc_int32_t c) {
+    int cls = (int)utf8proc_linebreak(c);
+    switch (cls) {
+        case LB(AI):
+        case LB(SG):
+        case LB(XX):
+            return LB(AL);
+        case LB(SA): {
+            utf8proc_category_t ctg = utf8proc_category(c);
+            return (ctg == UTF8PROC_CATEGORY_MN || ctg == UTF8PROC_CATEGORY_MC) ? LB(CM) : LB(AL);
+        }
+        case LB(CJ):
+            return LB(NS);
+        default:
+            return cls;
+    }
+}
+
+/* Classes of the first and the last character of the grapheme cluster of cnt
+ * bytes at p. Lines do not break inside clusters, so marks and joiners take
+ * the class of the character before them(LB9): CM for a cluster of them
+ * alone, e.g. after a control character. Joined to a space they are
+ * alphabetic(LB10), the last class of the cluster */
+static void wrap_cluster_class(const utf8proc_uint8_t *p, size_t cnt, int *first, int *last) {
+    utf8proc_int32_t cp;
+    size_t i = (size_t)utf8proc_iterate(p, (utf8proc_ssize_t)cnt, &cp);
+    int cls = wrap_class(cp);
+    if (cls == LB(ZWJ)) {
+        cls = LB(CM);
+    }
+    *first = *last = cls;
+    if (i < cnt && (cls == LB(SP) || cls == LB(ZW))) {
+        *last = LB(AL);
+    }
+    while (i < cnt) {
+        i += (size_t)utf8proc_iterate(p + i, (utf8proc_ssize_t)(cnt - i), &cp);
+        cls = wrap_class(cp);
+        if (cls != LB(CM) && cls != LB(ZWJ)) {
+            *last = cls;
+        }
+    }
+}
+
+/* Whether a line can break before a cluster of class after that follows one
+ * of class before, with spaces between them if spaces is set, and before2 is
+ * the class of the cluster before that one. Rules LB6-LB31 of UAX #14 for
+ * Unicode 9.0, LB30a and LB30b hold inside grapheme clusters */
+static int wrap_break(int before2, int before, int after, int spaces) {
+    if (before == LB(AL) && after == LB(AL) && !spaces) {
+        return 0;
+    }
+    if (LB_IN(after, LB_BIT(BK) | LB_BIT(CR) | LB_BIT(LF) | LB_BIT(NL) | LB_BIT(SP) | LB_BIT(ZW))) {
+        return 0;
+    }
+    if (before == LB(ZW)) {
+        return 1;
+    }
+    if (LB_IN(after, LB_BIT(WJ) | LB_BIT(CL) | LB_BIT(CP) | LB_BIT(EX) | LB_BIT(IS) | LB_BIT(SY))
+            || before == LB(OP)
+            || (before == LB(QU) && after == LB(OP))
+            || ((before == LB(CL) || before == LB(CP)) && after == LB(NS))
+            || (before == LB(B2) && after == LB(B2))) {
+        return 0;
+    }
+    if (spaces) {
+        return 1;
+    }
+
+    if (before == LB(WJ) || before == LB(GL)
+            || (after == LB(GL) && before != LB(BA) && before != LB(HY))
+            || after == LB(QU) || before == LB(QU)) {
+        return 0;
+    }
+    if (after == LB(CB) || before == LB(CB)) {
+        return 1;
+    }
+    const uint64_t alpha = LB_BIT(AL) | LB_BIT(HL);
+    const uint64_t ideo = LB_BIT(ID) | LB_BIT(EB) | LB_BIT(EM);
+    const uint64_t jamo = LB_BIT(JL) | LB_BIT(JV) | LB_BIT(JT) | LB_BIT(H2) | LB_BIT(H3);
+    const uint64_t prefix = LB_BIT(PR) | LB_BIT(PO);
+    return !(LB_IN(after, LB_BIT(BA) | LB_BIT(HY) | LB_BIT(NS)) || before == LB(BB)
+        /* LB21a, LB21b */
+        || (before2 == LB(HL) && (before == LB(HY) || before == LB(BA)))
+        || (before == LB(SY) && after == LB(HL))
+        /* LB22 */
+        || (after == LB(IN) && LB_IN(before, alpha | ideo | LB_BIT(EX) | LB_BIT(IN) | LB_BIT(NU)))
+        /* LB23, LB23a, LB24 */
+        || (LB_IN(before, alpha) && LB_IN(after, LB_BIT(NU) | prefix))
+        || (before == LB(NU) && LB_IN(after, alpha))
+        || (before == LB(PR) && LB_IN(after, ideo))
+        || (LB_IN(before, ideo) && after == LB(PO))
+        || (LB_IN(before, prefix) && LB_IN(after, alpha))
+        /* LB25 */
+        || (LB_IN(before, LB_BIT(CL) | LB_BIT(CP) | LB_BIT(NU)) && LB_IN(after, prefix))
+        || (LB_IN(before, prefix) && (after == LB(OP) || after == LB(NU)))
+        || (LB_IN(before, LB_BIT(HY) | LB_BIT(IS) | LB_BIT(NU) | LB_BIT(SY)) && after == LB(NU))
+        /* LB26, LB27 */
+        || (before == LB(JL) && LB_IN(after, LB_BIT(JL) | LB_BIT(JV) | LB_BIT(H2) | LB_BIT(H3)))
+        || (LB_IN(before, LB_BIT(JV) | LB_BIT(H2)) && (after == LB(JV) || after == LB(JT)))
+        || (LB_IN(before, LB_BIT(JT) | LB_BIT(H3)) && after == LB(JT))
+        || (LB_IN(before, jamo) && (after == LB(IN) || after == LB(PO)))
+        || (before == LB(PR) && LB_IN(after, jamo))
+        /* LB28, LB29, LB30 */
+        || (LB_IN(before, alpha) && LB_IN(after, alpha))
+        || (before == LB(IS) && LB_IN(after, alpha))
+        || (LB_IN(before, alpha | LB_BIT(NU)) && after == LB(OP))
+        || (before == LB(CP) && LB_IN(after, alpha | LB_BIT(NU))));
+}
+
+enum utf8_result utf8str_wrap(const char *str, size_t len, size_t max_cols, unsigned int flags,
+        int (*emit)(void *ctx, const struct utf8str_line_t *line), void *ctx) {
+    if (str == NULL || emit == NULL || max_cols == 0) {
+        return UTF8_INVALID_ARG;
+    }
+
+    const utf8proc_uint8_t *start = (const utf8proc_uint8_t*)str;
+    const utf8proc_uint8_t *end = (len == 0) ? NULL : start + len;
+    const utf8proc_uint8_t *p = start;
+    /* The current line starts at line and is width columns wide up to p. Its
+     * text without the spaces after it ends at text_end. brk is the last
+     * break opportunity in the line: the line can end at brk_end, and the
+     * text from brk is the width up to brk narrower */
+    const utf8proc_uint8_t *line = start, *text_end = start, *brk = NULL, *brk_end = NULL;
+    size_t width = 0, text_width = 0, brk_width = 0, brk_at = 0;
+    int before = LB_NONE, before2 = LB_NONE, spaces = 0, mandatory = 0;
+    struct utf8str_line_t out;
+
+    while (!WIDTH_END(p, end)) {
+        int first, last, joined = 0;
+        size_t cnt, w;
+        if (!mandatory && (p + 1 == end || p[1] < 0x80)) {
+            /* ASCII prose: a space hangs, letters join a letter before
+             * them(LB28) and are taken as far as they fit. After spaces a
+             * letter has a break opportunity unless an opening bracket is
+             * before them(LB14) */
+            if (*p == ' ') {
+                width++;
+                spaces = 1;
+                p++;
+                continue;
+            }
+            if (WRAP_LETTER(*p) && width < max_cols && (spaces || before == LB(AL))) {
+                size_t room = max_cols - width, n = 1;
+                while (n < room && WRAP_LETTER(p[n]) && (p + n + 1 == end || p[n + 1] < 0x80)) {
+                    n++;
+                }
+                if (spaces && before != LB_NONE && before != LB(OP)) {
+                    brk = p;
+                    brk_end = text_end;
+                    brk_width = text_width;
+                    brk_at = width;
+                }
+                before2 = (n > 1 || !spaces) ? LB(AL) : LB_NONE;
+                before = LB(AL);
+                spaces = 0;
+                width += n;
+                p += n;
+                text_end = p;
+                text_width = width;
+                continue;
+            }
+        }
+        if (WIDTH_PRINTABLE(*p) && (p + 1 == end || p[1] < 0x80)) {
+            /* printable ASCII before another ASCII byte is a cluster alone */
+            first = last = wrap_ascii_class[*p - 0x20];
+            cnt = w = 1;
+        } else {
+            cnt = width_next(p, end, flags, &w);
+            if (cnt == 0) {
+                return UTF8_INVALID_UTF;
+            }
+            wrap_cluster_class(p, cnt, &first, &last);
+            if (first == LB(CM)) {
+                /* marks after a character other than a space or a break go
+                 * on with its class, the others are alphabetic(LB10) */
+                joined = !mandatory && !spaces && before != LB_NONE && before != LB(ZW);
+                first = joined ? before : LB(AL);
+                if (last == LB(CM)) {
+                    last = first;
+                }
+            }
+        }
+
+        if (mandatory) {
+            out.offset = (size_t)(line - start);
+            out.length = (size_t)(text_end - line);
+            out.width = text_width;
+            if (emit(ctx, &out) != 0) {
+                return UTF8_OK;
+            }
+            line = text_end = p;
+            width = text_width = 0;
+            brk = NULL;
+            before = before2 = LB_NONE;
+            spaces = mandatory = 0;
+        } else if (!joined && before != LB_NONE && wrap_break(before2, before, first, spaces)) {
+            brk = p;
+            brk_end = text_end;
+            brk_width = text_width;
+            brk_at = width;
+        }
+
+        if (last == LB(SP)) {
+            /* spaces at the end of a line hang over max_cols */
+            width += w;
+            spaces = 1;
+            p += cnt;
+            continue;
+        }
+        if (LB_IN(last, LB_BIT(BK) | LB_BIT(CR) | LB_BIT(LF) | LB_BIT(NL))) {
+            mandatory = 1;
+            p += cnt;
+            continue;
+        }
+
+        if (width + w > max_cols && p > line) {
+            if (brk != NULL) {
+                out.offset = (size_t)(line - start);
+                out.length = (size_t)(brk_end - line);
+                out.width = brk_width;
+                if (emit(ctx, &out) != 0) {
+                    return UTF8_OK;
+                }
+                /* a break opportunity is never before a space, so the text
+                 * goes on from brk unless brk is p */
+                line = brk;
+                width -= brk_at;
+                if (text_end > brk) {
+                    text_width -= brk_at;
+                } else {
+                    text_end = brk;
+                    text_width = 0;
+                }
+                brk = NULL;
+            }
+            if (width + w > max_cols && p > line) {
+                /* no break opportunity: the cluster starts the next line,
+                 * spaces without text before it are dropped */
+                if (text_end > line) {
+                    out.offset = (size_t)(line - start);
+                    out.length = (size_t)(text_end - line);
+                    out.width = text_width;
+                    if (emit(ctx, &out) != 0) {
+                        return UTF8_OK;
+                    }
+                }
+                line = text_end = p;
+                width = text_width = 0;
+            }
+        }
+
+        width += w;
+        p += cnt;
+        text_end = p;
+        text_width = width;
+        if (!joined) {
+            before2 = spaces ? LB_NONE : before;
+        }
+        before = last;
+        spaces = 0;
+    }
+
+    if (mandatory || p > line) {
+        out.offset = (size_t)(line - start);
+        out.length = (size_t)(text_end - line);
+        out.width = text_width;
+        emit(ctx, &out);
+    }
+    return UTF8_OK;
+}
+
+/* Kinds of paragraph breaks: a break opportunity of UAX #14, a break inside
+ * a word wider than a line and a mandatory break, which also marks the
+ * paragraph start and end */
+#define PAR_BREAK 0
+#define PAR_EMERGENCY 1
+#define PAR_MANDATORY 2
+/* Badness of a line that cannot be stretched to its width, and the
+ * penalty of a break inside a word */
+#define PAR_BADNESS_MAX 10000
+#define PAR_EMERGENCY_PENALTY 1000
+#define PAR_LINE_PENALTY 10
+
+/* A break of the paragraph: the line before it ends at end and the line
+ * after it starts at start. Columns and gaps between words are counted
+ * from the paragraph start, so a line from break i to break j is
+ * brks[j].end_col - brks[i].start_col columns wide */
+struct utf8str_paragraph_break_t {
+    size_t end;
+    size_t start;
+    size_t end_col;
+    size_t start_col;
+    size_t end_gaps;
+    size_t start_gaps;
+    int kind;
+    /* the best lines up to the break: their demerits and the break before */
+    uint64_t total;
+    size_t prev;
+};
+
+static enum utf8_result paragraph_add(struct utf8str_paragraph_t *par, const struct utf8str_paragraph_break_t *brk) {
+    if (par->count == par->capacity) {
+        size_t capacity = (par->capacity == 0) ? 64 : par->capacity * 2;
+        struct utf8str_paragraph_break_t *breaks = (struct utf8str_paragraph_break_t*)par->alloc.resize(par->alloc.ctx,
+                par->breaks, capacity * sizeof(*breaks));
+        if (breaks == NULL) {
+            return UTF8_OUT_OF_MEMORY;
+        }
+        par->breaks = breaks;
+        par->capacity = capacity;
+    }
+    par->breaks[par->count++] = *brk;
+    return UTF8_OK;
+}
+
+/* Finds the breaks of the paragraph as utf8str_wrap does, but all of them.
+ * A gap is a run of spaces after text in a line, the spaces that start a
+ * line are not a gap. A word wider than the line gets emergency breaks
+ * where it would overflow a line that starts at the break before it */
+static enum utf8_result paragraph_scan(struct utf8str_paragraph_t *par,
+        const utf8proc_uint8_t *start, const utf8proc_uint8_t *end) {
+    const utf8proc_uint8_t *p = start, *text_end = start, *seg = start;
+    size_t col = 0, gaps = 0, text_col = 0, text_gaps = 0, seg_col = 0;
+    int before = LB_NONE, before2 = LB_NONE, spaces = 0, mandatory = 0;
+    struct utf8str_paragraph_break_t brk;
+    enum utf8_result result;
+
+    memset(&brk, 0, sizeof(brk));
+    brk.kind = PAR_MANDATORY;
+    par->count = 0;
+    if ((result = paragraph_add(par, &brk)) != UTF8_OK) {
+        return result;
+    }
+    while (!WIDTH_END(p, end)) {
+        int first, last, joined = 0;
+        size_t cnt, w;
+        if (!mandatory && (p + 1 == end || p[1] < 0x80)) {
+            /* ASCII prose as in utf8str_wrap, letters are taken as far as
+             * they fit a line from the last break */
+            if (*p == ' ') {
+                gaps += !spaces && before != LB_NONE;
+                col++;
+                spaces = 1;
+                p++;
+                continue;
+            }
+            if (WRAP_LETTER(*p) && (spaces || before == LB(AL))) {
+                if (spaces && before != LB_NONE && before != LB(OP)) {
+                    brk.end = (size_t)(text_end - start);
+                    brk.start = (size_t)(p - start);
+                    brk.end_col = text_col;
+                    brk.start_col = col;
+                    brk.end_gaps = text_gaps;
+                    brk.start_gaps = gaps;
+                    brk.kind = PAR_BREAK;
+                    if ((result = paragraph_add(par, &brk)) != UTF8_OK) {
+                        return result;
+                    }
+                    seg = p;
+                    seg_col = col;
+                }
+                if (col - seg_col < par->max_cols) {
+                    size_t room = par->max_cols - (col - seg_col), n = 1;
+                    while (n < room && WRAP_LETTER(p[n]) && (p + n + 1 == end || p[n + 1] < 0x80)) {
+                        n++;
+                    }
+                    before2 = (n > 1 || !spaces) ? LB(AL) : LB_NONE;
+                    before = LB(AL);
+                    spaces = 0;
+                    col += n;
+                    p += n;
+                    text_end = p;
+                    text_col = col;
+                    text_gaps = gaps;
+                    continue;
+                }
+            }
+        }
+        if (WIDTH_PRINTABLE(*p) && (p + 1 == end || p[1] < 0x80)) {
+            first = last = wrap_ascii_class[*p - 0x20];
+            cnt = w = 1;
+        } else {
+            cnt = width_next(p, end, par->flags, &w);
+            if (cnt == 0) {
+                return UTF8_INVALID_UTF;
+            }
+            wrap_cluster_class(p, cnt, &first, &last);
+            if (first == LB(CM)) {
+                joined = !mandatory && !spaces && before != LB_NONE && before != LB(ZW);
+                first = joined ? before : LB(AL);
+                if (last == LB(CM)) {
+                    last = first;
+                }
+            }
+        }
+        int space = last == LB(SP), newline = LB_IN(last, LB_BIT(BK) | LB_BIT(CR) | LB_BIT(LF) | LB_BIT(NL));
+
+        brk.kind = -1;
+        if (mandatory) {
+            brk.kind = PAR_MANDATORY;
+        } else if (!joined && before != LB_NONE && wrap_break(before2, before, first, spaces)) {
+            brk.kind = PAR_BREAK;
+        } else if (!space && !newline && col + w - seg_col > par->max_cols) {
+            if (text_end > seg) {
+                brk.kind = PAR_EMERGENCY;
+            } else if (p > seg) {
+                /* spaces that start a line and leave no room for its text
+                 * are dropped as by utf8str_wrap */
+                par->breaks[par->count - 1].start = (size_t)(p - start);
+                par->breaks[par->count - 1].start_col = col;
+                seg = p;
+                seg_col = col;
+            }
+        }
+        if (brk.kind >= 0) {
+            brk.end = (size_t)(text_end - start);
+            brk.start = (size_t)(p - start);
+            brk.end_col = text_col;
+            brk.start_col = col;
+            brk.end_gaps = text_gaps;
+            brk.start_gaps = gaps;
+            if ((result = paragraph_add(par, &brk)) != UTF8_OK) {
+                return result;
+            }
+            seg = p;
+            seg_col = col;
+            if (brk.kind == PAR_MANDATORY) {
+                text_end = p;
+                text_col = col;
+                text_gaps = gaps;
+                before = before2 = LB_NONE;
+                spaces = mandatory = 0;
+            }
+        }
+
+        /* a space cluster after a break starts the line, it is no gap */
+        if (first == LB(SP) && !spaces && before != LB_NONE && p > seg) {
+            gaps++;
+        }
+        if (space) {
+            col += w;
+            spaces = 1;
+            p += cnt;
+            continue;
+        }
+        if (newline) {
+            mandatory = 1;
+            p += cnt;
+            continue;
+        }
+
+        col += w;
+        p += cnt;
+        text_end = p;
+        text_col = col;
+        text_gaps = gaps;
+        if (!joined) {
+            before2 = spaces ? LB_NONE : before;
+        }
+        before = last;
+        spaces = 0;
+    }
+
+    brk.end = (size_t)(text_end - start);
+    brk.start = (size_t)(p - start);
+    brk.end_col = text_col;
+    brk.start_col = col;
+    brk.end_gaps = text_gaps;
+    brk.start_gaps = gaps;
+    brk.kind = PAR_MANDATORY;
+    return paragraph_add(par, &brk);
+}
+
+/* Demerits of a line from break i to break j of natural width columns with
+ * gaps between words: the badness of stretching the gaps to max_cols grows
+ * with the cube of the spaces added per gap, as in TeX */
+static uint64_t paragraph_demerits(const struct utf8str_paragraph_t *par,
+        const struct utf8str_paragraph_break_t *i, const struct utf8str_paragraph_break_t *j) {
+    size_t width = j->end_col - i->start_col;
+    size_t gaps = j->end_gaps - i->start_gaps;
+    uint64_t badness = 0;
+
+    if (width > par->max_cols) {
+        /* a cluster wider than a line */
+        badness = PAR_BADNESS_MAX;
+    } else if (j->kind != PAR_MANDATORY && width < par->max_cols) {
+        uint64_t slack = par->max_cols - width;
+        if (gaps == 0 || slack > 5 * (uint64_t)gaps) {
+            badness = PAR_BADNESS_MAX;
+        } else {
+            badness = 100 * slack * slack * slack / ((uint64_t)gaps * gaps * gaps);
+            if (badness > PAR_BADNESS_MAX) {
+                badness = PAR_BADNESS_MAX;
+            }
+        }
+    }
+    uint64_t demerits = (PAR_LINE_PENALTY + badness) * (PAR_LINE_PENALTY + badness);
+    if (j->kind == PAR_EMERGENCY) {
+        demerits += (uint64_t)PAR_EMERGENCY_PENALTY * PAR_EMERGENCY_PENALTY;
+    }
+    return demerits;
+}
+
+/* Chooses the breaks with the least total demerits. The lines that end at a
+ * break start at most max_cols columns before it, so every break looks back
+ * over a line of breaks at most, and never past a mandatory break. On return
+ * prev links the chosen breaks from the end */
+static void paragraph_fit(struct utf8str_paragraph_t *par) {
+    struct utf8str_paragraph_break_t *brks = par->breaks;
+    size_t i, j;
+
+    for (j = 1; j < par->count; j++) {
+        brks[j].total = UINT64_MAX;
+        for (i = j; i-- > 0; ) {
+            if (i + 1 < j && brks[j].end_col - brks[i].start_col > par->max_cols) {
+                break;
+            }
+            /* no line has less demerits than its penalty */
+            if (brks[i].total < brks[j].total - PAR_LINE_PENALTY * PAR_LINE_PENALTY) {
+                uint64_t total = brks[i].total + paragraph_demerits(par, &brks[i], &brks[j]);
+                if (total < brks[j].total) {
+                    brks[j].total = total;
+                    brks[j].prev = i;
+                }
+            }
+            if (brks[i].kind == PAR_MANDATORY) {
+                break;
+            }
+        }
     }
-
-    return ctg == UTF8PROC_CATEGORY_LL;
 }
 
-int utf8str_isupper(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
+/* Writes the line from break i to break j, adding the spaces up to max_cols
+ * to its gaps: the later gaps get one more if they cannot be even. The gaps
+ * are counted here as they are written, so the size always matches them */
+static enum utf8_result paragraph_line(const struct utf8str_paragraph_t *par, const char *str,
+        const struct utf8str_paragraph_break_t *i, const struct utf8str_paragraph_break_t *j,
+        char *dest, size_t *dest_sz, size_t *used) {
+    size_t width = j->end_col - i->start_col;
+    size_t gaps = 0, slack = 0, gap = 0;
+    size_t k;
+
+    if (j->kind != PAR_MANDATORY && width < par->max_cols) {
+        for (k = i->start + 1; k < j->end; k++) {
+            if (str[k] == ' ' && str[k - 1] != ' ') {
+                gaps++;
+            }
+        }
+        if (gaps > 0) {
+            slack = par->max_cols - width;
+        }
     }
-
-    return ctg == UTF8PROC_CATEGORY_LU ||
-           ctg == UTF8PROC_CATEGORY_LT;
-}
-
-int utf8str_iscntrl(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
+    size_t size = j->end - i->start + slack;
+    if (dest != NULL && dest_sz != NULL && *dest_sz != 0 && *used + size >= *dest_sz) {
+        return UTF8_BUFFER_SMALL;
     }
-
-    return ctg == UTF8PROC_CATEGORY_CC;
-}
-
-int utf8str_isalpha(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
+    if (dest == NULL) {
+        *used += size;
+        return UTF8_OK;
     }
 
-    return ctg == UTF8PROC_CATEGORY_LU ||
-           ctg == UTF8PROC_CATEGORY_LL ||
-           ctg == UTF8PROC_CATEGORY_LO ||
-           ctg == UTF8PROC_CATEGORY_LT;
+    char *out = dest + *used;
+    for (k = i->start; k < j->end; k++) {
+        if (slack != 0 && str[k] == ' ' && k > i->start && str[k - 1] != ' ') {
+            size_t extra = (gap + 1) * slack / gaps - gap * slack / gaps;
+            memset(out, ' ', extra);
+            out += extra;
+            gap++;
+        }
+        *out++ = str[k];
+    }
+    *used += size;
+    return UTF8_OK;
 }
 
-int utf8str_isprint(const char *str) {
-    utf8proc_category_t ctg = utf8str_get_category(str);
-    if (ctg == -1) {
-        return 0;
+enum utf8_result utf8str_paragraph_init(struct utf8str_paragraph_t *par, size_t max_cols,
+        unsigned int flags, const struct utf8str_alloc_t *alloc) {
+    if (par == NULL || max_cols == 0) {
+        return UTF8_INVALID_ARG;
     }
 
-    return ctg != UTF8PROC_CATEGORY_CN &&
-           ctg != UTF8PROC_CATEGORY_LM &&
-           ctg != UTF8PROC_CATEGORY_MN &&
-           ctg != UTF8PROC_CATEGORY_ME &&
-           ctg != UTF8PROC_CATEGORY_MC &&
-           ctg != UTF8PROC_CATEGORY_ZS &&
-           ctg != UTF8PROC_CATEGORY_ZL &&
-           ctg != UTF8PROC_CATEGORY_ZP &&
-           ctg != UTF8PROC_CATEGORY_CC &&
-           ctg != UTF8PROC_CATEGORY_CF &&
-           ctg != UTF8PROC_CATEGORY_CO &&
-           ctg != UTF8PROC_CATEGORY_CS &&
-           ctg != UTF8PROC_CATEGORY_CN;
+    memset(par, 0, sizeof(*par));
+    par->max_cols = max_cols;
+    par->flags = flags;
+    par->alloc = (alloc == NULL) ? default_alloc : *alloc;
+    return UTF8_OK;
 }
 
-size_t utf8str_width(const char *str, size_t len) {
-    if (str == NULL || *str == '\0') {
-        return 0;
+enum utf8_result utf8str_paragraph_justify(struct utf8str_paragraph_t *par, const char *str,
+        size_t len, char *dest, size_t *dest_sz) {
+    if (par == NULL || str == NULL) {
+        return UTF8_INVALID_ARG;
     }
 
-    size_t width = 0;
-    size_t cnt = 0, sz;
-    utf8proc_uint8_t *ustr = (utf8proc_uint8_t*)str;
-    utf8proc_int32_t cp;
-    while (*ustr) {
-        sz = utf8proc_iterate(ustr, -1, &cp);
+    const utf8proc_uint8_t *start = (const utf8proc_uint8_t*)str;
+    enum utf8_result result = paragraph_scan(par, start, (len == 0) ? NULL : start + len);
+    if (result != UTF8_OK) {
+        return result;
+    }
+    paragraph_fit(par);
+
+    /* turn the chosen breaks into a list from the start */
+    struct utf8str_paragraph_break_t *brks = par->breaks;
+    size_t j = par->count - 1, next = (size_t)-1;
+    for (;;) {
+        size_t prev = brks[j].prev;
+        brks[j].prev = next;
+        if (j == 0) {
+            break;
+        }
+        next = j;
+        j = prev;
+    }
 
-        if (cp == -1) {
-            return (size_t)-1;
+    size_t used = 0, i;
+    for (i = 0; brks[i].prev != (size_t)-1; i = brks[i].prev) {
+        if (i != 0) {
+            if (dest != NULL && dest_sz != NULL && *dest_sz != 0 && used + 1 >= *dest_sz) {
+                return UTF8_BUFFER_SMALL;
+            }
+            if (dest != NULL) {
+                dest[used] = '\n';
+            }
+            used++;
+        }
+        result = paragraph_line(par, str, &brks[i], &brks[brks[i].prev], dest, dest_sz, &used);
+        if (result != UTF8_OK) {
+            return result;
         }
+    }
 
-        width += utf8proc_charwidth(cp);
-        ustr += sz;
-        cnt++;
+    if (dest != NULL) {
+        dest[used] = '\0';
+    }
+    if (dest_sz != NULL) {
+        *dest_sz = used;
+    }
+    return UTF8_OK;
+}
 
-        if (len > 0 && cnt == len) {
-            return width;
-        }
+enum utf8_result utf8str_paragraph_free(struct utf8str_paragraph_t *par) {
+    if (par == NULL) {
+        return UTF8_OK;
     }
 
-    return width;
+    if (par->breaks != NULL) {
+        par->alloc.release(par->alloc.ctx, par->breaks);
+    }
+    par->breaks = NULL;
+    par->count = par->capacity = 0;
+    return UTF8_OK;
 }
+#endif
+#endif
+#endif
 
 enum utf8_result utf8str_substr(const char *str, ssize_t start, ssize_t len, char *dest, size_t *dest_sz) {
     const char *begin = utf8str_at_index(str, start);
@@ -623,6 +3598,7 @@ enum utf8_result utf8str_reverse(char *str) {
     return UTF8_OK;
 }
 
+#if UTF8STR_WITH_CASE
 enum utf8_result utf8str_titlecase(char *str) {
     if (str == NULL || *str == '\0') {
         return UTF8_OK;
@@ -645,7 +3621,7 @@ enum utf8_result utf8str_titlecase(char *str) {
         if (utf8str_isspace_cp(cpsrc)) {
             space = 1;
         } else if (space) {
-            cpdst = utf8proc_toupper(cpsrc);
+            cpdst = utf8proc_totitle(cpsrc);
             if (cp_length(cpdst) != len) {
                 return UTF8_BUFFER_SMALL;
             }
@@ -660,6 +3636,104 @@ enum utf8_result utf8str_titlecase(char *str) {
     return UTF8_OK;
 }
 
+static utf8proc_int32_t map_title(utf8proc_int32_t cp, int *state) {
+    /* state is 0 at the beginning of a word */
+    if (utf8str_isspace_cp(cp)) {
+        *state = 0;
+        return cp;
+    }
+    if (*state == 0) {
+        *state = 1;
+        return utf8proc_totitle(cp);
+    }
+
+    return cp;
+}
+
+enum utf8_result utf8str_titlecase_sz(char *str, size_t buf_sz) {
+    return process_utf8str_inplace_sz(str, buf_sz, 0, map_title);
+}
+
+static int is_title_break(utf8proc_int32_t cp, unsigned int breaks, const char *extra) {
+    if ((breaks & UTF8_TITLE_SPACE) && utf8str_isspace_cp(cp)) {
+        return 1;
+    }
+
+    if (breaks & (UTF8_TITLE_PUNCT | UTF8_TITLE_DASH)) {
+        utf8proc_category_t ctg = utf8proc_category(cp);
+        if (ctg == UTF8PROC_CATEGORY_PD) {
+            if (breaks & UTF8_TITLE_DASH) {
+                return 1;
+            }
+        } else if (ctg >= UTF8PROC_CATEGORY_PC && ctg <= UTF8PROC_CATEGORY_PO
+                && cp != 0x0027 && cp != 0x2019 && (breaks & UTF8_TITLE_PUNCT)) {
+            return 1;
+        }
+    }
+
+    if (extra != NULL) {
+        char srch[5] = {0};
+        utf8proc_encode_char(cp, (utf8proc_uint8_t*)srch);
+        if (strstr(extra, srch) != NULL) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+enum utf8_result utf8str_titlecase_copy(const char *src, char *dest, size_t *dest_sz,
+        unsigned int breaks, const char *extra) {
+    if (src == NULL) {
+        return UTF8_INVALID_ARG;
+    }
+
+    /* word_start is set after a break until the first cased letter of the
+     * word: it gets titlecase, and the rest of the word gets lowercase */
+    int word_start = 1;
+    size_t len, lendst, used = 0;
+    utf8proc_uint8_t *usrc = (utf8proc_uint8_t*)src;
+    utf8proc_uint8_t *udst = (utf8proc_uint8_t*)dest;
+    utf8proc_int32_t cpsrc, cpdst;
+
+    while (*usrc) {
+        len = utf8proc_iterate(usrc, -1, &cpsrc);
+
+        if (cpsrc == -1) {
+            return UTF8_INVALID_UTF;
+        }
+
+        cpdst = cpsrc;
+        if (is_title_break(cpsrc, breaks, extra)) {
+            word_start = 1;
+        } else if (is_cased(cpsrc)) {
+            cpdst = word_start ? utf8proc_totitle(cpsrc) : utf8proc_tolower(cpsrc);
+            word_start = 0;
+        }
+
+        lendst = cp_length(cpdst);
+        if (udst != NULL && dest_sz != NULL && *dest_sz != 0 && used + lendst >= *dest_sz) {
+            return UTF8_BUFFER_SMALL;
+        }
+        if (udst != NULL) {
+            udst += utf8proc_encode_char(cpdst, udst);
+        }
+
+        used += lendst;
+        usrc += len;
+    }
+
+    if (udst != NULL) {
+        *udst = '\0';
+    }
+    if (dest_sz != NULL) {
+        *dest_sz = used;
+    }
+
+    return UTF8_OK;
+}
+#endif
+
 enum utf8_result utf8str_scrub(char *str, char replace) {
     if (replace & 0x80) {
         return UTF8_INVALID_ARG;
@@ -857,7 +3931,91 @@ enum utf8_result utf8str_translate(const char *src, char *dst, size_t *dst_sz, c
     return UTF8_OK;
 }
 
+#if ASCII_BLOCK != 0
+/* Returns how many first bytes of the block are printable ASCII characters,
+ * which tab expansion copies as they are and counts one column each */
+ASCII_NO_ASAN
+static size_t tab_plain_prefix(const utf8proc_uint8_t *p) {
+#if defined(__AVX2__)
+    __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    /* bytes from 0x80 are negative, so they are less than a space too */
+    uint32_t stop = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(
+                _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F))));
+    return stop == 0 ? ASCII_BLOCK : (size_t)__builtin_ctz(stop);
+#elif defined(__SSE2__)
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    /* bytes from 0x80 are negative, so they are less than a space too */
+    unsigned int stop = (unsigned int)_mm_movemask_epi8(_mm_or_si128(
+                _mm_cmplt_epi8(v, _mm_set1_epi8(0x20)), _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F))));
+    return stop == 0 ? ASCII_BLOCK : (size_t)__builtin_ctz(stop);
+#else
+    const uint64_t high = 0x8080808080808080ULL;
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+
+    /* a control byte plus 0x60 stays below 0x80 and DEL plus 1 reaches it.
+     * Carries from non-ASCII bytes go only to the bytes after the first stop */
+    uint64_t stop = (w | ~(w + 0x6060606060606060ULL) | (w + 0x0101010101010101ULL)) & high;
+    return stop == 0 ? ASCII_BLOCK : (size_t)__builtin_ctzll(stop) / 8;
+#endif
+}
+#endif
+
+/* Returns the length of the valid UTF8 sequence of a non-ASCII character at
+ * p, 0 if it is not valid. It checks what utf8proc_iterate checks without
+ * decoding the character */
+static size_t tab_char_length(const utf8proc_uint8_t *p) {
+    if (p[0] >= 0xC2 && p[0] <= 0xDF) {
+        return (p[1] & 0xC0) == 0x80 ? 2 : 0;
+    }
+    if (p[0] >= 0xE0 && p[0] <= 0xEF) {
+        /* no overlong forms and no surrogates */
+        if ((p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80
+                || (p[0] == 0xE0 && p[1] < 0xA0) || (p[0] == 0xED && p[1] >= 0xA0)) {
+            return 0;
+        }
+        return 3;
+    }
+    if (p[0] >= 0xF0 && p[0] <= 0xF4) {
+        /* no overlong forms and nothing after U+10FFFF */
+        if ((p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80
+                || (p[0] == 0xF0 && p[1] < 0x90) || (p[0] == 0xF4 && p[1] >= 0x90)) {
+            return 0;
+        }
+        return 4;
+    }
+    return 0;
+}
+
+/* Display width of len bytes of checked UTF8 text without tabs and line
+ * breaks, which tab stops are counted from */
+static size_t tab_span_width(const utf8proc_uint8_t *p, size_t len, unsigned int flags) {
+#if UTF8STR_WITH_WIDTH && UTF8STR_WITH_GRAPHEME
+    return len == 0 ? 0 : utf8str_width_ex((const char*)p, len, flags, NULL);
+#else
+    const utf8proc_uint8_t *end = p + len;
+    size_t width = 0;
+    utf8proc_int32_t cp;
+    (void)flags;
+    while (p < end) {
+        p += utf8proc_iterate(p, end - p, &cp);
+#if UTF8STR_WITH_WIDTH
+        width += utf8proc_charwidth(cp);
+#else
+        /* every character but a control one takes a column */
+        width += (cp >= 0x20 && cp != 0x7F && (cp < 0x80 || cp >= 0xA0));
+#endif
+    }
+    return width;
+#endif
+}
+
 enum utf8_result utf8str_expand_tabs(const char *src, char *dst, size_t *dst_sz, size_t tab_sz) {
+    return utf8str_expand_tabs_ex(src, dst, dst_sz, tab_sz, 0);
+}
+
+enum utf8_result utf8str_expand_tabs_ex(const char *src, char *dst, size_t *dst_sz, size_t tab_sz,
+        unsigned int flags) {
     if (tab_sz == 0 || tab_sz > 128) {
         return UTF8_INVALID_ARG;
     }
@@ -874,49 +4032,90 @@ enum utf8_result utf8str_expand_tabs(const char *src, char *dst, size_t *dst_sz,
         return UTF8_OK;
     }
 
-    utf8proc_uint8_t *usrc = (utf8proc_uint8_t*)src;
+    /* the text between tabs is copied as is. The column of a tab is counted
+     * from line, the start of the line or the tab before it: printable ASCII
+     * text has one column per byte, any other is measured */
+    const utf8proc_uint8_t *p = (const utf8proc_uint8_t*)src;
+    const utf8proc_uint8_t *copied = p, *line = p;
     utf8proc_uint8_t *udst = (utf8proc_uint8_t*)dst;
-    utf8proc_int32_t cp;
-    size_t len;
-    size_t used = 0;
-    int i;
-
-    while (*usrc) {
-        len = utf8proc_iterate(usrc, -1, &cp);
-
-        if (cp == -1) {
-            return UTF8_INVALID_UTF;
-        }
-
-        if (cp == 0x09) {
-            for (i = 0; i < tab_sz; ++i) {
-                if (dst_sz != NULL && *dst_sz != 0 && *dst_sz <= used + 1) {
-                    return UTF8_BUFFER_SMALL;
-                }
-
-                if (udst != NULL) {
-                    *udst = ' ';
-                    ++udst;
+    size_t used = 0, column = 0;
+    int plain = 1;
+
+    for (;;) {
+        if (*p >= 0x20 && *p < 0x7F) {
+            p++;
+#if ASCII_BLOCK != 0
+            /* a run of printable ASCII, not a space between words of
+             * other scripts */
+            if (*p >= 0x20 && *p < 0x7F) {
+                while (ASCII_BLOCK_SAFE(p)) {
+                    size_t cnt = tab_plain_prefix(p);
+                    p += cnt;
+                    if (cnt != ASCII_BLOCK) {
+                        break;
+                    }
                 }
+            }
+#endif
+            continue;
+        }
+        if (*p == '\0') {
+            break;
+        }
 
-                ++used;
+        if (*p == '\t') {
+            size_t spaces = tab_sz;
+            if (flags & UTF8_TAB_STOPS) {
+                column += plain ? (size_t)(p - line) : tab_span_width(line, (size_t)(p - line), flags);
+                spaces = tab_sz - column % tab_sz;
+                column += spaces;
             }
-        } else {
-            if (dst_sz != NULL && *dst_sz != 0 && *dst_sz <= used + len) {
+            size_t len = (size_t)(p - copied);
+            if (dst_sz != NULL && *dst_sz != 0 && *dst_sz <= used + len + spaces) {
                 return UTF8_BUFFER_SMALL;
             }
-
             if (udst != NULL) {
-                utf8proc_encode_char(cp, udst);
-                udst += len;
+                memcpy(udst, copied, len);
+                memset(udst + len, ' ', spaces);
+                udst += len + spaces;
             }
-
-            used += len;
+            used += len + spaces;
+            p++;
+            copied = line = p;
+            plain = 1;
+            continue;
         }
 
-        usrc += len;
+        size_t cnt = 1;
+        int newline = (*p >= '\n' && *p <= '\r');
+        if (*p >= 0x80) {
+            cnt = tab_char_length(p);
+            if (cnt == 0) {
+                return UTF8_INVALID_UTF;
+            }
+            newline = (p[0] == 0xC2 && p[1] == 0x85)
+                || (p[0] == 0xE2 && p[1] == 0x80 && (p[2] == 0xA8 || p[2] == 0xA9));
+        }
+        p += cnt;
+        /* LF, VT, FF, CR, NEL, LS and PS start a new line */
+        if (newline) {
+            line = p;
+            column = 0;
+            plain = 1;
+        } else {
+            plain = 0;
+        }
     }
 
+    size_t len = (size_t)(p - copied);
+    if (dst_sz != NULL && *dst_sz != 0 && *dst_sz <= used + len) {
+        return UTF8_BUFFER_SMALL;
+    }
+    if (udst != NULL) {
+        memcpy(udst, copied, len);
+        udst[len] = '\0';
+    }
+    used += len;
     if (dst_sz != NULL) {
         *dst_sz = used;
     }
@@ -1090,7 +4289,10 @@ enum utf8_result utf8str_lstrip(char *str, const char *what) {
     return UTF8_OK;
 }
 
-enum utf8_result utf8str_rjustify(char *str, const char *with, size_t sz) {
+/* Adds characters of the fill, repeated from its start, to the beginning
+ * and the end of str until it is sz characters long: the text moves once
+ * and every byte of the fill is written once */
+static enum utf8_result justify_chars(char *str, const char *with, size_t sz, enum utf8_pad_mode mode) {
     if (str == NULL) {
         return UTF8_INVALID_ARG;
     }
@@ -1109,91 +4311,31 @@ enum utf8_result utf8str_rjustify(char *str, const char *with, size_t sz) {
         return UTF8_TOO_LONG;
     }
 
-    size_t to_add = sz - str_len;
-    while (to_add > 0) {
-        if (to_add >= fill_len) {
-            strcat(str, filling);
-            to_add -= fill_len;
-        } else {
-            strncat(str, filling, to_add);
-            to_add = 0;
-        }
+    size_t add = sz - str_len;
+    size_t left = (mode == UTF8_PAD_START) ? add : (mode == UTF8_PAD_BOTH) ? add / 2 : 0;
+    size_t fill_sz = strlen(filling), str_sz = strlen(str);
+    size_t left_sz = fill_chars_size(filling, fill_sz, fill_len, left);
+    size_t right_sz = fill_chars_size(filling, fill_sz, fill_len, add - left);
+    if (left_sz > 0) {
+        memmove(str + left_sz, str, str_sz);
+        fill_repeat(str, filling, fill_sz, left_sz);
     }
+    fill_repeat(str + left_sz + str_sz, filling, fill_sz, right_sz);
+    str[left_sz + str_sz + right_sz] = '\0';
 
     return UTF8_OK;
 }
 
-enum utf8_result utf8str_ljustify(char *str, const char *with, size_t sz) {
-    if (str == NULL) {
-        return UTF8_INVALID_ARG;
-    }
-
-    const char *filling = (with == NULL || *with == '\0') ? " " : with;
-    size_t fill_len = utf8str_count(filling);
-    if (fill_len == (size_t)-1) {
-        return UTF8_INVALID_UTF;
-    }
-    size_t str_len = utf8str_count(str);
-    if (str_len == (size_t)-1) {
-        return UTF8_INVALID_UTF;
-    }
-
-    if (str_len > sz) {
-        return UTF8_TOO_LONG;
-    }
-
-    size_t add_cnt = (sz - str_len - 1) / fill_len + 1;
-    size_t total_bytes = strlen(str) + add_cnt * strlen(filling) + 1;
-    char *new_value = (char *)malloc(total_bytes);
-    if (new_value == NULL)
-        return UTF8_OUT_OF_MEMORY;
-
-    *new_value = '\0';
-    size_t to_add = sz - str_len;
-    while (to_add > 0) {
-        if (to_add >= fill_len) {
-            strcat(new_value, filling);
-            to_add -= fill_len;
-        } else {
-            strncat(new_value, filling, to_add);
-            to_add = 0;
-        }
-    }
-    strcat(new_value, str);
-    strcpy(str, new_value);
-    free(new_value);
+enum utf8_result utf8str_rjustify(char *str, const char *with, size_t sz) {
+    return justify_chars(str, with, sz, UTF8_PAD_END);
+}
 
-    return UTF8_OK;
+enum utf8_result utf8str_ljustify(char *str, const char *with, size_t sz) {
+    return justify_chars(str, with, sz, UTF8_PAD_START);
 }
 
 enum utf8_result utf8str_justify(char *str, const char *with, size_t sz) {
-    if (str == NULL) {
-        return UTF8_INVALID_ARG;
-    }
-
-    const char *filling = (with == NULL || *with == '\0') ? " " : with;
-    size_t fill_len = utf8str_count(filling);
-    if (fill_len == (size_t)-1) {
-        return UTF8_INVALID_UTF;
-    }
-    size_t str_len = utf8str_count(str);
-    if (str_len == (size_t)-1) {
-        return UTF8_INVALID_UTF;
-    }
-
-    if (str_len > sz) {
-        return UTF8_TOO_LONG;
-    }
-
-    size_t add_cnt = sz - str_len;
-    size_t left_add = add_cnt / 2;
-
-    enum utf8_result res = utf8str_rjustify(str, filling, sz - left_add);
-    if (res != UTF8_OK)
-        return res;
-    res = utf8str_ljustify(str, filling, sz);
-
-    return res;
+    return justify_chars(str, with, sz, UTF8_PAD_BOTH);
 }
 
 enum utf8_result utf8str_mjustify(char *str, size_t sz) {
@@ -1210,85 +4352,43 @@ enum utf8_result utf8str_mjustify(char *str, size_t sz) {
     if (str_len == sz)
         return UTF8_OK;
 
-    size_t word_count = utf8str_word_count(str, " ");
+    int word_count = utf8str_word_count(str, " ");
     if (word_count < 2)
         return UTF8_NO_WORDS;
 
-    size_t new_size = (strlen(str) + sz - str_len + 1) * sizeof(char);
-    char *new_str = (char *)malloc(new_size);
-    if (new_str == NULL)
-        return UTF8_OUT_OF_MEMORY;
-    new_str[new_size - 1] = '\0';
-
-    float step = (float)(sz - str_len) / (float)(word_count - 1);
-    float curr = 0.0f;
-    int space_left = sz - str_len;
-    int words_left = word_count - 1;
-
-    utf8proc_uint8_t *usrc = (utf8proc_uint8_t*)str;
-    utf8proc_uint8_t *udst = (utf8proc_uint8_t*)new_str;
-    utf8proc_int32_t cpsrc, cpdst;
-    size_t lendst, len;
-
-    enum utf8_result res = UTF8_OK;
-    while (space_left > 0 && *usrc != '\0') {
-        size_t extra = (int)curr;
-        curr -= (float)extra;
-        space_left -= extra;
-
-        cpdst = 0x20;
-        while (extra) {
-            lendst = utf8proc_encode_char(cpdst, udst);
-            udst += lendst;
-            --extra;
-        }
-
-        do {
-            len = utf8proc_iterate(usrc, -1, &cpsrc);
-            if (cpsrc == -1) {
-                res = UTF8_INVALID_UTF;
-                break;
+    /* The text moves from its end to the new end, a run at a time, and the
+     * gaps between words get the spaces: gap k of n gets
+     * k * add / n - (k - 1) * add / n of them, the later gaps one more if
+     * they cannot be even. The text before the first gap that grows stays */
+    size_t add = sz - str_len, gaps = (size_t)word_count - 1, gap = gaps;
+    size_t src = strlen(str), dst = src + add;
+    int after_word = 0;
+    str[dst] = '\0';
+    while (dst > src && src > 0) {
+        size_t run = src;
+        if (str[src - 1] == ' ') {
+            while (run > 0 && str[run - 1] == ' ') {
+                run--;
             }
-
-            if (cpsrc == 0x20) {
-                lendst = utf8proc_encode_char(cpsrc, udst);
-                udst += lendst;
-                usrc += len;
+            size_t extra = 0;
+            if (after_word && run > 0) {
+                extra = gap * add / gaps - (gap - 1) * add / gaps;
+                gap--;
             }
-        } while (cpsrc == 0x20);
-
-        if (res != UTF8_OK)
-            break;
-
-        do {
-            len = utf8proc_iterate(usrc, -1, &cpsrc);
-            if (cpsrc == -1) {
-                res = UTF8_INVALID_UTF;
-                break;
+            dst -= src - run + extra;
+            memset(str + dst, ' ', src - run + extra);
+        } else {
+            while (run > 0 && str[run - 1] != ' ') {
+                run--;
             }
-
-            if (cpsrc == 0x20 || cpsrc == 0x00)
-                break;
-
-            lendst = utf8proc_encode_char(cpsrc, udst);
-            udst += lendst;
-            usrc += len;
-        } while (cpsrc != 0x00);
-
-        if (res != UTF8_OK)
-            break;
-
-        --words_left;
-        curr += step;
-        if (words_left == 0)
-            curr = space_left;
+            dst -= src - run;
+            memmove(str + dst, str + run, src - run);
+            after_word = 1;
+        }
+        src = run;
     }
-    *udst = '\0';
 
-    if (res == UTF8_OK)
-        strcpy(str, new_str);
-    free(new_str);
-    return res;
+    return UTF8_OK;
 }
 
 struct utf8str_iter_t* utf8str_iter_init(char *str, const char *include,
@@ -0,0 +1,916 @@
+/* Generated by tools/utf8classgen.c from utf8proc 2.0.2 data.
+ * Do not edit: run utf8classgen to regenerate.
+ * Size: 20672 bytes(top 4352, middle 8000, leaves 8320)
+ */
+
+const utf8proc_uint8_t utf8str_class_top[] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  16, 17, 18, 19, 20, 17, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+  31, 32, 33, 34, 35, 33, 33, 36, 33, 37, 33, 38, 39, 40, 41, 42,
+  43, 44, 45, 33, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 46, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 47,
+  48, 17, 17, 17, 49, 17, 50, 51, 52, 53, 54, 55, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 56, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 17, 58, 59, 17, 60, 61, 62,
+  63, 64, 65, 66, 67, 68, 17, 69, 70, 71, 72, 73, 74, 57, 75, 57,
+  76, 77, 78, 79, 80, 81, 82, 83, 84, 57, 85, 57, 86, 57, 57, 57,
+  17, 17, 17, 87, 88, 89, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  17, 17, 17, 17, 90, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 17, 17, 91, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 17, 17, 92, 93, 57, 57, 57, 94,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 95, 17, 17, 96, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  97, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 98, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  99, 100, 101, 102, 103, 104, 105, 106, 33, 33, 107, 57, 57, 57, 57, 57,
+  108, 57, 57, 57, 57, 57, 57, 57, 109, 110, 57, 57, 57, 57, 111, 57,
+  112, 113, 114, 33, 33, 33, 115, 116, 117, 118, 57, 57, 57, 57, 57, 57,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 119, 17, 17, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 120, 121, 17, 17, 17, 17, 17, 17, 17,
+  17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 122, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 17, 17, 123, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 124, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+};
+
+const utf8proc_uint16_t utf8str_class_mid[] = {
+  0, 1, 0, 0, 2, 3, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+  0, 0, 0, 0, 12, 13, 14, 15, 7, 7, 16, 17, 10, 10, 18, 10,
+  19, 19, 19, 19, 19, 19, 19, 20, 20, 21, 19, 19, 19, 19, 19, 22,
+  23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 20, 33, 19, 19, 23, 19,
+  19, 19, 19, 19, 19, 19, 34, 35, 36, 19, 10, 10, 10, 10, 10, 10,
+  10, 10, 37, 10, 10, 10, 38, 38, 39, 38, 40, 41, 42, 43, 41, 41,
+  44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 45, 46,
+  47, 48, 49, 7, 50, 51, 10, 10, 10, 52, 53, 19, 19, 19, 54, 55,
+  7, 7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 10, 19, 19, 19, 19,
+  56, 57, 19, 19, 19, 19, 19, 19, 58, 59, 19, 19, 19, 19, 19, 19,
+  19, 19, 19, 19, 19, 19, 60, 7, 7, 7, 61, 62, 63, 10, 10, 10,
+  10, 64, 65, 44, 44, 44, 44, 66, 67, 68, 69, 69, 69, 70, 71, 68,
+  72, 73, 44, 74, 69, 69, 69, 69, 75, 76, 44, 44, 4, 77, 78, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 79, 80, 81, 82, 4, 83,
+  84, 85, 86, 69, 69, 69, 44, 44, 44, 87, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 88, 44, 89, 68, 4, 90, 69, 69, 69, 76, 91, 92,
+  69, 69, 88, 93, 94, 95, 84, 96, 69, 69, 69, 97, 68, 68, 68, 68,
+  68, 68, 68, 68, 69, 69, 98, 99, 68, 68, 100, 44, 101, 44, 44, 44,
+  102, 69, 69, 69, 69, 69, 69, 103, 44, 44, 104, 69, 105, 4, 106, 69,
+  107, 108, 109, 69, 69, 110, 111, 112, 113, 114, 115, 116, 117, 4, 118, 119,
+  120, 121, 109, 69, 69, 110, 122, 123, 124, 125, 126, 127, 128, 4, 129, 68,
+  120, 130, 131, 69, 69, 110, 132, 112, 133, 134, 135, 68, 117, 4, 136, 137,
+  120, 108, 109, 69, 69, 110, 132, 112, 113, 125, 138, 116, 117, 4, 139, 68,
+  140, 141, 142, 143, 144, 141, 69, 145, 146, 147, 148, 68, 128, 4, 149, 150,
+  151, 98, 110, 69, 69, 110, 69, 152, 153, 147, 154, 70, 117, 4, 68, 155,
+  107, 98, 110, 69, 69, 110, 156, 112, 153, 147, 154, 157, 117, 4, 158, 68,
+  120, 98, 110, 69, 69, 69, 69, 159, 153, 160, 161, 162, 117, 4, 163, 164,
+  165, 69, 166, 167, 69, 69, 131, 168, 166, 169, 170, 44, 128, 4, 171, 68,
+  172, 69, 69, 69, 69, 69, 173, 174, 175, 176, 4, 177, 68, 68, 68, 68,
+  178, 179, 180, 172, 181, 182, 173, 183, 184, 185, 4, 186, 68, 68, 68, 68,
+  187, 84, 188, 189, 4, 190, 191, 192, 69, 172, 69, 69, 69, 193, 65, 44,
+  194, 195, 44, 65, 44, 44, 44, 196, 197, 198, 199, 200, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 76, 44, 201, 4, 202, 88, 203, 204, 205, 206, 69,
+  207, 208, 4, 209, 7, 7, 7, 7, 210, 211, 69, 69, 69, 69, 69, 212,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 142, 166, 142, 69, 69, 69, 69,
+  69, 142, 69, 69, 69, 69, 142, 166, 142, 69, 166, 69, 69, 69, 69, 69,
+  69, 69, 142, 69, 69, 69, 69, 69, 69, 69, 69, 213, 84, 214, 163, 215,
+  69, 69, 41, 216, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 217, 218,
+  219, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 220, 69, 69,
+  221, 69, 69, 71, 69, 69, 69, 69, 69, 69, 69, 69, 69, 222, 223, 135,
+  69, 98, 224, 68, 69, 69, 225, 68, 69, 69, 226, 68, 69, 98, 227, 68,
+  69, 69, 69, 69, 69, 69, 228, 44, 44, 44, 229, 230, 4, 231, 163, 232,
+  84, 233, 4, 231, 69, 69, 69, 69, 234, 69, 69, 69, 69, 69, 69, 68,
+  235, 69, 69, 69, 69, 236, 69, 69, 69, 69, 69, 69, 69, 69, 99, 68,
+  69, 69, 69, 166, 44, 237, 44, 237, 238, 4, 69, 69, 69, 99, 193, 68,
+  69, 69, 69, 69, 69, 239, 69, 69, 69, 240, 4, 241, 41, 41, 41, 41,
+  69, 69, 242, 243, 69, 69, 69, 69, 69, 69, 195, 244, 44, 44, 44, 113,
+  4, 231, 4, 231, 245, 85, 44, 246, 68, 68, 68, 68, 68, 68, 68, 68,
+  247, 69, 69, 69, 69, 69, 228, 44, 247, 239, 4, 202, 248, 249, 250, 251,
+  252, 69, 69, 69, 104, 205, 4, 90, 69, 69, 69, 69, 88, 44, 237, 253,
+  69, 69, 69, 69, 228, 44, 44, 254, 4, 255, 4, 90, 69, 69, 69, 256,
+  10, 257, 68, 68, 68, 68, 68, 68, 84, 68, 258, 44, 44, 259, 260, 261,
+  10, 10, 10, 10, 10, 262, 38, 38, 38, 38, 38, 38, 38, 263, 10, 264,
+  10, 10, 10, 265, 38, 38, 38, 38, 44, 44, 44, 44, 44, 44, 185, 266,
+  19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+  19, 19, 267, 268, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+  10, 7, 218, 217, 10, 7, 10, 7, 218, 217, 10, 269, 10, 7, 10, 218,
+  10, 7, 10, 7, 10, 7, 270, 271, 272, 273, 274, 275, 10, 273, 276, 277,
+  278, 279, 84, 84, 84, 280, 84, 281, 282, 84, 283, 284, 68, 68, 285, 286,
+  163, 287, 38, 288, 41, 41, 41, 289, 68, 68, 44, 290, 291, 44, 292, 68,
+  293, 294, 295, 296, 297, 298, 299, 300, 301, 302, 163, 163, 163, 163, 163, 163,
+  303, 119, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 304, 41, 41, 41, 305, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 289,
+  41, 41, 41, 41, 289, 68, 68, 68, 41, 150, 68, 68, 163, 163, 163, 163,
+  163, 163, 163, 306, 41, 41, 41, 41, 41, 41, 41, 41, 41, 307, 163, 163,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 84, 308, 163,
+  163, 163, 306, 41, 41, 41, 41, 41, 309, 41, 41, 41, 310, 84, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  311, 84, 84, 248, 41, 41, 41, 41, 41, 41, 41, 304, 41, 41, 41, 312,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 313, 41,
+  41, 41, 314, 41, 41, 41, 41, 315, 41, 316, 216, 68, 68, 317, 68, 68,
+  7, 7, 7, 7, 7, 61, 10, 10, 10, 10, 10, 318, 319, 320, 321, 322,
+  19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 323, 324, 325, 326,
+  10, 10, 10, 10, 327, 328, 69, 69, 69, 69, 69, 69, 69, 329, 330, 115,
+  69, 69, 166, 68, 166, 166, 166, 166, 166, 166, 166, 166, 44, 44, 44, 44,
+  84, 84, 84, 84, 84, 245, 84, 84, 331, 68, 68, 68, 68, 68, 68, 68,
+  41, 41, 41, 332, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 333, 68,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 314, 68, 68, 68, 41, 333,
+  334, 84, 335, 84, 336, 337, 338, 339, 172, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 166, 340, 219, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 341,
+  342, 69, 69, 69, 69, 99, 172, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 166, 343, 41, 69, 69, 69, 70, 41, 41, 41, 41, 333, 68, 69, 69,
+  41, 41, 41, 289, 163, 344, 41, 41, 41, 163, 336, 163, 41, 41, 41, 41,
+  163, 344, 41, 41, 41, 41, 336, 163, 41, 41, 41, 41, 41, 41, 41, 289,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 99, 68, 41, 41, 41, 41, 41, 41, 41, 41,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 99, 68, 68, 68, 68, 68,
+  69, 69, 345, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 193, 41, 41, 41, 41, 41, 41, 289, 68, 69, 69, 69, 69, 69, 256,
+  69, 346, 69, 69, 4, 347, 68, 68, 19, 19, 19, 19, 19, 348, 349, 350,
+  19, 19, 19, 351, 69, 69, 69, 69, 69, 69, 69, 69, 352, 163, 353, 68,
+  41, 41, 354, 38, 355, 19, 21, 19, 19, 19, 19, 19, 19, 19, 264, 356,
+  19, 357, 358, 19, 19, 359, 360, 68, 68, 68, 68, 68, 68, 68, 361, 362,
+  363, 364, 69, 69, 76, 333, 365, 216, 69, 69, 69, 69, 69, 69, 366, 68,
+  367, 69, 69, 69, 69, 69, 228, 44, 185, 368, 4, 231, 44, 44, 367, 369,
+  4, 90, 69, 69, 88, 370, 69, 69, 242, 44, 237, 371, 69, 69, 69, 193,
+  102, 69, 69, 69, 69, 69, 76, 44, 372, 373, 4, 374, 375, 69, 4, 376,
+  69, 69, 69, 69, 69, 104, 244, 68, 364, 377, 4, 378, 69, 69, 379, 380,
+  69, 69, 69, 69, 69, 69, 204, 381, 236, 68, 68, 382, 69, 76, 383, 68,
+  384, 384, 384, 68, 166, 166, 10, 10, 10, 10, 10, 385, 218, 68, 10, 10,
+  10, 10, 10, 10, 10, 10, 10, 10, 69, 69, 69, 69, 76, 386, 4, 231,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 239, 68, 69, 69, 166, 387, 69, 69, 69, 69, 69, 239,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 99, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 240, 68, 68, 68, 68,
+  318, 68, 388, 389, 69, 390, 166, 391, 392, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 393, 41, 216, 68, 387, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 394, 68, 68, 69, 69, 69, 69, 69, 69,
+  69, 69, 167, 69, 69, 69, 69, 69, 69, 68, 68, 68, 68, 68, 69, 395,
+  44, 44, 84, 396, 44, 44, 397, 84, 84, 398, 399, 84, 400, 401, 98, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 193,
+  402, 3, 4, 5, 6, 7, 7, 8, 9, 10, 10, 403, 404, 69, 75, 69,
+  69, 69, 69, 405, 69, 69, 69, 166, 167, 167, 167, 406, 289, 289, 68, 407,
+  69, 156, 69, 69, 166, 69, 69, 408, 69, 99, 69, 99, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 70,
+  409, 163, 163, 163, 163, 163, 410, 41, 163, 163, 163, 163, 163, 163, 163, 411,
+  41, 412, 41, 333, 413, 68, 68, 68, 68, 68, 41, 41, 41, 41, 41, 414,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 193, 69, 69, 69, 69, 69, 69, 135, 68, 415, 163, 163, 416,
+  69, 69, 69, 69, 416, 68, 69, 69, 417, 418, 69, 69, 69, 69, 88, 419,
+  69, 69, 69, 420, 69, 69, 69, 69, 239, 69, 421, 68, 68, 68, 68, 68,
+  7, 7, 7, 7, 7, 10, 10, 10, 10, 10, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 99, 4, 231, 7, 7, 7, 7, 422, 10, 10, 10, 10, 423,
+  69, 69, 69, 69, 69, 68, 69, 69, 69, 69, 69, 69, 239, 371, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 166, 68, 69, 69, 99, 68, 69, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  99, 110, 69, 69, 69, 69, 130, 424, 69, 69, 420, 163, 69, 69, 425, 336,
+  69, 69, 69, 166, 426, 163, 68, 68, 68, 68, 68, 68, 69, 69, 427, 428,
+  69, 69, 352, 429, 69, 69, 69, 430, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 431, 163, 163, 432, 163, 163, 163, 163, 163,
+  433, 100, 156, 172, 69, 69, 239, 124, 163, 68, 84, 330, 69, 69, 69, 434,
+  69, 69, 69, 435, 68, 68, 68, 68, 69, 436, 69, 69, 437, 428, 96, 68,
+  69, 69, 69, 69, 69, 69, 99, 438, 69, 69, 99, 163, 69, 69, 70, 163,
+  69, 69, 240, 439, 68, 440, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 135, 68, 68, 68, 68, 68, 68,
+  7, 7, 7, 7, 7, 7, 441, 68, 10, 10, 10, 10, 10, 10, 442, 432,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 163, 163, 163, 443,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  252, 69, 69, 69, 69, 69, 69, 44, 176, 85, 432, 163, 444, 4, 68, 115,
+  252, 69, 69, 69, 69, 69, 44, 445, 396, 68, 69, 69, 69, 135, 4, 231,
+  252, 69, 69, 69, 242, 44, 446, 4, 447, 68, 69, 69, 69, 69, 448, 68,
+  252, 69, 69, 69, 69, 69, 76, 44, 449, 450, 4, 451, 440, 163, 215, 68,
+  69, 69, 131, 69, 69, 228, 44, 452, 68, 68, 68, 68, 68, 68, 68, 68,
+  166, 453, 69, 130, 69, 454, 69, 69, 69, 69, 69, 242, 44, 419, 4, 231,
+  151, 108, 109, 69, 69, 110, 132, 112, 113, 125, 148, 342, 455, 456, 456, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 195, 44, 201, 457, 4, 458, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 44, 44, 459, 68, 4, 231, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 242, 185, 44, 372, 84, 84, 377, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 44, 44, 460, 68, 4, 231, 84, 331, 68, 68,
+  69, 69, 69, 69, 69, 76, 44, 68, 4, 231, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 461, 44, 237, 4, 462, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 7, 7, 7, 7, 10, 10, 10, 10, 4, 190, 463, 361,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 69, 69, 69, 69, 69, 69, 69, 135,
+  69, 110, 69, 69, 69, 242, 244, 44, 464, 68, 4, 190, 163, 215, 465, 69,
+  69, 69, 466, 44, 44, 65, 244, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 240, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 163, 443, 331, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 239, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 166, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 166, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 135, 69, 69, 69, 166, 4, 374, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 69, 69, 69, 99, 467, 68,
+  69, 69, 69, 69, 69, 69, 176, 304, 468, 68, 4, 469, 470, 69, 69, 342,
+  69, 69, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 193, 68, 104, 44, 44, 44, 44, 244,
+  68, 115, 471, 38, 68, 68, 68, 68, 68, 68, 68, 68, 472, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 193, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 70, 68,
+  240, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 70, 69, 193,
+  69, 135, 69, 473, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 314, 68,
+  41, 41, 41, 41, 289, 474, 41, 41, 41, 41, 41, 41, 475, 476, 419, 266,
+  477, 250, 41, 41, 41, 478, 41, 41, 41, 41, 41, 41, 41, 413, 68, 68,
+  41, 41, 41, 41, 41, 41, 41, 41, 479, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 289, 68, 163, 163, 232, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  7, 7, 7, 480, 10, 10, 481, 7, 7, 482, 270, 10, 10, 7, 7, 7,
+  480, 10, 10, 483, 484, 485, 482, 486, 487, 10, 7, 7, 7, 480, 10, 10,
+  488, 489, 490, 491, 10, 10, 10, 492, 493, 494, 495, 10, 10, 481, 7, 7,
+  482, 10, 10, 10, 7, 7, 7, 480, 10, 10, 481, 7, 7, 482, 10, 10,
+  10, 7, 7, 7, 480, 10, 10, 481, 7, 7, 482, 10, 10, 10, 7, 7,
+  7, 480, 10, 10, 218, 7, 7, 7, 496, 10, 10, 497, 498, 7, 7, 499,
+  10, 10, 500, 481, 7, 7, 501, 10, 10, 18, 502, 7, 7, 16, 10, 10,
+  10, 503, 7, 7, 7, 496, 10, 10, 497, 504, 4, 4, 4, 4, 4, 4,
+  44, 44, 44, 44, 44, 44, 505, 249, 44, 44, 44, 44, 44, 506, 507, 41,
+  508, 447, 68, 266, 65, 44, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  244, 44, 44, 509, 510, 419, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 511, 163, 244, 68, 68, 68, 68, 68,
+  7, 7, 7, 7, 480, 10, 10, 10, 512, 419, 4, 374, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  156, 69, 69, 69, 178, 172, 513, 514, 515, 516, 178, 517, 178, 513, 513, 127,
+  69, 131, 69, 239, 518, 131, 69, 239, 68, 68, 68, 68, 68, 68, 216, 68,
+  41, 41, 41, 41, 41, 333, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 41, 333, 68, 41, 289, 474, 41, 474, 41, 474, 41, 41, 41, 314, 68,
+  163, 215, 41, 41, 41, 289, 41, 41, 41, 41, 41, 41, 41, 333, 41, 41,
+  41, 41, 41, 41, 41, 251, 68, 68, 68, 68, 68, 68, 72, 41, 41, 41,
+  150, 68, 41, 41, 41, 41, 41, 333, 41, 413, 216, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 150, 68, 41, 251, 289, 68,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 333, 68,
+  41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 251, 68, 68, 68, 68, 68,
+  41, 333, 41, 41, 41, 41, 41, 41, 41, 68, 41, 216, 41, 41, 41, 41,
+  41, 68, 41, 41, 41, 314, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 41, 289, 41, 68, 519, 289, 41, 333, 41, 289, 68, 68, 68, 68,
+  41, 41, 216, 68, 68, 68, 68, 68, 413, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 166, 68, 68, 68, 68, 68,
+  69, 69, 69, 69, 69, 69, 193, 68, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 99, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69,
+  69, 69, 69, 69, 240, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  69, 69, 69, 99, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44,
+  44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 68, 68,
+};
+
+const utf8proc_uint16_t utf8str_class_leaf[] = {
+  0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0042, 0x0042, 0x0042,
+  0x0042, 0x0042, 0x0040, 0x0040, 0x0002, 0x0084, 0x0084, 0x0084, 0x0480, 0x0084, 0x0084, 0x0084,
+  0x0084, 0x0084, 0x0084, 0x0480, 0x0084, 0x0084, 0x0084, 0x0084, 0x0181, 0x0181, 0x0181, 0x0181,
+  0x0181, 0x0181, 0x0181, 0x0181, 0x0181, 0x0181, 0x0084, 0x0084, 0x0480, 0x0480, 0x0480, 0x0084,
+  0x0084, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0084, 0x0084, 0x0084, 0x0480, 0x0184,
+  0x0480, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0084, 0x0480, 0x0084, 0x0480, 0x0040,
+  0x0002, 0x0084, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0084, 0x0480, 0x0480, 0x0188, 0x0084,
+  0x0480, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480, 0x0081, 0x0081, 0x0480, 0x09A8, 0x0084, 0x0084,
+  0x0480, 0x0081, 0x0188, 0x0084, 0x0081, 0x0081, 0x0081, 0x0084, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0998, 0x0998, 0x0480, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0480, 0x0998, 0x09A8, 0x0998, 0x09A8,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998,
+  0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998,
+  0x09A8, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998,
+  0x09A8, 0x0998, 0x0998, 0x0998, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998, 0x09A8, 0x0998,
+  0x0998, 0x09A8, 0x0998, 0x0998, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8,
+  0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998, 0x0998, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998,
+  0x0998, 0x09A8, 0x09A8, 0x0188, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0998, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998,
+  0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8,
+  0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x0188, 0x09A8, 0x09A8, 0x09A8, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100,
+  0x0100, 0x0100, 0x0480, 0x0480, 0x0480, 0x0480, 0x0100, 0x0100, 0x0100, 0x0100, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0100, 0x0480, 0x0100, 0x0480, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x0100, 0x0480, 0x0998, 0x09A8, 0x0000, 0x0000, 0x0100, 0x09A8,
+  0x09A8, 0x09A8, 0x0084, 0x0998, 0x0000, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0998, 0x0084,
+  0x0998, 0x0998, 0x0998, 0x0000, 0x0998, 0x0000, 0x0998, 0x0998, 0x09A8, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0998, 0x09A8, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0480, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8,
+  0x09A8, 0x0998, 0x0998, 0x0998, 0x0998, 0x09A8, 0x0480, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0200, 0x0200, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0998,
+  0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8,
+  0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0998, 0x0998, 0x0000, 0x0000, 0x0100, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0000, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x0084, 0x0084, 0x0000,
+  0x0000, 0x0480, 0x0480, 0x0480, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0084, 0x0300, 0x0084, 0x0300, 0x0300, 0x0084,
+  0x0300, 0x0300, 0x0084, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0084, 0x0084, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0480, 0x0084, 0x0084, 0x0480,
+  0x0084, 0x0084, 0x0480, 0x0480, 0x0300, 0x0300, 0x0300, 0x0084, 0x0000, 0x0000, 0x0084, 0x0084,
+  0x0100, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0181, 0x0181, 0x0084, 0x0084, 0x0084, 0x0084, 0x0188, 0x0188,
+  0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0084, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0480, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0100, 0x0100, 0x0300, 0x0300, 0x0480, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0188, 0x0188, 0x0181, 0x0181, 0x0188, 0x0188, 0x0188, 0x0480, 0x0480, 0x0188,
+  0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0084, 0x0084, 0x0000, 0x0000, 0x0188, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0181, 0x0181, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0100, 0x0100, 0x0480, 0x0084, 0x0084, 0x0084, 0x0100, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0300, 0x0300, 0x0100, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0100, 0x0300, 0x0300, 0x0300, 0x0100, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000,
+  0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0000, 0x0188, 0x0300, 0x0300, 0x0300,
+  0x0000, 0x0000, 0x0084, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300,
+  0x0300, 0x0188, 0x0300, 0x0300, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0188, 0x0188, 0x0300, 0x0300, 0x0084, 0x0084, 0x0181, 0x0181, 0x0084, 0x0100, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0000, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0000, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0188, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000,
+  0x0300, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0300,
+  0x0300, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188,
+  0x0188, 0x0188, 0x0300, 0x0300, 0x0000, 0x0000, 0x0181, 0x0181, 0x0188, 0x0188, 0x0480, 0x0480,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0480, 0x0480, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0300, 0x0300, 0x0300, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0000,
+  0x0188, 0x0188, 0x0000, 0x0000, 0x0300, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000,
+  0x0000, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0181, 0x0181,
+  0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0300, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0000, 0x0300, 0x0300, 0x0300, 0x0000, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000,
+  0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0084, 0x0480, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0480, 0x0188, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0000, 0x0000, 0x0300, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0000, 0x0188, 0x0188,
+  0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0300, 0x0300,
+  0x0300, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0188, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0300, 0x0081, 0x0081, 0x0081, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0188, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0300, 0x0300, 0x0000, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0480,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0188, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0188, 0x0300, 0x0300, 0x0300, 0x0000, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0188, 0x0480, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0300,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0188, 0x0081, 0x0081, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0480, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0000, 0x0000, 0x0300, 0x0300, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0300, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0300, 0x0000,
+  0x0000, 0x0000, 0x0300, 0x0300, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0480, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0100, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0084,
+  0x0181, 0x0181, 0x0084, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000,
+  0x0188, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0000, 0x0000, 0x0188, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188,
+  0x0000, 0x0188, 0x0000, 0x0188, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188,
+  0x0300, 0x0300, 0x0000, 0x0300, 0x0300, 0x0188, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0100, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000,
+  0x0181, 0x0181, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0480, 0x0480, 0x0480,
+  0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0480, 0x0084, 0x0480, 0x0480, 0x0480,
+  0x0300, 0x0300, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0181, 0x0181, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0480, 0x0300, 0x0480, 0x0300,
+  0x0480, 0x0300, 0x0084, 0x0084, 0x0084, 0x0084, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0084, 0x0300, 0x0300,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0300, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0000, 0x0480, 0x0480, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0084, 0x0480, 0x0480, 0x0480, 0x0480, 0x0084, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0188, 0x0181, 0x0181, 0x0084, 0x0084,
+  0x0084, 0x0084, 0x0084, 0x0084, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300,
+  0x0300, 0x0188, 0x0300, 0x0300, 0x0300, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0188, 0x0300, 0x0181, 0x0181, 0x0300, 0x0300, 0x0300, 0x0300, 0x0480, 0x0480,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000, 0x0998, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0998, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0084, 0x0100, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0084, 0x0081, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0000, 0x0000, 0x0000,
+  0x0480, 0x0480, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0998, 0x0000, 0x0000, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x0000,
+  0x0084, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0084, 0x0084, 0x0188, 0x0002, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0084, 0x0084, 0x0084, 0x0081, 0x0081, 0x0081, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0084, 0x0084, 0x0000, 0x0188, 0x0188, 0x0300, 0x0300,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0000, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0084, 0x0084, 0x0084, 0x0100, 0x0084, 0x0084, 0x0084, 0x0480, 0x0188, 0x0300, 0x0000, 0x0000,
+  0x0181, 0x0181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0081, 0x0081, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0084, 0x0084, 0x0084, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0188, 0x0100, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0300, 0x0300, 0x0188, 0x0188, 0x0300, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0480, 0x0000, 0x0000, 0x0000,
+  0x0084, 0x0084, 0x0181, 0x0181, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0181, 0x0181, 0x0081, 0x0000,
+  0x0000, 0x0000, 0x0480, 0x0480, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0084, 0x0084, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0000, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0100,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0200, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0188, 0x0188, 0x0188, 0x0084, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0000, 0x0000, 0x0000,
+  0x0300, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0084, 0x0084, 0x0084, 0x0084, 0x0000, 0x0000, 0x0000, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0181, 0x0181, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0100, 0x0100, 0x0100, 0x0100,
+  0x0100, 0x0100, 0x0084, 0x0084, 0x09A8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0300, 0x0300, 0x0300, 0x0084, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0300, 0x0188, 0x0188, 0x0000,
+  0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x0100, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0100,
+  0x0100, 0x0100, 0x0100, 0x0100, 0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0000, 0x0998, 0x0000, 0x0998, 0x0000, 0x0998, 0x0000, 0x0998,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0480, 0x09A8, 0x0480, 0x0480, 0x0480, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x09A8, 0x09A8,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0480, 0x0480, 0x0480, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x0000, 0x0000, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000, 0x0480, 0x0480, 0x0480,
+  0x0000, 0x0000, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0480, 0x0480, 0x0000, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002, 0x0002,
+  0x0002, 0x0002, 0x0002, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0002, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0184,
+  0x0184, 0x0084, 0x0084, 0x0084, 0x0480, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0480, 0x0084,
+  0x0184, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0002,
+  0x0081, 0x0100, 0x0000, 0x0000, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0480, 0x0480,
+  0x0480, 0x0084, 0x0084, 0x0100, 0x0081, 0x0081, 0x0480, 0x0480, 0x0480, 0x0084, 0x0084, 0x0000,
+  0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0200, 0x0200, 0x0200,
+  0x0200, 0x0300, 0x0200, 0x0200, 0x0200, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0998, 0x0480, 0x0480, 0x0480, 0x0480, 0x0998,
+  0x0480, 0x0480, 0x09A8, 0x0998, 0x0998, 0x0998, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0998, 0x09A8,
+  0x0480, 0x0998, 0x0480, 0x0480, 0x0480, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0998, 0x0480, 0x0998, 0x0480, 0x0998, 0x0480, 0x0998, 0x0998,
+  0x0998, 0x0998, 0x0480, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998, 0x09A8, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x09A8, 0x0480, 0x0480, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0480, 0x0480, 0x0480, 0x0480, 0x09A8, 0x0480,
+  0x0081, 0x0081, 0x0081, 0x0998, 0x09A8, 0x0081, 0x0081, 0x0081, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0084, 0x0084, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0081, 0x0081,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0084, 0x0084, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0084, 0x0084, 0x0480, 0x0480, 0x0480, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0084, 0x0084, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0000, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0000, 0x0000,
+  0x0480, 0x0480, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480, 0x0000, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0000, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x0998, 0x09A8, 0x0998, 0x0998,
+  0x0998, 0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x0100, 0x0100, 0x0998, 0x0998, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0300, 0x0300, 0x0300, 0x0998, 0x09A8,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0084, 0x0084, 0x0084, 0x0084, 0x0081, 0x0084, 0x0084,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x09A8, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x09A8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0100,
+  0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0084, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0000, 0x0000, 0x0000, 0x0000, 0x0002, 0x0084, 0x0084, 0x0084,
+  0x0480, 0x0100, 0x0188, 0x0081, 0x0084, 0x0084, 0x0480, 0x0480, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0480, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0084, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0480, 0x0480,
+  0x0081, 0x0081, 0x0081, 0x0100, 0x0188, 0x0084, 0x0480, 0x0480, 0x0000, 0x0300, 0x0300, 0x0480,
+  0x0480, 0x0100, 0x0100, 0x0188, 0x0188, 0x0188, 0x0188, 0x0084, 0x0100, 0x0100, 0x0100, 0x0188,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0480, 0x0480, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0480, 0x0480, 0x0081, 0x0081, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0100, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0100, 0x0084, 0x0084, 0x0084, 0x0181, 0x0181, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0188, 0x0300, 0x0200, 0x0200, 0x0200, 0x0084,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0084, 0x0100,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x0100, 0x0100, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0081, 0x0081, 0x0300, 0x0300, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0100, 0x0480, 0x0480, 0x0998, 0x09A8,
+  0x0998, 0x09A8, 0x0998, 0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998, 0x09A8,
+  0x0100, 0x0480, 0x0480, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0188, 0x0998, 0x09A8, 0x0998, 0x09A8,
+  0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x09A8, 0x0998, 0x09A8, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0188, 0x0100, 0x0100, 0x09A8, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0300, 0x0188, 0x0188, 0x0188, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0480, 0x0480,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0084, 0x0084, 0x0084, 0x0084, 0x0300, 0x0300, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0084, 0x0084,
+  0x0084, 0x0084, 0x0084, 0x0188, 0x0084, 0x0188, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0084, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0084,
+  0x0300, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084,
+  0x0084, 0x0084, 0x0000, 0x0100, 0x0181, 0x0181, 0x0000, 0x0000, 0x0000, 0x0000, 0x0084, 0x0084,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0100, 0x0188, 0x0181, 0x0181, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0000, 0x0000,
+  0x0181, 0x0181, 0x0000, 0x0000, 0x0084, 0x0084, 0x0084, 0x0084, 0x0100, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0480, 0x0480, 0x0480, 0x0188, 0x0300, 0x0300, 0x0300, 0x0188, 0x0188,
+  0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0188,
+  0x0188, 0x0100, 0x0084, 0x0084, 0x0084, 0x0084, 0x0188, 0x0100, 0x0100, 0x0300, 0x0300, 0x0000,
+  0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x09A8, 0x09A8, 0x09A8, 0x0480,
+  0x0100, 0x0100, 0x0100, 0x0100, 0x0300, 0x0300, 0x0300, 0x0084, 0x0300, 0x0300, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0300, 0x0188,
+  0x0188, 0x0480, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0188, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0084, 0x0084, 0x0188, 0x0188, 0x0188, 0x0188, 0x0480, 0x0480, 0x0000, 0x0000,
+  0x0084, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0084, 0x0084, 0x0084, 0x0184,
+  0x0184, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0184, 0x0184, 0x0184,
+  0x0084, 0x0084, 0x0084, 0x0000, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0480, 0x0084,
+  0x0480, 0x0480, 0x0480, 0x0000, 0x0084, 0x0480, 0x0084, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0084, 0x0084, 0x0084, 0x0480, 0x0084, 0x0084, 0x0084, 0x09A8, 0x09A8, 0x09A8, 0x0084,
+  0x0480, 0x0084, 0x0480, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0100, 0x0100, 0x0000, 0x0000, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0480, 0x0480, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0000, 0x0188, 0x0084, 0x0084, 0x0084, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0000, 0x0000, 0x0000, 0x0480,
+  0x0081, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0081, 0x0081,
+  0x0480, 0x0480, 0x0480, 0x0000, 0x0480, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0300, 0x0000, 0x0000, 0x0300, 0x0081, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0081, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0081, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0084, 0x0084, 0x0081, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0000, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0000, 0x0000, 0x0000,
+  0x0188, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0480,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0081, 0x0188, 0x0188, 0x0188, 0x0000,
+  0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0000, 0x0000, 0x0000, 0x0084, 0x0188, 0x0188, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0081, 0x0081, 0x0188, 0x0188,
+  0x0000, 0x0000, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0188, 0x0300, 0x0300, 0x0300,
+  0x0000, 0x0300, 0x0300, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0081, 0x0081, 0x0084,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0081, 0x0081, 0x0081, 0x0480, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0300, 0x0300, 0x0000,
+  0x0000, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0000, 0x0084, 0x0084, 0x0084,
+  0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081,
+  0x0998, 0x0998, 0x0998, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x09A8, 0x09A8, 0x09A8, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0000,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0181, 0x0181, 0x0300, 0x0300, 0x0300, 0x0084,
+  0x0084, 0x0000, 0x0084, 0x0084, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0181, 0x0181,
+  0x0084, 0x0084, 0x0084, 0x0084, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0300,
+  0x0084, 0x0084, 0x0188, 0x0000, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188, 0x0084, 0x0084, 0x0084,
+  0x0084, 0x0084, 0x0300, 0x0300, 0x0300, 0x0084, 0x0000, 0x0000, 0x0181, 0x0181, 0x0188, 0x0084,
+  0x0188, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0300, 0x0000,
+  0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0084, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0300, 0x0300, 0x0000, 0x0000, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0188, 0x0084,
+  0x0084, 0x0084, 0x0084, 0x0084, 0x0181, 0x0181, 0x0000, 0x0084, 0x0000, 0x0084, 0x0000, 0x0000,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0188, 0x0188, 0x0084, 0x0188, 0x0300, 0x0084, 0x0084, 0x0084,
+  0x0188, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300,
+  0x0181, 0x0181, 0x0081, 0x0081, 0x0084, 0x0084, 0x0084, 0x0480, 0x0081, 0x0081, 0x0081, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0084, 0x0084, 0x0084, 0x0084, 0x0084, 0x0000, 0x0000,
+  0x0084, 0x0084, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0000, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0084, 0x0000, 0x0000,
+  0x0100, 0x0100, 0x0100, 0x0100, 0x0084, 0x0480, 0x0000, 0x0000, 0x0181, 0x0181, 0x0000, 0x0081,
+  0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0081, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0300, 0x0300, 0x0300, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0100, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0188, 0x0000, 0x0000, 0x0480, 0x0300, 0x0300, 0x0084,
+  0x0000, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0480, 0x0480, 0x0480, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0480, 0x0480, 0x0300, 0x0300, 0x0300, 0x0480, 0x0480, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0480, 0x0480, 0x0480, 0x0480, 0x0300, 0x0300, 0x0300, 0x0480, 0x0000, 0x0000,
+  0x0998, 0x0998, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0998, 0x0000, 0x0998, 0x0998, 0x0000, 0x0000, 0x0998, 0x0000,
+  0x0000, 0x0998, 0x0998, 0x0000, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000, 0x0998, 0x0998,
+  0x09A8, 0x09A8, 0x0000, 0x09A8, 0x0000, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x0000, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0998, 0x0998, 0x0000, 0x0998,
+  0x0998, 0x0998, 0x0998, 0x0000, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000, 0x09A8, 0x09A8,
+  0x0998, 0x0998, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0000, 0x0998, 0x0000, 0x0000, 0x0000, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998,
+  0x0998, 0x0000, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0998, 0x0480, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0480, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0480,
+  0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0480, 0x09A8, 0x09A8,
+  0x0998, 0x0998, 0x0998, 0x0998, 0x0998, 0x0480, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x0998, 0x0998, 0x09A8, 0x0480, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x09A8,
+  0x09A8, 0x09A8, 0x0998, 0x09A8, 0x0000, 0x0000, 0x0181, 0x0181, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0300, 0x0480, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0480, 0x0480, 0x0480,
+  0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0300, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+  0x0300, 0x0480, 0x0480, 0x0084, 0x0300, 0x0000, 0x0000, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0300, 0x0300, 0x0000, 0x0300, 0x0300, 0x0000, 0x0300, 0x0300, 0x0188, 0x0188, 0x0188, 0x0188,
+  0x0188, 0x0000, 0x0000, 0x0081, 0x09A8, 0x09A8, 0x09A8, 0x09A8, 0x0300, 0x0300, 0x0300, 0x0300,
+  0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0000, 0x0188,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188, 0x0000, 0x0000, 0x0000, 0x0000, 0x0188,
+  0x0000, 0x0188, 0x0000, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0000, 0x0188,
+  0x0000, 0x0188, 0x0000, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188, 0x0000, 0x0188, 0x0188, 0x0188,
+  0x0480, 0x0000, 0x0000, 0x0480, 0x0480, 0x0480, 0x0480, 0x0480,
+};
+
+static const utf8proc_uint8_t utf8str_class_ascii[12][16] = {
+  {0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+  {0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00},
+  {0x10, 0x04, 0x04, 0x04, 0x00, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0C, 0xA8, 0x24, 0xA4, 0x04, 0x2C},
+  {0xA0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x50, 0x50, 0x50, 0x50, 0x50},
+  {0x20, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x10, 0x10, 0x10, 0x10, 0x10},
+  {0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x40, 0x40, 0x40, 0x40, 0x40},
+  {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x83},
+  {0xF8, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0x7C},
+  {0xA8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF0, 0x50, 0x50, 0x50, 0x50, 0x70},
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+  {0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x88, 0x08, 0xA8, 0x00},
+  {0xA0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x50, 0x50, 0x50, 0x50, 0x50},
+};
+
+static const uint64_t utf8str_emoji_prefix[64] = {
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000420000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x000030107FC8D053ULL, 0x0000000000000401ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000080000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+  0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+};
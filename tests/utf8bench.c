@@ -0,0 +1,441 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include "utf8proc.h"
+#include "utf8string.h"
+
+#define BENCH_TEXT_REPEAT 200
+#define BENCH_ROUNDS 50
+
+static const char *bench_sample =
+    "The quick brown fox jumps over the lazy dog 0123456789. "
+    "Съешь же ещё этих мягких французских булок, да выпей чаю! "
+    "Ξεσκεπάζω την ψυχοφθόρα βδελυγμία; "
+    "日本語のテキスト、中文文本。한국어 텍스트 "
+    "\xe2\x80\x9cquotes\xe2\x80\x9d \xc2\xa0\xe2\x80\x83 \xf0\x9f\x98\x80\xf0\x9f\x8e\x89 "
+    "e\xcc\x81 \x01\x1f\t\n";
+
+/* The character classification as it was before the class table: a category
+ * lookup followed by a chain of comparisons */
+static int category_isalpha(const char *str) {
+    utf8proc_int32_t cp;
+    utf8proc_iterate((const utf8proc_uint8_t*)str, -1, &cp);
+    if (cp == -1) {
+        return 0;
+    }
+    utf8proc_category_t ctg = utf8proc_category(cp);
+    return ctg == UTF8PROC_CATEGORY_LU ||
+           ctg == UTF8PROC_CATEGORY_LL ||
+           ctg == UTF8PROC_CATEGORY_LO ||
+           ctg == UTF8PROC_CATEGORY_LT;
+}
+
+static int category_isprint(const char *str) {
+    utf8proc_int32_t cp;
+    utf8proc_iterate((const utf8proc_uint8_t*)str, -1, &cp);
+    if (cp == -1) {
+        return 0;
+    }
+    utf8proc_category_t ctg = utf8proc_category(cp);
+    return ctg != UTF8PROC_CATEGORY_CN &&
+           ctg != UTF8PROC_CATEGORY_LM &&
+           ctg != UTF8PROC_CATEGORY_MN &&
+           ctg != UTF8PROC_CATEGORY_ME &&
+           ctg != UTF8PROC_CATEGORY_MC &&
+           ctg != UTF8PROC_CATEGORY_ZS &&
+           ctg != UTF8PROC_CATEGORY_ZL &&
+           ctg != UTF8PROC_CATEGORY_ZP &&
+           ctg != UTF8PROC_CATEGORY_CC &&
+           ctg != UTF8PROC_CATEGORY_CF &&
+           ctg != UTF8PROC_CATEGORY_CO &&
+           ctg != UTF8PROC_CATEGORY_CS;
+}
+
+#if UTF8STR_WITH_CASE || UTF8STR_WITH_NORMALIZATION
+/* Reads the category from the full property record, as utf8proc_category
+ * did before the hot table */
+static int property_category(const char *str) {
+    utf8proc_int32_t cp;
+    utf8proc_iterate((const utf8proc_uint8_t*)str, -1, &cp);
+    return utf8proc_get_property(cp)->category;
+}
+
+#endif
+
+static int hot_category(const char *str) {
+    utf8proc_int32_t cp;
+    utf8proc_iterate((const utf8proc_uint8_t*)str, -1, &cp);
+    return utf8proc_category(cp);
+}
+
+#if UTF8STR_WITH_CASE
+static int hot_tolower(const char *str) {
+    utf8proc_int32_t cp;
+    utf8proc_iterate((const utf8proc_uint8_t*)str, -1, &cp);
+    return utf8proc_tolower(cp);
+}
+#endif
+
+static int class_isalnum(const char *str) {
+    return utf8str_isclass(str, UTF8_CLASS_ALPHA | UTF8_CLASS_DIGIT);
+}
+
+/* A tokenizer-like loop: decodes a character once and classifies the code
+ * point with the inline functions */
+static int class_cp_isword(const char *str) {
+    utf8proc_int32_t cp;
+    utf8proc_iterate((const utf8proc_uint8_t*)str, -1, &cp);
+    return utf8str_isalpha_cp(cp) || utf8str_isdigit_cp(cp) || utf8str_isclass_cp(cp, UTF8_CLASS_WORD);
+}
+
+/* Returns the number of entries of a trie level from the largest block index
+ * stored in the level above */
+static size_t table_entries(size_t max_index, int bits) {
+    return (max_index + 1) << bits;
+}
+
+struct bench_case {
+    const char *name;
+    int (*fn)(const char *);
+};
+
+static const struct bench_case bench_cases[] = {
+    {"category chain isalpha", category_isalpha},
+    {"category chain isprint", category_isprint},
+    {"utf8str_isalpha", utf8str_isalpha},
+    {"utf8str_isprint", utf8str_isprint},
+    {"utf8str_isspace", utf8str_isspace},
+    {"utf8str_isclass alnum", class_isalnum},
+    {"decode + utf8str_is*_cp", class_cp_isword},
+#if UTF8STR_WITH_CASE || UTF8STR_WITH_NORMALIZATION
+    {"utf8proc_get_property category", property_category},
+#endif
+    {"utf8proc_category", hot_category},
+#if UTF8STR_WITH_CASE
+    {"utf8proc_tolower", hot_tolower},
+#endif
+};
+
+/* Calls fn for every character of text, returns nanoseconds per call */
+static double bench_run(int (*fn)(const char *), const char **chars, size_t count, long *hits) {
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (size_t i = 0; i < count; i++) {
+            *hits += fn(chars[i]);
+        }
+    }
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    return elapsed * 1e9 / ((double)count * BENCH_ROUNDS);
+}
+
+/* Looks up the properties of every code point of the planes with assigned
+ * characters the way normalization does, returns nanoseconds per lookup. It
+ * shows the cost of the property table layout(see tools/utf8datagen.c) */
+#if UTF8STR_WITH_CASE || UTF8STR_WITH_NORMALIZATION
+#define BENCH_LOOKUP_END 0x30000
+
+static double bench_lookup(long *hits) {
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (utf8proc_int32_t cp = 0; cp < BENCH_LOOKUP_END; cp++) {
+            *hits += utf8proc_get_property(cp)->combining_class;
+        }
+    }
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    return elapsed * 1e9 / ((double)BENCH_LOOKUP_END * BENCH_ROUNDS);
+}
+#endif
+
+/* Splits text into runs of word and non-word characters the way lexers did
+ * before span functions, returns the number of runs */
+static long loop_runs(const char *text) {
+    long runs = 0;
+    while (*text) {
+        int word = utf8str_isclass(text, UTF8_CLASS_WORD);
+        while (*text && utf8str_isclass(text, UTF8_CLASS_WORD) == word) {
+            text = utf8str_char_next(text);
+        }
+        runs++;
+    }
+    return runs;
+}
+
+static long span_runs(const char *text) {
+    long runs = 0;
+    while (*text) {
+        size_t len = utf8str_span_class(text, 0, UTF8_CLASS_WORD, NULL);
+        if (len == 0) {
+            len = utf8str_cspan_class(text, 0, UTF8_CLASS_WORD, NULL);
+        }
+        text += len;
+        runs++;
+    }
+    return runs;
+}
+
+#if UTF8STR_WITH_SCRIPT
+/* Splits text into script runs, returns the number of runs */
+static long script_runs(const char *text) {
+    long runs = 0;
+    while (*text) {
+        size_t len = utf8str_script_run_next(text, 0, NULL, NULL);
+        if (len == 0) {
+            break;
+        }
+        text += len;
+        runs++;
+    }
+    return runs;
+}
+
+#endif
+/* Finds all emoji sequences of text, returns their number */
+static long emoji_scan(const char *text) {
+    struct utf8str_emoji_t emoji;
+    long found = 0;
+    memset(&emoji, 0, sizeof(emoji));
+    while (utf8str_emoji_next(text, 0, &emoji) == UTF8_OK) {
+        found++;
+    }
+    return found;
+}
+
+static long quick_check(const char *text) {
+    return (long)utf8str_quick_check(text, 0);
+}
+
+static long tabs_size(const char *text) {
+    size_t size = 0;
+    utf8str_expand_tabs(text, NULL, &size, 8);
+    return (long)size;
+}
+
+static long tab_stops_size(const char *text) {
+    size_t size = 0;
+    utf8str_expand_tabs_ex(text, NULL, &size, 8, UTF8_TAB_STOPS);
+    return (long)size;
+}
+
+#if UTF8STR_WITH_WIDTH
+static long char_width(const char *text) {
+    return (long)utf8str_width(text, 0);
+}
+
+#if UTF8STR_WITH_GRAPHEME
+static struct utf8str_width_cache_t width_cache;
+
+static long cluster_width(const char *text) {
+    return (long)utf8str_width_ex(text, 0, 0, NULL);
+}
+
+static long cluster_width_cached(const char *text) {
+    return (long)utf8str_width_ex(text, 0, 0, &width_cache);
+}
+
+/* fits the text into a table cell, measuring all of it */
+static long truncate_middle(const char *text) {
+    struct utf8str_truncate_t cut;
+    utf8str_truncate_width(text, 0, 40, "\xe2\x80\xa6", UTF8_ELIDE_MIDDLE, 0, &cut);
+    return (long)cut.tail_start;
+}
+
+/* pads every line of the text to a table cell with a dotted leader */
+static long pad_cells(const char *text) {
+    char cell[1024];
+    long sum = 0;
+    for (const char *line = text; *line != '\0'; ) {
+        const char *end = strchr(line, '\n');
+        size_t len = (end == NULL) ? strlen(line) : (size_t)(end - line);
+        size_t size = sizeof(cell);
+        if (len < 512) {
+            utf8str_pad(line, len, 160, " .", UTF8_PAD_END, 0, cell, &size);
+            sum += (long)size;
+        }
+        line += len + (end != NULL);
+    }
+    return sum;
+}
+
+static struct utf8str_fill_t leader;
+
+/* pads every line of the text to a table cell with pieces of a shared leader */
+static long pad_cells_iov(const char *text) {
+    utf8str_iovec_t iov[5];
+    long sum = 0;
+    for (const char *line = text; *line != '\0'; ) {
+        const char *end = strchr(line, '\n');
+        size_t len = (end == NULL) ? strlen(line) : (size_t)(end - line);
+        size_t n = 5;
+        if (len < 512) {
+            utf8str_pad_iov(line, len, 160, &leader, UTF8_PAD_END, iov, &n);
+            for (size_t i = 0; i < n; i++) {
+                sum += (long)iov[i].iov_len;
+            }
+        }
+        line += len + (end != NULL);
+    }
+    return sum;
+}
+
+/* indexes the text as one line and scrolls it horizontally */
+static long column_index(const char *text) {
+    struct utf8str_colindex_t index;
+    struct utf8str_colpos_t pos;
+    long sum = 0;
+    utf8str_colindex_init(&index, 64, 8, 0, NULL);
+    utf8str_colindex_append(&index, text, 0);
+    for (size_t column = 0; column < index.end.column; column += index.end.column / 1000 + 1) {
+        utf8str_colindex_column_to_byte(&index, text, column, &pos);
+        sum += (long)pos.byte_offset;
+    }
+    utf8str_colindex_free(&index);
+    return sum;
+}
+
+#if UTF8STR_WITH_LINEBREAK
+static int count_line(void *ctx, const struct utf8str_line_t *line) {
+    *(long*)ctx += (long)line->width;
+    return 0;
+}
+
+/* wraps the text for a terminal */
+static long wrap_lines(const char *text) {
+    long sum = 0;
+    utf8str_wrap(text, 0, 72, 0, count_line, &sum);
+    return sum;
+}
+
+static struct utf8str_paragraph_t paragraph;
+static char *justified;
+static size_t justified_sz;
+
+/* justifies the text, one paragraph per line, into a buffer that is kept
+ * between the rounds as the formatter is */
+static long justify_lines(const char *text) {
+    size_t size = justified_sz;
+    if (justified == NULL
+            || utf8str_paragraph_justify(&paragraph, text, 0, justified, &size) == UTF8_BUFFER_SMALL) {
+        size = 0;
+        utf8str_paragraph_justify(&paragraph, text, 0, NULL, &size);
+        free(justified);
+        justified_sz = size + 1;
+        justified = (char *)malloc(justified_sz);
+        if (justified == NULL) {
+            return 0;
+        }
+        utf8str_paragraph_justify(&paragraph, text, 0, justified, &size);
+    }
+    return (long)size;
+}
+#endif
+#endif
+#endif
+
+/* Returns nanoseconds per character for splitting text into runs */
+static double bench_runs(long (*fn)(const char *), const char *text, size_t count, long *hits) {
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        *hits += fn(text);
+    }
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    return elapsed * 1e9 / ((double)count * BENCH_ROUNDS);
+}
+
+int main(void) {
+#if UTF8STR_EXTERNAL_DATA
+    if (utf8proc_load_data(UTF8TEST_DATA_FILE) != 0) {
+        printf("Cannot load %s\n", UTF8TEST_DATA_FILE);
+        return 1;
+    }
+#endif
+    size_t sample_len = strlen(bench_sample);
+    char *text = (char *)malloc(sample_len * BENCH_TEXT_REPEAT + 1);
+    if (text == NULL) {
+        return 1;
+    }
+    for (int i = 0; i < BENCH_TEXT_REPEAT; i++) {
+        memcpy(text + i * sample_len, bench_sample, sample_len);
+    }
+    text[sample_len * BENCH_TEXT_REPEAT] = '\0';
+
+    size_t count = utf8str_count(text);
+    const char **chars = (const char **)malloc(count * sizeof(*chars));
+    if (chars == NULL) {
+        free(text);
+        return 1;
+    }
+    const char *p = text;
+    for (size_t i = 0; i < count; i++) {
+        chars[i] = p;
+        p = utf8str_char_next(p);
+    }
+
+    size_t top_count = 0x110000 >> (UTF8STR_CLASS_MID_BITS + UTF8STR_CLASS_LEAF_BITS);
+    size_t max_mid = 0, max_leaf = 0;
+    for (size_t i = 0; i < top_count; i++) {
+        if (utf8str_class_top[i] > max_mid) {
+            max_mid = utf8str_class_top[i];
+        }
+    }
+    size_t mid_count = table_entries(max_mid, UTF8STR_CLASS_MID_BITS);
+    for (size_t i = 0; i < mid_count; i++) {
+        if (utf8str_class_mid[i] > max_leaf) {
+            max_leaf = utf8str_class_mid[i];
+        }
+    }
+    size_t top_sz = top_count * sizeof(utf8str_class_top[0]);
+    size_t mid_sz = mid_count * sizeof(utf8str_class_mid[0]);
+    size_t leaf_sz = table_entries(max_leaf, UTF8STR_CLASS_LEAF_BITS) * sizeof(utf8str_class_leaf[0]);
+    printf("Character class table: %u bytes(top %u, middle %u, leaves %u)\n",
+            (unsigned int)(top_sz + mid_sz + leaf_sz), (unsigned int)top_sz,
+            (unsigned int)mid_sz, (unsigned int)leaf_sz);
+    printf("Unicode %s data\n", utf8proc_unicode_version());
+    printf("Text: %u characters, %u bytes\n\n", (unsigned int)count, (unsigned int)strlen(text));
+
+    long hits = 0;
+    for (size_t i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++) {
+        double ns = bench_run(bench_cases[i].fn, chars, count, &hits);
+        printf("%-32s %8.2f ns/char\n", bench_cases[i].name, ns);
+    }
+#if UTF8STR_WITH_CASE || UTF8STR_WITH_NORMALIZATION
+    printf("%-32s %8.2f ns/char\n", "property lookup, all planes", bench_lookup(&hits));
+#endif
+    printf("%-32s %8.2f ns/char\n", "word runs: char loop", bench_runs(loop_runs, text, count, &hits));
+    printf("%-32s %8.2f ns/char\n", "word runs: span functions", bench_runs(span_runs, text, count, &hits));
+#if UTF8STR_WITH_SCRIPT
+    printf("%-32s %8.2f ns/char\n", "script runs", bench_runs(script_runs, text, count, &hits));
+#endif
+    printf("%-32s %8.2f ns/char\n", "emoji scan", bench_runs(emoji_scan, text, count, &hits));
+    printf("%-32s %8.2f ns/char\n", "utf8str_quick_check", bench_runs(quick_check, text, count, &hits));
+    printf("%-32s %8.2f ns/char\n", "utf8str_expand_tabs, size", bench_runs(tabs_size, text, count, &hits));
+    printf("%-32s %8.2f ns/char\n", "utf8str_expand_tabs_ex, stops", bench_runs(tab_stops_size, text, count, &hits));
+#if UTF8STR_WITH_WIDTH
+    printf("%-32s %8.2f ns/char\n", "utf8str_width", bench_runs(char_width, text, count, &hits));
+#if UTF8STR_WITH_GRAPHEME
+    printf("%-32s %8.2f ns/char\n", "utf8str_width_ex", bench_runs(cluster_width, text, count, &hits));
+    printf("%-32s %8.2f ns/char\n", "utf8str_width_ex, cache", bench_runs(cluster_width_cached, text, count, &hits));
+    printf("%-32s %8.2f ns/char\n", "utf8str_truncate_width, middle", bench_runs(truncate_middle, text, count, &hits));
+    printf("%-32s %8.2f ns/char\n", "utf8str_pad, 160 column cells", bench_runs(pad_cells, text, count, &hits));
+    utf8str_fill_init(&leader, " .", 160, 0, NULL);
+    printf("%-32s %8.2f ns/char\n", "utf8str_pad_iov, 160 column cells", bench_runs(pad_cells_iov, text, count, &hits));
+    utf8str_fill_free(&leader);
+    printf("%-32s %8.2f ns/char\n", "column index, 1000 lookups", bench_runs(column_index, text, count, &hits));
+#if UTF8STR_WITH_LINEBREAK
+    printf("%-32s %8.2f ns/char\n", "utf8str_wrap, 72 columns", bench_runs(wrap_lines, text, count, &hits));
+    utf8str_paragraph_init(&paragraph, 72, 0, NULL);
+    printf("%-32s %8.2f ns/char\n", "paragraph justify, 72 columns", bench_runs(justify_lines, text, count, &hits));
+    utf8str_paragraph_free(&paragraph);
+    free(justified);
+#endif
+#endif
+#endif
+    printf("\n(checksum %ld)\n", hits);
+
+    free(chars);
+    free(text);
+    return 0;
+}
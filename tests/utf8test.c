@@ -1,6 +1,8 @@
 ﻿#include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include "utf8string.h"
+#include "utf8proc.h"
 
 int skip_failed_pkg = 1;
 #include "unittest.h"
@@ -56,6 +58,7 @@ const char* test_utf_at() {
     return 0;
 }
 
+#if UTF8STR_WITH_CASE
 const char* test_utf_cases() {
     char *str = "exAmpLe пРимЕр";
     char *invstr = "exAmpLe\x89\xe6 пРимЕр";
@@ -96,6 +99,124 @@ const char* test_utf_cases_inplace() {
     return 0;
 }
 
+const char* test_utf_cases_inplace_sz() {
+    char buf[48];
+
+    ut_assert("NULL string case sz", utf8str_upcase_inplace_sz(NULL, 10, 0) == UTF8_INVALID_ARG);
+    strcpy(buf, "abc");
+    ut_assert("Buffer shorter than string", utf8str_upcase_inplace_sz(buf, 3, 0) == UTF8_INVALID_ARG);
+    strcpy(buf, "exAmpLe пРимЕр");
+    ut_assert("Same size upcase", utf8str_upcase_inplace_sz(buf, sizeof(buf), 0) == UTF8_OK
+            && strcmp(buf, "EXAMPLE ПРИМЕР") == 0);
+    strcpy(buf, "exAmpLe пРимЕр");
+    ut_assert("Only 4 first sz", utf8str_lowcase_inplace_sz(buf, sizeof(buf), 4) == UTF8_OK
+            && strcmp(buf, "exampLe пРимЕр") == 0);
+    strcpy(buf, "ııx");
+    ut_assert("Shrinking upcase", utf8str_upcase_inplace_sz(buf, 6, 0) == UTF8_OK && strcmp(buf, "IIX") == 0);
+    strcpy(buf, "ȿaɐ");
+    ut_assert("Growing upcase", utf8str_upcase_inplace_sz(buf, 8, 0) == UTF8_OK && strcmp(buf, "ⱾAⱯ") == 0);
+    strcpy(buf, "ȿaɐ");
+    ut_assert("Growing upcase small buffer", utf8str_upcase_inplace_sz(buf, 7, 0) == UTF8_BUFFER_SMALL
+            && strcmp(buf, "ȿaɐ") == 0);
+    strcpy(buf, "ɐı");
+    ut_assert("Growing ahead upcase", utf8str_upcase_inplace_sz(buf, 5, 0) == UTF8_OK && strcmp(buf, "ⱯI") == 0);
+    strcpy(buf, "ıɐ");
+    ut_assert("Shrink then grow upcase", utf8str_upcase_inplace_sz(buf, 5, 0) == UTF8_OK && strcmp(buf, "IⱯ") == 0);
+    strcpy(buf, "aɐɐbc");
+    ut_assert("Growing with limit", utf8str_upcase_inplace_sz(buf, 9, 2) == UTF8_OK && strcmp(buf, "AⱯɐbc") == 0);
+    strcpy(buf, "ȾȾ\x89");
+    ut_assert("Invalid string untouched", utf8str_lowcase_inplace_sz(buf, sizeof(buf), 0) == UTF8_INVALID_UTF
+            && strcmp(buf, "ȾȾ\x89") == 0);
+    strcpy(buf, "пример ɐbc");
+    ut_assert("Title case sz", utf8str_titlecase_sz(buf, sizeof(buf)) == UTF8_OK && strcmp(buf, "Пример Ɐbc") == 0);
+
+    return 0;
+}
+
+struct counting_alloc {
+    int allocs;
+    int frees;
+};
+
+static void* counting_resize(void *ctx, void *ptr, size_t size) {
+    if (ptr == NULL) {
+        ((struct counting_alloc *)ctx)->allocs++;
+    }
+    return realloc(ptr, size);
+}
+
+static void counting_release(void *ctx, void *ptr) {
+    ((struct counting_alloc *)ctx)->frees++;
+    free(ptr);
+}
+
+const char* test_utf_cases_alloc() {
+    struct counting_alloc cnt = {0, 0};
+    struct utf8str_alloc_t alloc = {counting_resize, counting_release, &cnt};
+    char *res = NULL;
+    size_t len = 0;
+
+    ut_assert("NULL string alloc", utf8str_upcase_alloc(NULL, &res, &len, NULL) == UTF8_INVALID_ARG);
+    ut_assert("NULL dest alloc", utf8str_upcase_alloc("ab", NULL, &len, NULL) == UTF8_INVALID_ARG);
+    ut_assert("Upcase alloc", utf8str_upcase_alloc("exAmpLe пРимЕр", &res, &len, NULL) == UTF8_OK
+            && strcmp(res, "EXAMPLE ПРИМЕР") == 0 && len == 20);
+    free(res);
+    ut_assert("Lowcase alloc", utf8str_lowcase_alloc("exAmpLe пРимЕр", &res, NULL, NULL) == UTF8_OK
+            && strcmp(res, "example пример") == 0);
+    free(res);
+    ut_assert("Empty string alloc", utf8str_lowcase_alloc("", &res, &len, &alloc) == UTF8_OK
+            && strcmp(res, "") == 0 && len == 0);
+    alloc.release(alloc.ctx, res);
+    ut_assert("Upcase alloc growing", utf8str_upcase_alloc("aɐɐɐɐɐɐ", &res, &len, &alloc) == UTF8_OK
+            && strcmp(res, "AⱯⱯⱯⱯⱯⱯ") == 0 && len == 19);
+    alloc.release(alloc.ctx, res);
+    ut_assert("Lowcase alloc growing", utf8str_lowcase_alloc("ȾȾ", &res, &len, &alloc) == UTF8_OK
+            && strcmp(res, "ⱦⱦ") == 0 && len == 6);
+    alloc.release(alloc.ctx, res);
+    ut_assert("Invalid string alloc", utf8str_upcase_alloc("exAmpLe\x89\xe6", &res, &len, &alloc) == UTF8_INVALID_UTF
+            && res == NULL);
+    ut_assert("Custom allocator balanced", cnt.allocs == 4 && cnt.frees == 4);
+
+    return 0;
+}
+
+const char* test_utf_cases_locale() {
+    char buf[48];
+    size_t sz;
+
+    ut_assert("Locale NULL", utf8str_locale(NULL) == UTF8_LOCALE_DEFAULT);
+    ut_assert("Locale unknown", utf8str_locale("en_US.UTF-8") == UTF8_LOCALE_DEFAULT);
+    ut_assert("Locale long name", utf8str_locale("trk") == UTF8_LOCALE_DEFAULT);
+    ut_assert("Locale Turkish", utf8str_locale("tr_TR.UTF-8") == UTF8_LOCALE_TURKIC);
+    ut_assert("Locale Azerbaijani", utf8str_locale("AZ") == UTF8_LOCALE_TURKIC);
+    ut_assert("Locale Lithuanian", utf8str_locale("lt-LT") == UTF8_LOCALE_LITHUANIAN);
+    ut_assert("Locale Greek", utf8str_locale("el") == UTF8_LOCALE_GREEK);
+
+    ut_assert("NULL string locale case", utf8str_upcase_locale(NULL, buf, NULL, UTF8_LOCALE_TURKIC) == UTF8_INVALID_ARG);
+    ut_assert("Default upcase", utf8str_upcase_locale("istanbul", buf, NULL, UTF8_LOCALE_DEFAULT) == UTF8_OK && strcmp(buf, "ISTANBUL") == 0);
+    ut_assert("Turkic upcase", utf8str_upcase_locale("istanbul", buf, NULL, UTF8_LOCALE_TURKIC) == UTF8_OK && strcmp(buf, "İSTANBUL") == 0);
+    ut_assert("Turkic upcase dotless", utf8str_upcase_locale("ılık", buf, NULL, UTF8_LOCALE_TURKIC) == UTF8_OK && strcmp(buf, "ILIK") == 0);
+    ut_assert("Turkic lowcase", utf8str_lowcase_locale("ISPARTA İZMİR", buf, NULL, UTF8_LOCALE_TURKIC) == UTF8_OK && strcmp(buf, "ısparta izmir") == 0);
+    ut_assert("Turkic lowcase dot above", utf8str_lowcase_locale("I\xcc\x87Ş", buf, NULL, UTF8_LOCALE_TURKIC) == UTF8_OK && strcmp(buf, "iş") == 0);
+    ut_assert("Turkic invalid", utf8str_lowcase_locale("I\x89", buf, NULL, UTF8_LOCALE_TURKIC) == UTF8_INVALID_UTF);
+
+    ut_assert("Lithuanian lowcase accent", utf8str_lowcase_locale("Ì", buf, NULL, UTF8_LOCALE_LITHUANIAN) == UTF8_OK && strcmp(buf, "i\xcc\x87\xcc\x80") == 0);
+    ut_assert("Lithuanian lowcase more above", utf8str_lowcase_locale("I\xcc\x81J", buf, NULL, UTF8_LOCALE_LITHUANIAN) == UTF8_OK && strcmp(buf, "i\xcc\x87\xcc\x81j") == 0);
+    ut_assert("Lithuanian upcase soft dotted", utf8str_upcase_locale("i\xcc\x87\xcc\x80x\xcc\x87", buf, NULL, UTF8_LOCALE_LITHUANIAN) == UTF8_OK && strcmp(buf, "I\xcc\x80X\xcc\x87") == 0);
+    sz = 0;
+    ut_assert("Lithuanian calculate size", utf8str_lowcase_locale("ÌÍ", NULL, &sz, UTF8_LOCALE_LITHUANIAN) == UTF8_OK && sz == 10);
+    sz = 6;
+    ut_assert("Lithuanian small buffer", utf8str_lowcase_locale("ÌÍ", buf, &sz, UTF8_LOCALE_LITHUANIAN) == UTF8_BUFFER_SMALL);
+
+    ut_assert("Greek lowcase final sigma", utf8str_lowcase_locale("ΣΑΣ ΟΔΟΣ, Σ", buf, NULL, UTF8_LOCALE_GREEK) == UTF8_OK && strcmp(buf, "σας οδος, σ") == 0);
+    ut_assert("Greek lowcase sigma before mark", utf8str_lowcase_locale("ΑΣ\xcc\x81Α", buf, NULL, UTF8_LOCALE_GREEK) == UTF8_OK && strcmp(buf, "ασ\xcc\x81α") == 0);
+    ut_assert("Default lowcase sigma", utf8str_lowcase_locale("ΟΔΟΣ", buf, NULL, UTF8_LOCALE_DEFAULT) == UTF8_OK && strcmp(buf, "οδοσ") == 0);
+    ut_assert("Greek upcase accents", utf8str_upcase_locale("άλφα ΰ", buf, NULL, UTF8_LOCALE_GREEK) == UTF8_OK && strcmp(buf, "ΑΛΦΑ Ϋ") == 0);
+    ut_assert("Greek upcase combining accent", utf8str_upcase_locale("α\xcc\x81" "e\xcc\x81", buf, NULL, UTF8_LOCALE_GREEK) == UTF8_OK && strcmp(buf, "ΑE\xcc\x81") == 0);
+
+    return 0;
+}
+
 const char* test_utf_iequal() {
     ut_assert("NULL strings equal", utf8str_equal_no_case(NULL, NULL) == UTF8_EQUAL);
     ut_assert("NULL string and non-NULL equal 1", utf8str_equal_no_case("a", NULL) == UTF8_NEQUAL);
@@ -113,9 +234,52 @@ const char* test_utf_iequal() {
     ut_assert("ASCII string nequal short strings", utf8str_nequal_no_case("aBc", "Abc", 6) == UTF8_EQUAL);
     ut_assert("ASCII string not nequal short strings", utf8str_nequal_no_case("aBcd", "Abce", 6) == UTF8_NEQUAL);
     ut_assert("ASCII string not nequal different lengths", utf8str_nequal_no_case("aBcd", "Abcde", 6) == UTF8_NEQUAL);
+
+    ut_assert("Long ASCII string equal", utf8str_equal_no_case("Content-Type-Options: X-Frame-Options-Header",
+                "content-type-options: x-frame-OPTIONS-header") == UTF8_EQUAL);
+    ut_assert("Long ASCII string not equal at end", utf8str_equal_no_case("Content-Type-Options: X-Frame-Options-Header",
+                "content-type-options: x-frame-OPTIONS-headers") == UTF8_NEQUAL);
+    ut_assert("Long ASCII string not letters", utf8str_equal_no_case("select_column_from_table_where@",
+                "SELECT_COLUMN_FROM_TABLE_WHERE`") == UTF8_NEQUAL);
+    ut_assert("Long ASCII and UTF string equal", utf8str_equal_no_case("select_column_from_table_where_пример",
+                "SELECT_COLUMN_FROM_TABLE_WHERE_ПРИМЕР") == UTF8_EQUAL);
+    ut_assert("Long mixed string equal", utf8str_equal_no_case("select_column_from_table_where_ıs",
+                "SELECT_COLUMN_FROM_TABLE_WHERE_iſ") == UTF8_EQUAL);
+    ut_assert("Long ASCII string equal partially", utf8str_nequal_no_case("select_column_from_table_where_a",
+                "SELECT_COLUMN_FROM_TABLE_WHERE_b", 31) == UTF8_EQUAL);
     return 0;
 }
 
+#if UTF8STR_WITH_NORMALIZATION
+const char* test_utf_fold_key() {
+    char buf[32];
+
+    ut_assert("NULL fold key", utf8str_fold_key(NULL, 0, buf, sizeof(buf), 0) == (size_t)-1);
+    ut_assert("Invalid fold key", utf8str_fold_key("ab\x89", 0, buf, sizeof(buf), 0) == (size_t)-1);
+    ut_assert("Empty fold key", utf8str_fold_key("", 0, buf, sizeof(buf), 0) == 0 && strcmp(buf, "") == 0);
+    ut_assert("Full case folding", utf8str_fold_key("Straße ΣΑΣ", 0, buf, sizeof(buf), 0) == 14
+            && strcmp(buf, "strasse σασ") == 0);
+    ut_assert("Fold key length", utf8str_fold_key("ABCdef", 3, buf, sizeof(buf), 0) == 3 && strcmp(buf, "abc") == 0);
+    ut_assert("Fold key size only", utf8str_fold_key("Straße", 0, NULL, 0, 0) == 7);
+    ut_assert("Fold key small buffer", utf8str_fold_key("Straße", 0, buf, 5, 0) == 7 && strcmp(buf, "stra") == 0);
+    ut_assert("Fold key NFC", utf8str_fold_key("E\xcc\x81", 0, buf, sizeof(buf), UTF8_FOLD_NFC) == 2
+            && strcmp(buf, "é") == 0);
+    ut_assert("Fold key not normalized", utf8str_fold_key("E\xcc\x81", 0, buf, sizeof(buf), 0) == 3
+            && strcmp(buf, "e\xcc\x81") == 0);
+    ut_assert("Fold key mark order", utf8str_fold_key("a\xcc\x87\xcc\xa3", 0, buf, sizeof(buf), UTF8_FOLD_NFC) == 5
+            && strcmp(buf, "ạ\xcc\x87") == 0);
+    ut_assert("Fold key NFKC", utf8str_fold_key("ＣａﬁÉ", 0, buf, sizeof(buf), UTF8_FOLD_NFKC) == 6
+            && strcmp(buf, "cafié") == 0);
+    ut_assert("Fold key strip marks", utf8str_fold_key("Ｃａｆé", 0, buf, sizeof(buf),
+                UTF8_FOLD_NFKC | UTF8_FOLD_STRIP_MARKS) == 4 && strcmp(buf, "cafe") == 0);
+    ut_assert("Fold key Hangul", utf8str_fold_key("\xe1\x84\x80\xe1\x85\xa1\xe1\x86\xa8", 0, buf, sizeof(buf),
+                UTF8_FOLD_NFC) == 3 && strcmp(buf, "각") == 0);
+
+    return 0;
+}
+#endif
+#endif
+
 const char* test_utf_starts() {
     ut_assert("NULL strings starts", utf8str_starts_with(NULL, NULL) == UTF8_EQUAL);
     ut_assert("Equal strings starts", utf8str_starts_with("abc", "abc") == UTF8_EQUAL);
@@ -133,6 +297,56 @@ const char* test_utf_starts() {
     return 0;
 }
 
+#if UTF8STR_WITH_CASE
+const char* test_utf_find_no_case() {
+    struct utf8str_match_t m;
+
+    ut_assert("NULL needle", utf8str_needle_init(NULL) == NULL);
+    ut_assert("Empty needle", utf8str_needle_init("") == NULL);
+    ut_assert("Invalid needle", utf8str_needle_init("ab\x89") == NULL);
+
+    struct utf8str_needle_t *n = utf8str_needle_init("eRRor");
+    ut_assert("Init needle", n != NULL);
+    memset(&m, 0, sizeof(m));
+    ut_assert("NULL haystack", utf8str_find_no_case(NULL, n, &m) == UTF8_INVALID_ARG);
+    const char *log = "Log: ERROR, error; Errors";
+    ut_assert("Find first", utf8str_find_no_case(log, n, &m) == UTF8_OK
+            && m.byte_offset == 5 && m.char_offset == 5 && m.byte_length == 5 && m.char_length == 5);
+    ut_assert("Find second", utf8str_find_no_case(log, n, &m) == UTF8_OK && m.byte_offset == 12);
+    ut_assert("Find third", utf8str_find_no_case(log, n, &m) == UTF8_OK && m.byte_offset == 19);
+    ut_assert("Find no more", utf8str_find_no_case(log, n, &m) == UTF8_NOT_FOUND && m.byte_offset == 19);
+    memset(&m, 0, sizeof(m));
+    ut_assert("Reuse needle", utf8str_find_no_case("errrror erro", n, &m) == UTF8_NOT_FOUND);
+    memset(&m, 0, sizeof(m));
+    ut_assert("Invalid haystack", utf8str_find_no_case("erro\x89 error", n, &m) == UTF8_INVALID_UTF);
+    utf8str_needle_free(n);
+
+    n = utf8str_needle_init("пример");
+    memset(&m, 0, sizeof(m));
+    ut_assert("UTF find", utf8str_find_no_case("Это ПРИМЕР", n, &m) == UTF8_OK
+            && m.byte_offset == 7 && m.char_offset == 4 && m.byte_length == 12 && m.char_length == 6);
+    memset(&m, 0, sizeof(m));
+    ut_assert("UTF partial", utf8str_find_no_case("примеР прим", n, &m) == UTF8_OK
+            && utf8str_find_no_case("примеР прим", n, &m) == UTF8_NOT_FOUND);
+    utf8str_needle_free(n);
+
+    n = utf8str_needle_init("xi");
+    memset(&m, 0, sizeof(m));
+    ut_assert("Shorter match", utf8str_find_no_case("aXıb", n, &m) == UTF8_OK
+            && m.byte_offset == 1 && m.byte_length == 3 && m.char_offset == 1 && m.char_length == 2);
+    utf8str_needle_free(n);
+
+    n = utf8str_needle_init("ɐz");
+    memset(&m, 0, sizeof(m));
+    ut_assert("Longer match", utf8str_find_no_case("ɐⱯZ", n, &m) == UTF8_OK
+            && m.byte_offset == 2 && m.byte_length == 4 && m.char_offset == 1);
+    utf8str_needle_free(n);
+    ut_assert("Free NULL needle", utf8str_needle_free(NULL) == UTF8_OK);
+
+    return 0;
+}
+#endif
+
 const char* test_utf_categories() {
     ut_assert("NULL is not digit", !utf8str_isdigit(NULL));
     ut_assert("Empty string is not digit", !utf8str_isdigit(""));
@@ -153,10 +367,265 @@ const char* test_utf_categories() {
     ut_assert("UTF islower", utf8str_islower("á"));
     ut_assert("UTF not islower", !utf8str_islower("Á"));
     ut_assert("UTF isalpha", utf8str_isalpha("ŋ"));
+    ut_assert("UTF isspace", utf8str_isspace("\xe2\x80\x83"));
+    ut_assert("UTF isdigit", utf8str_isdigit("٣"));
+    ut_assert("UTF isprint", utf8str_isprint("日") && !utf8str_isprint("\xcc\x81"));
+    ut_assert("Invalid is not alpha", !utf8str_isalpha("\x89" "a"));
+
+    ut_assert("NULL isclass", !utf8str_isclass(NULL, UTF8_CLASS_ALPHA));
+    ut_assert("Word class underscore", utf8str_isclass("_id", UTF8_CLASS_WORD));
+    ut_assert("Word class mark", utf8str_isclass("\xcc\x81", UTF8_CLASS_WORD | UTF8_CLASS_MARK));
+    ut_assert("Not word class", !utf8str_isclass("-", UTF8_CLASS_WORD));
+    ut_assert("Symbol class", utf8str_isclass("+", UTF8_CLASS_PUNCT | UTF8_CLASS_SYMBOL));
+    ut_assert("Cased class", utf8str_isclass("ǅ", UTF8_CLASS_CASED) && !utf8str_isclass("日", UTF8_CLASS_CASED));
+    ut_assert("Empty class set", !utf8str_isclass("a", 0));
+
+    ut_assert("Code point isalpha", utf8str_isalpha_cp('y') && utf8str_isalpha_cp(0x14B) && !utf8str_isalpha_cp('1'));
+    ut_assert("Code point isdigit", utf8str_isdigit_cp('7') && utf8str_isdigit_cp(0x663) && !utf8str_isdigit_cp('a'));
+    ut_assert("Code point isspace", utf8str_isspace_cp('\t') && utf8str_isspace_cp(0x2003) && !utf8str_isspace_cp('_'));
+    ut_assert("Code point ispunct", utf8str_ispunct_cp('.') && !utf8str_ispunct_cp('+'));
+    ut_assert("Code point case", utf8str_isupper_cp(0x424) && utf8str_islower_cp(0x444) && !utf8str_islower_cp(0x424));
+    ut_assert("Code point iscntrl", utf8str_iscntrl_cp(0x08) && !utf8str_iscntrl_cp(' '));
+    ut_assert("Code point isprint", utf8str_isprint_cp(0x65E5) && !utf8str_isprint_cp(0x301));
+    ut_assert("Code point isclass", utf8str_isclass_cp('_', UTF8_CLASS_WORD) && !utf8str_isclass_cp('-', UTF8_CLASS_WORD));
+    ut_assert("Invalid code points", utf8str_class_cp(-1) == 0 && utf8str_class_cp(0x110000) == 0 && utf8str_class_cp(0xD800) == 0);
+    ut_assert("Code point and string agree", utf8str_class_cp(0x1C5) == (UTF8_CLASS_UPPER | UTF8_CLASS_ALPHA | UTF8_CLASS_CASED | UTF8_CLASS_WORD | UTF8_CLASS_PRINT));
+
+    size_t n = 99;
+    ut_assert("NULL span", utf8str_span_class(NULL, 0, UTF8_CLASS_ALPHA, &n) == 0 && n == 0);
+    ut_assert("Empty span", utf8str_span_class("", 0, UTF8_CLASS_ALPHA, &n) == 0 && n == 0);
+    ut_assert("ASCII span", utf8str_span_class("id42 = 1", 0, UTF8_CLASS_WORD, &n) == 4 && n == 4);
+    ut_assert("UTF span", utf8str_span_class("мир!", 0, UTF8_CLASS_ALPHA, &n) == 6 && n == 3);
+    ut_assert("Whole string span", utf8str_span_class("abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+                0, UTF8_CLASS_ALPHA | UTF8_CLASS_DIGIT, &n) == 62 && n == 62);
+    ut_assert("Long mixed span", utf8str_span_class("abcdefghijklmnopqrstuvwxyzабвгдabcdefghijklmnopqrstuvwxyz-",
+                0, UTF8_CLASS_ALPHA, &n) == 62 && n == 57);
+    ut_assert("Span with length", utf8str_span_class("abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz", 40,
+                UTF8_CLASS_ALPHA, NULL) == 40);
+    ut_assert("Long punctuation span", utf8str_span_class("!\"#%&'()*,-./:;?@[\\]_{}!\"#%&'()*,-./:;?@[\\]_{}$",
+                0, UTF8_CLASS_PUNCT, &n) == 46 && n == 46);
+    ut_assert("Long complement span", utf8str_cspan_class("$+<=>^`|~0123456789ABCXYZabcxyz $+<=>^`|~0123456789!",
+                0, UTF8_CLASS_PUNCT, &n) == 51 && n == 51);
+    ut_assert("Span cuts no character", utf8str_span_class("ab\xd0\xb1", 3, UTF8_CLASS_ALPHA, &n) == 2 && n == 2);
+    ut_assert("Span stops at invalid", utf8str_span_class("ab\x89" "cd", 0, UTF8_CLASS_ALPHA, &n) == 2 && n == 2);
+    ut_assert("Span with zero inside", utf8str_span_class("\t\0\t x", 4, UTF8_CLASS_SPACE | UTF8_CLASS_CNTRL, &n) == 4 && n == 4);
+    ut_assert("Span stops at zero", utf8str_span_class("\t\0\t x", 0, UTF8_CLASS_SPACE | UTF8_CLASS_CNTRL, &n) == 1 && n == 1);
+    ut_assert("Complement span", utf8str_cspan_class("мир 2", 0, UTF8_CLASS_SPACE, &n) == 6 && n == 3);
+    ut_assert("Complement whole span", utf8str_cspan_class("abc,def", 0, UTF8_CLASS_SPACE, &n) == 7 && n == 7);
+    ut_assert("Complement span stops at invalid", utf8str_cspan_class("ab\xff ", 0, UTF8_CLASS_SPACE, &n) == 2 && n == 2);
+
+    return 0;
+}
+
+#if UTF8STR_WITH_SCRIPT
+const char* test_utf_scripts() {
+    ut_assert("Script of letters", utf8proc_script('A') == UTF8PROC_SCRIPT_LATIN
+            && utf8proc_script(0x416) == UTF8PROC_SCRIPT_CYRILLIC && utf8proc_script(0x65E5) == UTF8PROC_SCRIPT_HAN);
+    ut_assert("Common and inherited", utf8proc_script(' ') == UTF8PROC_SCRIPT_COMMON
+            && utf8proc_script(0x301) == UTF8PROC_SCRIPT_INHERITED);
+    ut_assert("Unknown script", utf8proc_script(0x378) == UTF8PROC_SCRIPT_UNKNOWN
+            && utf8proc_script(-1) == UTF8PROC_SCRIPT_UNKNOWN && utf8proc_script(0x110000) == UTF8PROC_SCRIPT_UNKNOWN);
+    ut_assert("Script code", strcmp(utf8proc_script_code(UTF8PROC_SCRIPT_LATIN), "Latn") == 0
+            && strcmp(utf8proc_script_code(UTF8PROC_SCRIPT_YI), "Yiii") == 0
+            && strcmp(utf8proc_script_code((utf8proc_script_t)1000), "Zzzz") == 0);
+
+    utf8proc_script_t ext[64];
+    utf8proc_ssize_t next = utf8proc_script_extensions(0x964, ext, 64);
+    int deva = 0, beng = 0;
+    for (utf8proc_ssize_t i = 0; i < next && i < 64; i++) {
+        deva |= ext[i] == UTF8PROC_SCRIPT_DEVANAGARI;
+        beng |= ext[i] == UTF8PROC_SCRIPT_BENGALI;
+    }
+    ut_assert("Script extensions", utf8proc_script(0x964) == UTF8PROC_SCRIPT_COMMON && next > 2 && deva && beng);
+    ut_assert("Script extensions small buffer", utf8proc_script_extensions(0x964, ext, 1) == next);
+    ut_assert("No script extensions", utf8proc_script_extensions('a', ext, 64) == 1 && ext[0] == UTF8PROC_SCRIPT_LATIN);
+    ut_assert("Has script", utf8proc_has_script(0x964, UTF8PROC_SCRIPT_BENGALI)
+            && !utf8proc_has_script(0x964, UTF8PROC_SCRIPT_LATIN) && utf8proc_has_script('a', UTF8PROC_SCRIPT_LATIN));
+
+    /* the run functions do not look ASCII and Latin letters up */
+    int fast_ok = 1;
+    for (utf8proc_int32_t cp = 0; cp < 0x250; cp++) {
+        utf8proc_script_t expected = UTF8PROC_SCRIPT_COMMON;
+        if ((cp >= 'a' && cp <= 'z') || (cp >= 'A' && cp <= 'Z') || (cp >= 0xC0 && cp != 0xD7 && cp != 0xF7)) {
+            expected = UTF8PROC_SCRIPT_LATIN;
+        }
+        if ((cp < 0x80 || expected == UTF8PROC_SCRIPT_LATIN)
+                && (utf8proc_script(cp) != expected || utf8proc_script_extensions(cp, ext, 64) != 1)) {
+            fast_ok = 0;
+        }
+    }
+    ut_assert("ASCII and Latin fast path", fast_ok);
+
+    size_t n = 99;
+    int script = -1;
+    ut_assert("NULL run", utf8str_script_run_next(NULL, 0, &script, &n) == 0 && n == 0 && script == UTF8PROC_SCRIPT_COMMON);
+    ut_assert("Empty run", utf8str_script_run_next("", 0, &script, &n) == 0 && n == 0);
+    ut_assert("Latin run", utf8str_script_run_next("Hi, мир", 0, &script, &n) == 4 && n == 4 && script == UTF8PROC_SCRIPT_LATIN);
+    ut_assert("Cyrillic run", utf8str_script_run_next("мир", 0, &script, &n) == 6 && n == 3 && script == UTF8PROC_SCRIPT_CYRILLIC);
+    ut_assert("Common run", utf8str_script_run_next("12 + 3", 0, &script, &n) == 6 && script == UTF8PROC_SCRIPT_COMMON);
+    ut_assert("Leading common", utf8str_script_run_next("(Ελλάδα)", 0, &script, &n) == 14 && n == 8 && script == UTF8PROC_SCRIPT_GREEK);
+    ut_assert("Inherited mark", utf8str_script_run_next("e\xcc\x81t\xc3\xa9", 0, &script, &n) == 6 && n == 4 && script == UTF8PROC_SCRIPT_LATIN);
+    ut_assert("Han and Katakana", utf8str_script_run_next("日本語テキスト", 0, &script, &n) == 9 && script == UTF8PROC_SCRIPT_HAN);
+    ut_assert("Extension joins run", utf8str_script_run_next("क।ক", 0, &script, &n) == 6 && n == 2 && script == UTF8PROC_SCRIPT_DEVANAGARI);
+    ut_assert("Extension stops run", utf8str_script_run_next("a\xd8\x8c", 0, &script, &n) == 1 && n == 1);
+    ut_assert("Run with length", utf8str_script_run_next("мир", 4, &script, &n) == 4 && n == 2);
+    ut_assert("Run stops at invalid", utf8str_script_run_next("ab\xff", 0, &script, &n) == 2 && n == 2);
+
+    const char *text = "abc Привет, 世界! ok";
+    int scripts[8], runs = 0;
+    while (*text && runs < 8) {
+        text += utf8str_script_run_next(text, 0, &scripts[runs++], NULL);
+    }
+    ut_assert("Run loop", runs == 4 && scripts[0] == UTF8PROC_SCRIPT_LATIN && scripts[1] == UTF8PROC_SCRIPT_CYRILLIC
+            && scripts[2] == UTF8PROC_SCRIPT_HAN && scripts[3] == UTF8PROC_SCRIPT_LATIN);
 
     return 0;
 }
+#endif
+
+/* Returns the number of grapheme clusters of the code points */
+#if UTF8STR_WITH_GRAPHEME
+static int count_graphemes(const utf8proc_int32_t *cps, int count) {
+    utf8proc_int32_t state = 0;
+    int clusters = count > 0;
+    for (int i = 1; i < count; i++) {
+        clusters += utf8proc_grapheme_break_stateful(cps[i - 1], cps[i], &state);
+    }
+    return clusters;
+}
 
+#endif
+const char* test_utf_emoji() {
+    ut_assert("Emoji properties", utf8proc_emoji(0x1F600) == (UTF8PROC_EMOJI | UTF8PROC_EMOJI_PRESENTATION | UTF8PROC_EXTENDED_PICTOGRAPHIC)
+            && utf8proc_emoji(0xA9) == (UTF8PROC_EMOJI | UTF8PROC_EXTENDED_PICTOGRAPHIC)
+            && (utf8proc_emoji(0x1F3FB) & UTF8PROC_EMOJI_MODIFIER) && (utf8proc_emoji(0x1F44B) & UTF8PROC_EMOJI_MODIFIER_BASE));
+    ut_assert("Not emoji", utf8proc_emoji('a') == 0 && utf8proc_emoji(0x416) == 0 && utf8proc_emoji(-1) == 0);
+    ut_assert("Reserved pictographic", utf8proc_category(0x1F8FF) == UTF8PROC_CATEGORY_CN
+            && utf8proc_emoji(0x1F8FF) == UTF8PROC_EXTENDED_PICTOGRAPHIC);
+
+    struct utf8str_emoji_t e;
+    memset(&e, 0, sizeof(e));
+    ut_assert("NULL emoji", utf8str_emoji_next(NULL, 0, &e) == UTF8_INVALID_ARG && utf8str_emoji_next("a", 0, NULL) == UTF8_INVALID_ARG);
+    ut_assert("No emoji", utf8str_emoji_next("Hi, мир 12 \xc2\xa9 \xe2\x98\xba\xef\xb8\x8e", 0, &e) == UTF8_NOT_FOUND && e.next_byte == 0);
+    ut_assert("Single emoji", utf8str_emoji_next("ok \xf0\x9f\x98\x80!", 0, &e) == UTF8_OK && e.byte_offset == 3
+            && e.byte_length == 4 && e.char_length == 1 && e.kind == UTF8_EMOJI_CHAR && e.next_byte == 7);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Emoji style", utf8str_emoji_next("\xc2\xa9\xef\xb8\x8f", 0, &e) == UTF8_OK
+            && e.byte_length == 5 && e.char_length == 2 && e.kind == UTF8_EMOJI_CHAR);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Modifier", utf8str_emoji_next("Hi \xf0\x9f\x91\x8b\xf0\x9f\x8f\xbd!", 0, &e) == UTF8_OK && e.byte_offset == 3
+            && e.byte_length == 8 && e.char_length == 2 && e.kind == UTF8_EMOJI_MODIFIER);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Flag", utf8str_emoji_next("\xf0\x9f\x87\xa9\xf0\x9f\x87\xaa", 0, &e) == UTF8_OK
+            && e.byte_length == 8 && e.char_length == 2 && e.kind == UTF8_EMOJI_FLAG);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Keycap", utf8str_emoji_next("# 1\xef\xb8\x8f\xe2\x83\xa3", 0, &e) == UTF8_OK && e.byte_offset == 2
+            && e.byte_length == 7 && e.char_length == 3 && e.kind == UTF8_EMOJI_KEYCAP);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Tag sequence", utf8str_emoji_next("\xf0\x9f\x8f\xb4\xf3\xa0\x81\xa7\xf3\xa0\x81\xa2\xf3\xa0\x81\xa5"
+            "\xf3\xa0\x81\xae\xf3\xa0\x81\xa7\xf3\xa0\x81\xbf", 0, &e) == UTF8_OK
+            && e.byte_length == 28 && e.char_length == 7 && e.kind == UTF8_EMOJI_TAG);
+    memset(&e, 0, sizeof(e));
+    ut_assert("ZWJ family", utf8str_emoji_next("\xf0\x9f\x91\xa8\xe2\x80\x8d\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x91\xa7", 0, &e) == UTF8_OK
+            && e.byte_length == 18 && e.char_length == 5 && e.kind == UTF8_EMOJI_ZWJ);
+    memset(&e, 0, sizeof(e));
+    ut_assert("ZWJ rainbow flag", utf8str_emoji_next("\xf0\x9f\x8f\xb3\xef\xb8\x8f\xe2\x80\x8d\xf0\x9f\x8c\x88", 0, &e) == UTF8_OK
+            && e.byte_length == 14 && e.char_length == 4 && e.kind == UTF8_EMOJI_ZWJ);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Trailing ZWJ", utf8str_emoji_next("\xf0\x9f\x98\x80\xe2\x80\x8d" "a", 0, &e) == UTF8_OK
+            && e.byte_length == 4 && e.kind == UTF8_EMOJI_CHAR);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Emoji with length", utf8str_emoji_next("\xf0\x9f\x87\xa9\xf0\x9f\x87\xaa", 4, &e) == UTF8_OK
+            && e.byte_length == 4 && e.kind == UTF8_EMOJI_CHAR);
+    memset(&e, 0, sizeof(e));
+    ut_assert("Invalid emoji", utf8str_emoji_next("a \xf0\x9f\x98", 0, &e) == UTF8_INVALID_UTF);
+
+    const char *text = "a\xf0\x9f\x98\x80 b \xf0\x9f\x87\xa9\xf0\x9f\x87\xaa\xf0\x9f\x87\xab c";
+    int kinds[4], found = 0;
+    memset(&e, 0, sizeof(e));
+    while (found < 4 && utf8str_emoji_next(text, 0, &e) == UTF8_OK) {
+        kinds[found++] = e.kind;
+    }
+    ut_assert("Emoji loop", found == 3 && kinds[0] == UTF8_EMOJI_CHAR && kinds[1] == UTF8_EMOJI_FLAG
+            && kinds[2] == UTF8_EMOJI_CHAR && e.next_byte == strlen(text) - 2);
+
+#if UTF8STR_WITH_GRAPHEME
+    const utf8proc_int32_t family[] = {0x1F468, 0x200D, 0x1F469, 0x200D, 0x1F467};
+    const utf8proc_int32_t rainbow[] = {0x1F3F3, 0xFE0F, 0x200D, 0x1F308};
+    const utf8proc_int32_t lone_zwj[] = {'a', 0x200D, 0x1F308};
+    const utf8proc_int32_t flags[] = {0x1F1E9, 0x1F1EA, 0x1F1EB};
+    ut_assert("ZWJ sequence cluster", count_graphemes(family, 5) == 1 && count_graphemes(rainbow, 4) == 1);
+    ut_assert("Lone ZWJ breaks", count_graphemes(lone_zwj, 3) == 2);
+    ut_assert("Flag clusters", count_graphemes(flags, 3) == 2);
+#endif
+
+    return 0;
+}
+
+const char* test_utf_quick_check() {
+    const unsigned int all = UTF8_QUICK_DONE | UTF8_QUICK_ASCII | UTF8_QUICK_NFC | UTF8_QUICK_NARROW;
+    ut_assert("NULL quick check", utf8str_quick_check(NULL, 0) == 0);
+    ut_assert("Empty quick check", utf8str_quick_check("", 0) == all);
+    ut_assert("ASCII quick check", utf8str_quick_check("hello", 0) == (all | UTF8_QUICK_CASE_MAP)
+            && utf8str_quick_check("12 + 3 = 15", 0) == all);
+    ut_assert("Long ASCII", utf8str_quick_check("0123456789 0123456789 0123456789 0123456789 x", 0) == (all | UTF8_QUICK_CASE_MAP)
+            && utf8str_quick_check("0123456789 0123456789 0123456789 0123456789 x", 44) == all);
+    ut_assert("Control", utf8str_quick_check("0123456789 0123456789 0123456789 01234\t", 0)
+            == (UTF8_QUICK_DONE | UTF8_QUICK_ASCII | UTF8_QUICK_NFC | UTF8_QUICK_CONTROL)
+            && (utf8str_quick_check("a\xe2\x80\x8f", 0) & UTF8_QUICK_CONTROL));
+    unsigned int flags = utf8str_quick_check("e\xcc\x81", 0);
+    ut_assert("Combining mark", flags == (UTF8_QUICK_DONE | UTF8_QUICK_COMBINING | UTF8_QUICK_CASE_MAP | (0xCC << 8))
+            && UTF8_QUICK_MAX_LEAD(flags) == 0xCC);
+    ut_assert("Not NFC", !(utf8str_quick_check("\xe2\x84\xab", 0) & UTF8_QUICK_NFC)
+            && !(utf8str_quick_check("e\xcc\x81", 0) & UTF8_QUICK_NFC)
+            && !(utf8str_quick_check("a\xcc\x85\xcc\x96", 0) & UTF8_QUICK_NFC)
+            && (utf8str_quick_check("a\xcc\x96\xcc\x85", 0) & UTF8_QUICK_NFC));
+    flags = utf8str_quick_check("2 + 2 = \xe5\x9b\x9b", 0);
+    ut_assert("Wide", !(flags & (UTF8_QUICK_NARROW | UTF8_QUICK_CASE_MAP | UTF8_QUICK_ASCII)) && UTF8_QUICK_MAX_LEAD(flags) == 0xE5);
+    ut_assert("Case folding only", utf8str_quick_check("\xc3\x9f", 0) & UTF8_QUICK_CASE_MAP);
+    flags = utf8str_quick_check("ab\xff", 0);
+    ut_assert("Invalid", (flags & UTF8_QUICK_INVALID) && !(flags & UTF8_QUICK_ASCII));
+
+#if UTF8STR_WITH_CASE
+    char buf[64];
+    size_t sz;
+    sz = sizeof(buf);
+    ut_assert("Upcase ASCII", utf8str_upcase_quick("Hello, World", buf, &sz, 0) == UTF8_OK
+            && strcmp(buf, "HELLO, WORLD") == 0 && sz == 12);
+    sz = sizeof(buf);
+    ut_assert("Lowcase ASCII", utf8str_lowcase_quick("Hello, World", buf, &sz, utf8str_quick_check("Hello, World", 0)) == UTF8_OK
+            && strcmp(buf, "hello, world") == 0);
+    sz = sizeof(buf);
+    ut_assert("Upcase without case", utf8str_upcase_quick("12 \xe5\x9b\x9b", buf, &sz, 0) == UTF8_OK
+            && strcmp(buf, "12 \xe5\x9b\x9b") == 0 && sz == 6);
+    sz = sizeof(buf);
+    ut_assert("Upcase other", utf8str_upcase_quick("пример", buf, &sz, 0) == UTF8_OK && strcmp(buf, "ПРИМЕР") == 0);
+    sz = 3;
+    ut_assert("Quick buffer small", utf8str_upcase_quick("abc", buf, &sz, 0) == UTF8_BUFFER_SMALL);
+    sz = 0;
+    ut_assert("Quick size", utf8str_lowcase_quick("ABC", NULL, &sz, 0) == UTF8_OK && sz == 3);
+    ut_assert("Quick invalid", utf8str_upcase_quick("ab\xff", buf, NULL, 0) == UTF8_INVALID_UTF
+            && utf8str_upcase_quick(NULL, buf, NULL, 0) == UTF8_INVALID_ARG);
+#if UTF8STR_WITH_NORMALIZATION
+    ut_assert("Fold ASCII", utf8str_fold_key_quick("Hello", 0, buf, sizeof(buf), UTF8_FOLD_NFKC, 0) == 5 && strcmp(buf, "hello") == 0);
+    ut_assert("Fold copy", utf8str_fold_key_quick("\xe5\x9b\x9b!", 0, buf, sizeof(buf), UTF8_FOLD_NFC, 0) == 4
+            && strcmp(buf, "\xe5\x9b\x9b!") == 0);
+    ut_assert("Fold full", utf8str_fold_key_quick("Straße", 0, buf, sizeof(buf), 0, 0) == 7 && strcmp(buf, "strasse") == 0);
+    ut_assert("Fold not NFC", utf8str_fold_key_quick("\xe2\x84\xab", 0, buf, sizeof(buf), UTF8_FOLD_NFC, 0) == 2
+            && strcmp(buf, "\xc3\xa5") == 0);
+    ut_assert("Fold short buffer", utf8str_fold_key_quick("Hello", 0, buf, 3, 0, 0) == 5);
+#endif
+#endif
+#if UTF8STR_WITH_WIDTH
+    ut_assert("Narrow width", utf8str_width_quick("hello", 0, 0) == 5 && utf8str_width_quick("hello", 2, 0) == 2
+            && utf8str_width_quick("пример", 0, 0) == 6);
+    ut_assert("Wide width", utf8str_width_quick("2\xe5\x9b\x9b", 0, 0) == 3 && utf8str_width_quick(NULL, 0, 0) == 0);
+#endif
+
+    return 0;
+}
+
+#if UTF8STR_WITH_WIDTH
 const char* test_utf_width() {
     ut_assert("NULL width", utf8str_width(NULL, 10) == 0);
     ut_assert("Empty string width", utf8str_width("", 10) == 0);
@@ -168,6 +637,417 @@ const char* test_utf_width() {
     return 0;
 }
 
+#if UTF8STR_WITH_GRAPHEME
+const char* test_utf_cluster_width() {
+    const char *ascii = "The quick brown fox jumps over the lazy dog";
+    const char *coder = "\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x92\xbb";
+    const char *flag = "\xf0\x9f\x87\xba\xf0\x9f\x87\xb8";
+    const char *smile = "\xe2\x98\xba\xef\xb8\x8f";
+    const char *keycap = "1\xef\xb8\x8f\xe2\x83\xa3";
+    const char *wave = "\xf0\x9f\x91\x8b\xf0\x9f\x8f\xbd";
+    struct utf8str_width_cache_t cache;
+    char long_accent[64];
+
+    ut_assert("NULL cluster width", utf8str_width_ex(NULL, 0, 0, NULL) == 0 && utf8str_width_ex("", 0, 0, NULL) == 0);
+    ut_assert("ASCII cluster width", utf8str_width_ex(ascii, 0, 0, NULL) == strlen(ascii)
+            && utf8str_width_ex(ascii, 40, 0, NULL) == 40 && utf8str_width_ex("a\tb", 0, 0, NULL) == 2);
+    memset(long_accent, 'a', 40);
+    strcpy(long_accent + 40, "e\xcc\x81");
+    ut_assert("Accent cluster width", utf8str_width_ex("e\xcc\x81", 0, 0, NULL) == 1
+            && utf8str_width_ex(long_accent, 0, 0, NULL) == 41);
+    ut_assert("Wide cluster width", utf8str_width_ex("\xe6\x97\xa5\xe6\x9c\xac", 0, 0, NULL) == 4
+            && utf8str_width_ex("\xe1\x84\x80\xe1\x85\xa1\xe1\x86\xa8", 0, 0, NULL) == 2);
+    ut_assert("ZWJ sequence width", utf8str_width_ex(coder, 0, 0, NULL) == 2 && utf8str_width(coder, 0) == 4);
+    ut_assert("Flag width", utf8str_width_ex(flag, 0, 0, NULL) == 2 && utf8str_width(flag, 0) == 4);
+    ut_assert("Emoji presentation width", utf8str_width_ex(smile, 0, 0, NULL) == 2
+            && utf8str_width_ex(smile, 3, 0, NULL) == 1 && utf8str_width_ex(keycap, 0, 0, NULL) == 2
+            && utf8str_width_ex(wave, 0, 0, NULL) == 2);
+    ut_assert("Emoji text width", utf8str_width_ex(smile, 0, UTF8_WIDTH_EMOJI_TEXT, NULL) == 1
+            && utf8str_width_ex(keycap, 0, UTF8_WIDTH_EMOJI_TEXT, NULL) == 1
+            && utf8str_width_ex(coder, 0, UTF8_WIDTH_EMOJI_TEXT, NULL) == 4);
+    ut_assert("Ambiguous width", utf8str_width_ex("\xc2\xb1\xce\xb1", 0, 0, NULL) == 2
+            && utf8str_width_ex("\xc2\xb1\xce\xb1", 0, UTF8_WIDTH_AMBIGUOUS_WIDE, NULL) == 4
+            && utf8str_width_ex("\xc5\x9b", 0, UTF8_WIDTH_AMBIGUOUS_WIDE, NULL) == 1);
+    ut_assert("Invalid cluster width", utf8str_width_ex("a\xff", 0, 0, NULL) == (size_t)-1
+            && utf8str_width_ex(coder, 3, 0, NULL) == (size_t)-1);
+
+    memset(&cache, 0, sizeof(cache));
+    ut_assert("Cached cluster width", utf8str_width_ex(coder, 0, 0, &cache) == 2
+            && utf8str_width_ex(coder, 0, 0, &cache) == 2 && utf8str_width_ex("e\xcc\x81", 0, 0, &cache) == 1
+            && utf8str_width_ex("e\xcc\x81" "e\xcc\x81", 0, 0, &cache) == 2
+            && utf8str_width_ex(coder, 0, UTF8_WIDTH_EMOJI_TEXT, &cache) == 4);
+    /* a kept cluster is a prefix of a longer one */
+    ut_assert("Cached prefix width", utf8str_width_ex("\xe2\x98\xba\xe2\x80\x8d", 0, 0, &cache) == 1
+            && utf8str_width_ex("\xe2\x98\xba\xe2\x80\x8d\xf0\x9f\x94\xa5", 0, 0, &cache) == 2
+            && utf8str_width_ex("\xe2\x98\xba\xe2\x80\x8d", 0, 0, &cache) == 1);
+    return 0;
+}
+
+static int cut_is(const struct utf8str_truncate_t *cut, size_t head_end, size_t tail_start, size_t width, int ellipsis) {
+    return cut->head_end == head_end && cut->tail_start == tail_start && cut->width == width
+        && cut->ellipsis == ellipsis;
+}
+
+const char* test_utf_truncate_width() {
+    const char *hello = "Hello world";
+    const char *dots = "\xe2\x80\xa6";
+    const char *cjk = "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e";
+    const char *coder = "ab\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x92\xbb" "cd";
+    struct utf8str_truncate_t cut;
+
+    ut_assert("NULL truncate", utf8str_truncate_width(NULL, 0, 8, dots, UTF8_ELIDE_END, 0, &cut) == UTF8_INVALID_ARG
+            && utf8str_truncate_width(hello, 0, 8, dots, UTF8_ELIDE_END, 0, NULL) == UTF8_INVALID_ARG);
+    ut_assert("Truncate fits", utf8str_truncate_width(hello, 0, 11, dots, UTF8_ELIDE_END, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 11, 11, 11, 0)
+            && utf8str_truncate_width("", 0, 0, dots, UTF8_ELIDE_MIDDLE, 0, &cut) == UTF8_OK && cut_is(&cut, 0, 0, 0, 0));
+    ut_assert("Truncate end", utf8str_truncate_width(hello, 0, 8, dots, UTF8_ELIDE_END, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 7, 11, 8, 1));
+    ut_assert("Truncate start", utf8str_truncate_width(hello, 0, 8, "...", UTF8_ELIDE_START, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 0, 6, 8, 1));
+    ut_assert("Truncate middle", utf8str_truncate_width(hello, 0, 8, dots, UTF8_ELIDE_MIDDLE, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 4, 8, 8, 1)
+            && utf8str_truncate_width(hello, 5, 4, NULL, UTF8_ELIDE_MIDDLE, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 2, 3, 4, 0));
+    /* a wide character that does not fit leaves a column free */
+    ut_assert("Truncate wide", utf8str_truncate_width(cjk, 0, 4, dots, UTF8_ELIDE_END, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 3, 9, 3, 1)
+            && utf8str_truncate_width(cjk, 0, 4, dots, UTF8_ELIDE_START, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 0, 6, 3, 1)
+            && utf8str_truncate_width(cjk, 0, 5, dots, UTF8_ELIDE_START, UTF8_WIDTH_AMBIGUOUS_WIDE, &cut) == UTF8_OK
+            && cut_is(&cut, 0, 6, 4, 1));
+    ut_assert("Truncate cluster", utf8str_truncate_width(coder, 0, 4, dots, UTF8_ELIDE_END, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 2, 15, 3, 1)
+            && utf8str_truncate_width(coder, 0, 5, dots, UTF8_ELIDE_END, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 13, 15, 5, 1)
+            && utf8str_truncate_width("e\xcc\x81" "e\xcc\x81" "e", 0, 2, NULL, UTF8_ELIDE_START, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 0, 3, 2, 0));
+    ut_assert("Truncate wide ellipsis", utf8str_truncate_width(hello, 0, 2, "...", UTF8_ELIDE_END, 0, &cut) == UTF8_OK
+            && cut_is(&cut, 2, 11, 2, 0));
+    ut_assert("Invalid truncate", utf8str_truncate_width("a\xff", 0, 8, dots, UTF8_ELIDE_END, 0, &cut) == UTF8_INVALID_UTF
+            && utf8str_truncate_width(hello, 0, 8, "\xff", UTF8_ELIDE_END, 0, &cut) == UTF8_INVALID_UTF);
+    return 0;
+}
+
+static int pad_is(const char *str, size_t cols, const char *fill, enum utf8_pad_mode mode, const char *expected) {
+    char dest[64];
+    size_t size = 0;
+
+    if (utf8str_pad(str, 0, cols, fill, mode, 0, NULL, &size) != UTF8_OK || size != strlen(expected)) {
+        return 0;
+    }
+    size = sizeof(dest);
+    return utf8str_pad(str, 0, cols, fill, mode, 0, dest, &size) == UTF8_OK
+        && size == strlen(expected) && strcmp(dest, expected) == 0;
+}
+
+const char* test_utf_pad() {
+    char buf[64] = "\xe6\x97\xa5\xe6\x9c\xac";
+    size_t size = 0;
+
+    ut_assert("NULL pad", utf8str_pad(NULL, 0, 8, NULL, UTF8_PAD_END, 0, buf, NULL) == UTF8_INVALID_ARG
+            && utf8str_pad("a", 0, 8, "\xcc\x81", UTF8_PAD_END, 0, NULL, &size) == UTF8_INVALID_ARG);
+    ut_assert("Pad invalid", utf8str_pad("a\xff", 0, 8, NULL, UTF8_PAD_END, 0, NULL, &size) == UTF8_INVALID_UTF
+            && utf8str_pad("a", 0, 8, "\xff", UTF8_PAD_END, 0, NULL, &size) == UTF8_INVALID_UTF);
+    ut_assert("Pad spaces", pad_is("Total", 8, NULL, UTF8_PAD_START, "   Total")
+            && pad_is("Total", 8, "", UTF8_PAD_END, "Total   ") && pad_is("Total", 8, NULL, UTF8_PAD_BOTH, " Total  ")
+            && pad_is("", 3, NULL, UTF8_PAD_END, "   "));
+    ut_assert("Pad pattern", pad_is(buf, 9, ".-", UTF8_PAD_END, "\xe6\x97\xa5\xe6\x9c\xac.-.-.")
+            && pad_is("ab", 7, "\xe2\x94\x80\xe2\x95\x90", UTF8_PAD_BOTH,
+                "\xe2\x94\x80\xe2\x95\x90" "ab\xe2\x94\x80\xe2\x95\x90\xe2\x94\x80")
+            && pad_is("x", 41, "0123456789", UTF8_PAD_START, "0123456789012345678901234567890123456789x"));
+    ut_assert("Pad wide fill", pad_is("ab", 5, "\xe6\x97\xa5", UTF8_PAD_END, "ab\xe6\x97\xa5 ")
+            && pad_is("ab", 7, "-\xe6\x97\xa5", UTF8_PAD_START, "-\xe6\x97\xa5- ab"));
+    ut_assert("Pad clusters", pad_is("e\xcc\x81", 3, NULL, UTF8_PAD_START, "  e\xcc\x81"));
+    ut_assert("Pad joining fill", utf8str_pad("ab", 0, 6, "\xcc\x81x", UTF8_PAD_END, 0, NULL, &size) == UTF8_INVALID_ARG
+            && utf8str_pad("ab", 0, 6, "\xe2\x80\x8dx", UTF8_PAD_END, 0, NULL, &size) == UTF8_INVALID_ARG
+            && utf8str_pad("ab", 0, 6, "\xf0\x9f\x91\xa9\xe2\x80\x8d", UTF8_PAD_END, 0, NULL, &size) == UTF8_INVALID_ARG
+            && pad_is("ab", 6, "\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x91\xa9", UTF8_PAD_END,
+                "ab\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x91\xa9\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x91\xa9"));
+    ut_assert("Pad exact", pad_is("Total", 5, "*", UTF8_PAD_BOTH, "Total"));
+    size = sizeof(buf);
+    ut_assert("Pad too long", utf8str_pad("Total", 0, 3, NULL, UTF8_PAD_END, 0, buf, &size) == UTF8_TOO_LONG
+            && size == 5 && strcmp(buf, "Total") == 0);
+    size = 4;
+    ut_assert("Pad buffer small", utf8str_pad("ab", 0, 4, NULL, UTF8_PAD_END, 0, buf, &size) == UTF8_BUFFER_SMALL);
+    size = 5;
+    ut_assert("Pad buffer fits", utf8str_pad("ab", 0, 4, NULL, UTF8_PAD_END, 0, buf, &size) == UTF8_OK
+            && strcmp(buf, "ab  ") == 0);
+    ut_assert("Pad length", utf8str_pad("abcdef", 2, 4, NULL, UTF8_PAD_START, 0, buf, NULL) == UTF8_OK
+            && strcmp(buf, "  ab") == 0);
+    strcpy(buf, "\xd0\xb4\xd0\xb2\xd0\xb0");
+    ut_assert("Pad in place", utf8str_pad(buf, 0, 8, "=-", UTF8_PAD_BOTH, 0, buf, NULL) == UTF8_OK
+            && strcmp(buf, "=-\xd0\xb4\xd0\xb2\xd0\xb0=-=") == 0);
+    return 0;
+}
+
+static int pad_iov_is(const char *str, size_t cols, const struct utf8str_fill_t *fill, enum utf8_pad_mode mode,
+        size_t count, const char *expected) {
+    utf8str_iovec_t iov[8];
+    char joined[64] = "";
+    size_t n = 0;
+
+    if (utf8str_pad_iov(str, 0, cols, fill, mode, NULL, &n) != UTF8_OK || n != count) {
+        return 0;
+    }
+    n = 8;
+    if (utf8str_pad_iov(str, 0, cols, fill, mode, iov, &n) != UTF8_OK || n != count) {
+        return 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (iov[i].iov_len == 0) {
+            return 0;
+        }
+        strncat(joined, (const char*)iov[i].iov_base, iov[i].iov_len);
+    }
+    return strcmp(joined, expected) == 0;
+}
+
+const char* test_utf_pad_iov() {
+    struct utf8str_fill_t dots, spaces, lines, digits, bad;
+    const char *text = "abcdef";
+    utf8str_iovec_t iov[8];
+    size_t n = 0;
+
+    ut_assert("Fill init", utf8str_fill_init(&dots, ".-", 16, 0, NULL) == UTF8_OK
+            && dots.copies == 8 && dots.pattern_width == 2 && strcmp(dots.data, ".-.-.-.-.-.-.-.-") == 0
+            && utf8str_fill_init(&spaces, NULL, 4, 0, NULL) == UTF8_OK && strcmp(spaces.data, "    ") == 0
+            && utf8str_fill_init(&lines, "\xe2\x94\x80\xe2\x95\x90", 4, 0, NULL) == UTF8_OK
+            && utf8str_fill_init(&digits, "0123456789", 0, 0, NULL) == UTF8_OK && digits.copies == 1);
+    ut_assert("Fill invalid", utf8str_fill_init(NULL, ".", 4, 0, NULL) == UTF8_INVALID_ARG
+            && utf8str_fill_init(&bad, "\xcc\x81", 4, 0, NULL) == UTF8_INVALID_ARG && bad.data == NULL
+            && utf8str_fill_init(&bad, "-\xe2\x80\x8d", 4, 0, NULL) == UTF8_INVALID_ARG && bad.data == NULL
+            && utf8str_fill_init(&bad, "\xff", 4, 0, NULL) == UTF8_INVALID_UTF && bad.data == NULL);
+    ut_assert("NULL pad iov", utf8str_pad_iov(NULL, 0, 8, &dots, UTF8_PAD_END, NULL, &n) == UTF8_INVALID_ARG
+            && utf8str_pad_iov("a", 0, 8, NULL, UTF8_PAD_END, NULL, &n) == UTF8_INVALID_ARG
+            && utf8str_pad_iov("a", 0, 8, &dots, UTF8_PAD_END, NULL, NULL) == UTF8_INVALID_ARG
+            && utf8str_pad_iov("a\xff", 0, 8, &dots, UTF8_PAD_END, NULL, &n) == UTF8_INVALID_UTF);
+    ut_assert("Pad iov", pad_iov_is("\xe6\x97\xa5\xe6\x9c\xac", 9, &dots, UTF8_PAD_END, 2,
+                "\xe6\x97\xa5\xe6\x9c\xac.-.-.")
+            && pad_iov_is("ab", 7, &dots, UTF8_PAD_BOTH, 3, ".-ab.-.")
+            && pad_iov_is("Total", 8, &spaces, UTF8_PAD_START, 2, "   Total")
+            && pad_iov_is("", 3, &spaces, UTF8_PAD_END, 1, "   ")
+            && pad_iov_is("Total", 5, &dots, UTF8_PAD_BOTH, 1, "Total"));
+    ut_assert("Pad iov partial pattern", pad_iov_is("ab", 7, &lines, UTF8_PAD_BOTH, 3,
+                "\xe2\x94\x80\xe2\x95\x90" "ab\xe2\x94\x80\xe2\x95\x90\xe2\x94\x80")
+            && pad_iov_is("ab", 5, &digits, UTF8_PAD_START, 2, "012ab"));
+    ut_assert("Pad iov beyond fill", pad_iov_is("x", 21, &spaces, UTF8_PAD_START, 6, "                    x")
+            && pad_iov_is("x", 24, &digits, UTF8_PAD_END, 4, "x01234567890123456789012"));
+    n = 2;
+    ut_assert("Pad iov small", utf8str_pad_iov("ab", 0, 7, &dots, UTF8_PAD_BOTH, iov, &n) == UTF8_BUFFER_SMALL
+            && n == 3 && iov[0].iov_len == 2 && iov[1].iov_len == 2);
+    n = 8;
+    ut_assert("Pad iov too long", utf8str_pad_iov("Total", 0, 3, &dots, UTF8_PAD_END, iov, &n) == UTF8_TOO_LONG
+            && n == 1 && iov[0].iov_len == 5);
+    n = 8;
+    ut_assert("Pad iov length", utf8str_pad_iov(text, 2, 4, &spaces, UTF8_PAD_START, iov, &n) == UTF8_OK
+            && n == 2 && iov[0].iov_len == 2 && iov[1].iov_base == (const void*)text && iov[1].iov_len == 2);
+    utf8str_fill_free(&dots);
+    utf8str_fill_free(&spaces);
+    utf8str_fill_free(&lines);
+    utf8str_fill_free(&digits);
+    ut_assert("Fill free", dots.data == NULL && utf8str_fill_free(NULL) == UTF8_OK);
+    return 0;
+}
+
+static int pos_is(const struct utf8str_colpos_t *pos, size_t byte_offset, size_t char_offset, size_t column) {
+    return pos->byte_offset == byte_offset && pos->char_offset == char_offset && pos->column == column;
+}
+
+const char* test_utf_column_index() {
+    const char *cjk = "ab\xe6\x97\xa5\xe6\x9c\xac" "cd";
+    const char *tabs = "a\tb\t\xe6\x97\xa5x";
+    struct utf8str_colindex_t index;
+    struct utf8str_colpos_t pos;
+    char line[2048];
+    size_t i;
+
+    ut_assert("NULL column index", utf8str_colindex_init(NULL, 8, 0, 0, NULL) == UTF8_INVALID_ARG
+            && utf8str_colindex_init(&index, 0, 0, 0, NULL) == UTF8_INVALID_ARG
+            && utf8str_colindex_free(NULL) == UTF8_OK);
+    utf8str_colindex_init(&index, 8, 0, 0, NULL);
+    ut_assert("Empty column index", utf8str_colindex_append(&index, "", 0) == UTF8_OK
+            && utf8str_colindex_column_to_byte(&index, "", 5, &pos) == UTF8_OK && pos_is(&pos, 0, 0, 0));
+    ut_assert("Wide column index", utf8str_colindex_append(&index, cjk, 0) == UTF8_OK
+            && pos_is(&index.end, 10, 6, 8)
+            && utf8str_colindex_column_to_byte(&index, cjk, 3, &pos) == UTF8_OK && pos_is(&pos, 2, 2, 2)
+            && utf8str_colindex_column_to_byte(&index, cjk, 6, &pos) == UTF8_OK && pos_is(&pos, 8, 4, 6)
+            && utf8str_colindex_byte_to_column(&index, cjk, 4, &pos) == UTF8_OK && pos_is(&pos, 2, 2, 2)
+            && utf8str_colindex_byte_to_column(&index, cjk, 99, &pos) == UTF8_OK && pos_is(&pos, 10, 6, 8));
+    utf8str_colindex_free(&index);
+
+    utf8str_colindex_init(&index, 4, 4, 0, NULL);
+    ut_assert("Tab column index", utf8str_colindex_append(&index, tabs, 0) == UTF8_OK
+            && pos_is(&index.end, 8, 6, 11)
+            && utf8str_colindex_byte_to_column(&index, tabs, 2, &pos) == UTF8_OK && pos_is(&pos, 2, 2, 4)
+            && utf8str_colindex_column_to_byte(&index, tabs, 6, &pos) == UTF8_OK && pos_is(&pos, 3, 3, 5)
+            && utf8str_colindex_column_to_byte(&index, tabs, 9, &pos) == UTF8_OK && pos_is(&pos, 4, 4, 8));
+    utf8str_colindex_free(&index);
+
+    /* appended pieces join the cluster before them or end inside a character */
+    utf8str_colindex_init(&index, 2, 0, 0, NULL);
+    ut_assert("Append column index", utf8str_colindex_append(&index, "abe", 0) == UTF8_OK
+            && utf8str_colindex_append(&index, "abe\xcc", 0) == UTF8_INVALID_UTF && pos_is(&index.end, 2, 2, 2)
+            && utf8str_colindex_append(&index, "abe\xcc\x81", 0) == UTF8_OK && pos_is(&index.end, 5, 4, 3)
+            && utf8str_colindex_append(&index, "abe\xcc\x81xy", 0) == UTF8_OK && pos_is(&index.end, 7, 6, 5)
+            && utf8str_colindex_column_to_byte(&index, "abe\xcc\x81xy", 3, &pos) == UTF8_OK && pos_is(&pos, 5, 4, 3)
+            && utf8str_colindex_byte_to_column(&index, "abe\xcc\x81xy", 4, &pos) == UTF8_OK && pos_is(&pos, 2, 2, 2)
+            && utf8str_colindex_append(&index, "ab", 0) == UTF8_INVALID_ARG);
+    utf8str_colindex_free(&index);
+
+    /* a long line measured from the checkpoints */
+    for (i = 0; i + 7 < sizeof(line); i += 7) {
+        memcpy(line + i, (i / 7) % 3 ? "abcd\xe6\x97\xa5" : "ab\tc\xcc\x81xy", 7);
+    }
+    line[i] = '\0';
+    utf8str_colindex_init(&index, 16, 8, 0, NULL);
+    ut_assert("Long column index", utf8str_colindex_append(&index, line, 0) == UTF8_OK
+            && index.end.byte_offset == strlen(line) && index.end.char_offset == utf8str_count(line));
+    for (i = 0; i <= index.end.byte_offset; i++) {
+        struct utf8str_colpos_t back;
+        utf8str_colindex_byte_to_column(&index, line, i, &pos);
+        utf8str_colindex_column_to_byte(&index, line, pos.column, &back);
+        if (pos.byte_offset > i || back.byte_offset != pos.byte_offset || back.char_offset != pos.char_offset) {
+            break;
+        }
+    }
+    ut_assert("Long column index lookups", i == index.end.byte_offset + 1);
+    utf8str_colindex_free(&index);
+    return 0;
+}
+#if UTF8STR_WITH_LINEBREAK
+struct wrap_lines_t {
+    const char *str;
+    char text[256];
+    size_t lines;
+    size_t stop;
+};
+
+/* Joins the wrapped lines with '|' and checks the reported widths. */
+static int wrap_collect(void *ctx, const struct utf8str_line_t *line) {
+    struct wrap_lines_t *lines = (struct wrap_lines_t *)ctx;
+    size_t used = strlen(lines->text);
+
+    if (used + line->length + 2 > sizeof(lines->text)
+            || (line->length == 0 && line->width != 0)
+            || (line->length != 0 && line->width != utf8str_width_ex(lines->str + line->offset, line->length, 0, NULL))) {
+        return 1;
+    }
+    if (lines->lines++ > 0) {
+        lines->text[used++] = '|';
+    }
+    memcpy(lines->text + used, lines->str + line->offset, line->length);
+    lines->text[used + line->length] = '\0';
+    return lines->stop != 0 && lines->lines == lines->stop;
+}
+
+static int wrap_is(const char *str, size_t len, size_t max_cols, const char *expected) {
+    struct wrap_lines_t lines;
+
+    memset(&lines, 0, sizeof(lines));
+    lines.str = str;
+    return utf8str_wrap(str, len, max_cols, 0, wrap_collect, &lines) == UTF8_OK && strcmp(lines.text, expected) == 0;
+}
+
+const char* test_utf_wrap() {
+    struct wrap_lines_t lines;
+
+    ut_assert("Line break classes", utf8proc_linebreak('a') == UTF8PROC_LINEBREAK_AL
+            && utf8proc_linebreak(' ') == UTF8PROC_LINEBREAK_SP && utf8proc_linebreak('\n') == UTF8PROC_LINEBREAK_LF
+            && utf8proc_linebreak(0x65E5) == UTF8PROC_LINEBREAK_ID && utf8proc_linebreak(0x301) == UTF8PROC_LINEBREAK_CM
+            && utf8proc_linebreak(0x200D) == UTF8PROC_LINEBREAK_ZWJ && utf8proc_linebreak(0x20AC) == UTF8PROC_LINEBREAK_PR
+            && utf8proc_linebreak(0xE01) == UTF8PROC_LINEBREAK_SA && utf8proc_linebreak(0x3400) == UTF8PROC_LINEBREAK_ID);
+    ut_assert("Unassigned line break class", utf8proc_linebreak(0x378) == UTF8PROC_LINEBREAK_XX
+            && utf8proc_linebreak(-1) == UTF8PROC_LINEBREAK_XX && utf8proc_linebreak(0x110000) == UTF8PROC_LINEBREAK_XX);
+    memset(&lines, 0, sizeof(lines));
+    ut_assert("NULL wrap", utf8str_wrap(NULL, 0, 10, 0, wrap_collect, &lines) == UTF8_INVALID_ARG
+            && utf8str_wrap("a", 0, 10, 0, NULL, NULL) == UTF8_INVALID_ARG
+            && utf8str_wrap("a", 0, 0, 0, wrap_collect, &lines) == UTF8_INVALID_ARG);
+    ut_assert("Empty wrap", wrap_is("", 0, 10, "") && wrap_is("   ", 0, 10, ""));
+    ut_assert("Wrap words", wrap_is("The quick brown fox", 0, 10, "The quick|brown fox")
+            && wrap_is("The quick brown fox", 0, 80, "The quick brown fox")
+            && wrap_is("The quick brown fox", 0, 9, "The quick|brown fox")
+            && wrap_is("The quick brown fox", 0, 8, "The|quick|brown|fox"));
+    ut_assert("Wrap hangs spaces", wrap_is("one    two", 0, 5, "one|two")
+            && wrap_is("one two ", 0, 3, "one|two"));
+    ut_assert("Wrap ideographs", wrap_is("\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe3\x83\x86\xe3\x82\xad\xe3\x82\xb9\xe3\x83\x88", 0, 10,
+            "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe3\x83\x86|\xe3\x82\xad\xe3\x82\xb9\xe3\x83\x88"));
+    ut_assert("Wrap numbers", wrap_is("costs $1,000.00 (net)", 0, 10, "costs|$1,000.00|(net)"));
+    ut_assert("Wrap hyphens", wrap_is("well-known e-mail", 0, 10, "well-known|e-mail")
+            && wrap_is("well-known", 0, 6, "well-|known"));
+    ut_assert("Wrap mandatory breaks", wrap_is("a\nb\n\nc\n", 0, 10, "a|b||c")
+            && wrap_is("a\r\nb", 0, 10, "a|b") && wrap_is("a\rb", 0, 10, "a|b"));
+    ut_assert("Wrap emergency break", wrap_is("abcdefghij", 0, 4, "abcd|efgh|ij")
+            && wrap_is("\xe6\x97\xa5\xe6\x9c\xac", 0, 1, "\xe6\x97\xa5|\xe6\x9c\xac"));
+    ut_assert("Wrap keeps clusters", wrap_is("e\xcc\x81" "e\xcc\x81" "e\xcc\x81", 0, 2, "e\xcc\x81" "e\xcc\x81|e\xcc\x81"));
+    ut_assert("Wrap length", wrap_is("The quick brown fox", 9, 5, "The|quick"));
+
+    memset(&lines, 0, sizeof(lines));
+    lines.str = "The quick brown fox";
+    lines.stop = 2;
+    ut_assert("Wrap stops", utf8str_wrap(lines.str, 0, 5, 0, wrap_collect, &lines) == UTF8_OK
+            && lines.lines == 2 && strcmp(lines.text, "The|quick") == 0);
+    memset(&lines, 0, sizeof(lines));
+    lines.str = "ab \xff";
+    ut_assert("Wrap invalid", utf8str_wrap(lines.str, 0, 10, 0, wrap_collect, &lines) == UTF8_INVALID_UTF);
+    return 0;
+}
+
+static int justify_is(struct utf8str_paragraph_t *par, const char *str, const char *expected) {
+    char dest[256];
+    size_t size = 0;
+
+    if (utf8str_paragraph_justify(par, str, 0, NULL, &size) != UTF8_OK || size != strlen(expected)) {
+        return 0;
+    }
+    size = sizeof(dest);
+    return utf8str_paragraph_justify(par, str, 0, dest, &size) == UTF8_OK
+        && size == strlen(expected) && strcmp(dest, expected) == 0;
+}
+
+const char* test_utf_paragraph() {
+    struct utf8str_paragraph_t par;
+    char dest[16];
+    size_t size;
+
+    ut_assert("NULL paragraph", utf8str_paragraph_init(NULL, 16, 0, NULL) == UTF8_INVALID_ARG
+            && utf8str_paragraph_init(&par, 0, 0, NULL) == UTF8_INVALID_ARG
+            && utf8str_paragraph_free(NULL) == UTF8_OK);
+    utf8str_paragraph_init(&par, 16, 0, NULL);
+    ut_assert("NULL paragraph text", utf8str_paragraph_justify(&par, NULL, 0, dest, NULL) == UTF8_INVALID_ARG
+            && utf8str_paragraph_justify(NULL, "a", 0, dest, NULL) == UTF8_INVALID_ARG);
+    ut_assert("Empty paragraph", justify_is(&par, "", "") && justify_is(&par, "   ", ""));
+    ut_assert("Justify lines", justify_is(&par, "The quick brown fox jumps", "The quick  brown\nfox jumps")
+            && justify_is(&par, "The quick brown fox jumps over the lazy dog",
+                "The quick  brown\nfox  jumps  over\nthe lazy dog"));
+    ut_assert("Justify short", justify_is(&par, "a  b", "a  b"));
+    ut_assert("Justify wide", justify_is(&par, "\xe6\x97\xa5\xe6\x9c\xac \xe8\xaa\x9e\xe3\x81\xae \xe3\x83\x86\xe3\x82\xad\xe3\x82\xb9\xe3\x83\x88 \xe3\x82\x92",
+            "\xe6\x97\xa5\xe6\x9c\xac \xe8\xaa\x9e\xe3\x81\xae \xe3\x83\x86\xe3\x82\xad\xe3\x82\xb9\n\xe3\x83\x88 \xe3\x82\x92"));
+    ut_assert("Justify mandatory breaks", justify_is(&par, "Short line\nand a new paragraph that is long\n\n  indented",
+            "Short line\nand    a     new\nparagraph   that\nis long\n\n  indented"));
+    utf8str_paragraph_free(&par);
+
+    utf8str_paragraph_init(&par, 12, 0, NULL);
+    ut_assert("Justify better than filling", justify_is(&par, "dddd a hhh a bb dddd eeeee",
+            "dddd  a  hhh\na  bb   dddd\neeeee"));
+    ut_assert("Justify long words", justify_is(&par, "abcdefghijklmnopqrstuvwxyz x", "abcdefghijkl\nmnopqrstuvwx\nyz x"));
+    size = 8;
+    ut_assert("Justify buffer small", utf8str_paragraph_justify(&par, "dddd a hhh a bb", 0, dest, &size) == UTF8_BUFFER_SMALL);
+    size = sizeof(dest);
+    ut_assert("Justify length", utf8str_paragraph_justify(&par, "dddd a hhh a bb", 10, dest, &size) == UTF8_OK
+            && strcmp(dest, "dddd a hhh") == 0);
+    ut_assert("Justify invalid", utf8str_paragraph_justify(&par, "ab \xff", 0, dest, &size) == UTF8_INVALID_UTF);
+    utf8str_paragraph_free(&par);
+
+    utf8str_paragraph_init(&par, 2, 0, NULL);
+    ut_assert("Justify line-initial space mark", justify_is(&par, "db \xcc\x81\xe4\xb8\x80(",
+            "db\n \xcc\x81\n\xe4\xb8\x80\n("));
+    utf8str_paragraph_free(&par);
+    return 0;
+}
+#endif
+#endif
+#endif
+
 const char* test_utf_substring() {
     const char *ascii = "example";
     const char *utf = "пример";
@@ -259,6 +1139,7 @@ const char* test_utf_reverse() {
     return 0;
 }
 
+#if UTF8STR_WITH_CASE
 const char* test_utf_title_case() {
     char ascii[] = "example Example example";
     char utf[] = "пример Пример\x09пример";
@@ -274,9 +1155,48 @@ const char* test_utf_title_case() {
     ut_assert("ASCII title case", r == UTF8_OK && strcmp(ascii, "Example Example Example") == 0);
     r = utf8str_titlecase(utf);
     ut_assert("UTF title case", r == UTF8_OK && strcmp(utf, "Пример Пример\x09Пример") == 0);
+    char digraph[] = "ǆungla ǉubljana";
+    r = utf8str_titlecase(digraph);
+    ut_assert("Digraph title case", r == UTF8_OK && strcmp(digraph, "ǅungla ǈubljana") == 0);
+
+    return 0;
+}
+
+const char* test_utf_title_case_copy() {
+    char buf[64];
+    size_t sz;
+
+    ut_assert("NULL string title copy", utf8str_titlecase_copy(NULL, buf, NULL, UTF8_TITLE_ALL, NULL) == UTF8_INVALID_ARG);
+    ut_assert("Invalid string title copy", utf8str_titlecase_copy("ab\x89", buf, NULL, UTF8_TITLE_ALL, NULL) == UTF8_INVALID_UTF);
+    ut_assert("Empty string title copy", utf8str_titlecase_copy("", buf, NULL, UTF8_TITLE_ALL, NULL) == UTF8_OK
+            && strcmp(buf, "") == 0);
+    ut_assert("ASCII title copy", utf8str_titlecase_copy("hELLO  wORLD", buf, NULL, UTF8_TITLE_SPACE, NULL) == UTF8_OK
+            && strcmp(buf, "Hello  World") == 0);
+    ut_assert("UTF title copy", utf8str_titlecase_copy("пРИМЕР\tпример", buf, NULL, UTF8_TITLE_SPACE, NULL) == UTF8_OK
+            && strcmp(buf, "Пример\tПример") == 0);
+    ut_assert("Digraph title copy", utf8str_titlecase_copy("ǄUNGLA", buf, NULL, UTF8_TITLE_SPACE, NULL) == UTF8_OK
+            && strcmp(buf, "ǅungla") == 0);
+    ut_assert("First cased letter", utf8str_titlecase_copy("«1st» eXAMPLE", buf, NULL, UTF8_TITLE_SPACE, NULL) == UTF8_OK
+            && strcmp(buf, "«1St» Example") == 0);
+    ut_assert("Space only breaks", utf8str_titlecase_copy("it's jean-luc.picard", buf, NULL, UTF8_TITLE_SPACE, NULL) == UTF8_OK
+            && strcmp(buf, "It's Jean-luc.picard") == 0);
+    ut_assert("Punctuation breaks", utf8str_titlecase_copy("it's jean-luc.picard", buf, NULL,
+                UTF8_TITLE_SPACE | UTF8_TITLE_PUNCT, NULL) == UTF8_OK && strcmp(buf, "It's Jean-luc.Picard") == 0);
+    ut_assert("All breaks", utf8str_titlecase_copy("it's jean-luc.picard", buf, NULL, UTF8_TITLE_ALL, NULL) == UTF8_OK
+            && strcmp(buf, "It's Jean-Luc.Picard") == 0);
+    ut_assert("Extra breaks", utf8str_titlecase_copy("o'neil·smith", buf, NULL, 0, "'·") == UTF8_OK
+            && strcmp(buf, "O'Neil·Smith") == 0);
+    sz = 0;
+    ut_assert("Growing title size", utf8str_titlecase_copy("ɐɐ ȿȿ", NULL, &sz, UTF8_TITLE_SPACE, NULL) == UTF8_OK && sz == 11);
+    sz = 12;
+    ut_assert("Growing title copy", utf8str_titlecase_copy("ɐɐ ȿȿ", buf, &sz, UTF8_TITLE_SPACE, NULL) == UTF8_OK
+            && strcmp(buf, "Ɐɐ Ȿȿ") == 0 && sz == 11);
+    sz = 11;
+    ut_assert("Small buffer title copy", utf8str_titlecase_copy("ɐɐ ȿȿ", buf, &sz, UTF8_TITLE_SPACE, NULL) == UTF8_BUFFER_SMALL);
 
     return 0;
 }
+#endif
 
 const char* test_utf_scrub() {
     char ascii[] = "example Example example";
@@ -386,6 +1306,25 @@ const char* test_utf_tab_replace() {
     size_t orig = strlen(text);
     r = utf8str_expand_tabs(text, dst, &sz, 4);
     ut_assert("Expand normal", r == UTF8_OK && sz == orig+2*4-2 && strcmp(dst, "пример     example     пример") == 0);
+    sz = 64;
+    r = utf8str_expand_tabs_ex("ab\tc\td", dst, &sz, 4, UTF8_TAB_STOPS);
+    ut_assert("Expand tab stops", r == UTF8_OK && sz == 9 && strcmp(dst, "ab  c   d") == 0);
+    sz = 64;
+    r = utf8str_expand_tabs_ex("\xd0\xbf\tc\n\td\xe2\x80\xa8x\t", dst, &sz, 4, UTF8_TAB_STOPS);
+    ut_assert("Expand tab stops lines", r == UTF8_OK
+            && strcmp(dst, "\xd0\xbf   c\n    d\xe2\x80\xa8x   ") == 0 && sz == strlen(dst));
+#if UTF8STR_WITH_WIDTH && UTF8STR_WITH_GRAPHEME
+    sz = 64;
+    r = utf8str_expand_tabs_ex("\xe6\x97\xa5\te\xcc\x81\xc2\xb1\t|", dst, &sz, 4, UTF8_TAB_STOPS | UTF8_WIDTH_AMBIGUOUS_WIDE);
+    ut_assert("Expand tab stops width", r == UTF8_OK
+            && strcmp(dst, "\xe6\x97\xa5  e\xcc\x81\xc2\xb1 |") == 0);
+#endif
+    sz = 0;
+    r = utf8str_expand_tabs_ex("\tab\t", NULL, &sz, 8, UTF8_TAB_STOPS);
+    ut_assert("Calculate tab stops", r == UTF8_OK && sz == 8 + 2 + 6);
+    sz = 64;
+    r = utf8str_expand_tabs_ex("a\tb\xff", dst, &sz, 4, UTF8_TAB_STOPS);
+    ut_assert("Invalid tab stops", r == UTF8_INVALID_UTF);
 
     return 0;
 }
@@ -494,6 +1433,12 @@ const char* test_utf_justify() {
     strcpy(s3, s4);
     r = utf8str_mjustify(s3, clen + 10);
     ut_assert("MJustify greater than word count by some", r == UTF8_OK && strcmp(s3, "exámple    akña     some    text     два") == 0);
+    strcpy(s3, " a b ");
+    r = utf8str_mjustify(s3, 8);
+    ut_assert("MJustify keeps outer spaces", r == UTF8_OK && strcmp(s3, " a    b ") == 0);
+    strcpy(s3, "a b c");
+    r = utf8str_mjustify(s3, 6);
+    ut_assert("MJustify odd space", r == UTF8_OK && strcmp(s3, "a b  c") == 0);
 
     return 0;
 }
@@ -635,23 +1580,78 @@ const char* test_utf_word_iterator() {
     return 0;
 }
 
+#if UTF8STR_EXTERNAL_DATA
+static const char * test_data_file() {
+    ut_assert("Missing file", utf8proc_load_data("no such file") == UTF8PROC_ERROR_INVALIDDATA);
+
+    const char *bad_path = "utf8test_bad.dat";
+    FILE *bad = fopen(bad_path, "wb");
+    ut_assert("Bad file created", bad != NULL);
+    fputs("utf8proc data, but not the tables", bad);
+    fclose(bad);
+    ut_assert("Bad file", utf8proc_load_data(bad_path) == UTF8PROC_ERROR_INVALIDDATA);
+    remove(bad_path);
+
+    ut_assert("Tables kept", utf8proc_unicode_version()[0] != '\0');
+    ut_assert("Reload", utf8proc_load_data(UTF8TEST_DATA_FILE) == 0);
+    ut_assert("Lookup", utf8proc_category(0x0416) == UTF8PROC_CATEGORY_LU);
+
+    return 0;
+}
+
+#endif
 const char * run_all_test() {
     printf("=== Basic operations ===\n");
+#if UTF8STR_EXTERNAL_DATA
+    ut_run_test("Data file", test_data_file);
+#endif
     ut_run_test("String Length", test_strlen);
     ut_run_test("Valid UTF", test_utf_valid);
     ut_run_test("Char at", test_utf_at);
+#if UTF8STR_WITH_CASE
     ut_run_test("Lowcase and Upcase", test_utf_cases);
     ut_run_test("Lowcase and Upcase inplace", test_utf_cases_inplace);
+    ut_run_test("Lowcase and Upcase inplace with size", test_utf_cases_inplace_sz);
+    ut_run_test("Lowcase and Upcase allocating", test_utf_cases_alloc);
+    ut_run_test("Lowcase and Upcase with locale", test_utf_cases_locale);
     ut_run_test("Compare no case", test_utf_iequal);
+#if UTF8STR_WITH_NORMALIZATION
+    ut_run_test("Fold key", test_utf_fold_key);
+#endif
+#endif
     ut_run_test("Starts and ends with", test_utf_starts);
+#if UTF8STR_WITH_CASE
+    ut_run_test("Find no case", test_utf_find_no_case);
+#endif
     ut_run_test("Categories", test_utf_categories);
+#if UTF8STR_WITH_SCRIPT
+    ut_run_test("Scripts", test_utf_scripts);
+#endif
+    ut_run_test("Emoji", test_utf_emoji);
+    ut_run_test("Quick check", test_utf_quick_check);
+#if UTF8STR_WITH_WIDTH
     ut_run_test("Width", test_utf_width);
+#if UTF8STR_WITH_GRAPHEME
+    ut_run_test("Cluster width", test_utf_cluster_width);
+    ut_run_test("Truncate width", test_utf_truncate_width);
+    ut_run_test("Pad", test_utf_pad);
+    ut_run_test("Pad iov", test_utf_pad_iov);
+    ut_run_test("Column index", test_utf_column_index);
+#if UTF8STR_WITH_LINEBREAK
+    ut_run_test("Line wrap", test_utf_wrap);
+    ut_run_test("Paragraph justify", test_utf_paragraph);
+#endif
+#endif
+#endif
     ut_run_test("Substring", test_utf_substring);
     ut_run_test("Char next and back", test_utf_moving);
     ut_run_test("Reverse", test_utf_reverse);
 
     printf("\n=== Extra functions ===\n");
+#if UTF8STR_WITH_CASE
     ut_run_test("Title case", test_utf_title_case);
+    ut_run_test("Title case copy", test_utf_title_case_copy);
+#endif
     ut_run_test("Scrub", test_utf_scrub);
     ut_run_test("Word count", test_utf_word_count);
     ut_run_test("Translate", test_utf_translate);
@@ -664,6 +1664,12 @@ const char * run_all_test() {
 }
 
 int main() {
+#if UTF8STR_EXTERNAL_DATA
+    if (utf8proc_load_data(UTF8TEST_DATA_FILE) != 0) {
+        printf("Cannot load %s\n", UTF8TEST_DATA_FILE);
+        return 1;
+    }
+#endif
     const char* res = run_all_test();
     if (res && tests_fail == 0) {
         printf("%s\n", res);
@@ -0,0 +1,30 @@
+# Prints the code and read-only data sizes of every object of a static library
+# and their totals from the output of binutils size:
+#     cmake -DSIZE_TOOL=size -DLIBRARY=libutf8string.a -P sizereport.cmake
+execute_process(COMMAND ${SIZE_TOOL} -A ${LIBRARY}
+    OUTPUT_VARIABLE output_ RESULT_VARIABLE result_)
+if (NOT result_ EQUAL 0)
+    message(FATAL_ERROR "${SIZE_TOOL} failed for ${LIBRARY}")
+endif()
+
+string(REPLACE "\n" ";" lines_ "${output_}")
+set(object_ "")
+set(total_text_ 0)
+set(total_rodata_ 0)
+foreach(line_ ${lines_} "")
+    if (line_ MATCHES "^([^ ]+) +\\(ex ")
+        set(object_ ${CMAKE_MATCH_1})
+        set(text_ 0)
+        set(rodata_ 0)
+    elseif (line_ MATCHES "^\\.text[^ ]* +([0-9]+)")
+        math(EXPR text_ "${text_} + ${CMAKE_MATCH_1}")
+    elseif (line_ MATCHES "^\\.(rodata|data\\.rel\\.ro)[^ ]* +([0-9]+)")
+        math(EXPR rodata_ "${rodata_} + ${CMAKE_MATCH_2}")
+    elseif (line_ MATCHES "^Total" AND object_)
+        message("${object_}: code ${text_}, read-only data ${rodata_}")
+        math(EXPR total_text_ "${total_text_} + ${text_}")
+        math(EXPR total_rodata_ "${total_rodata_} + ${rodata_}")
+        set(object_ "")
+    endif()
+endforeach()
+message("Total: code ${total_text_}, read-only data ${total_rodata_}")
@@ -0,0 +1,224 @@
+/* Generates src/utf8string_data.c: a three-level table that maps every code
+ * point to a mask of utf8_char_class flags, and the UTF8 prefixes of emoji
+ * for utf8str_emoji_next. The classes are derived from the
+ * utf8proc character database, so run the tool after updating utf8proc data:
+ *     utf8classgen > src/utf8string_data.c
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "utf8proc.h"
+#include "utf8string.h"
+
+#define MAX_CP 0x110000
+/* the table is a three-level trie(see utf8str_class_cp): the top level is
+ * indexed by the highest bits of a code point, its entries select a middle
+ * block, and those select a leaf of masks. Identical blocks are stored once */
+#define LEAF_BITS UTF8STR_CLASS_LEAF_BITS
+#define MID_BITS UTF8STR_CLASS_MID_BITS
+#define LEAF_SIZE (1 << LEAF_BITS)
+#define MID_SIZE (1 << MID_BITS)
+#define LEAF_COUNT (MAX_CP / LEAF_SIZE)
+#define TOP_COUNT (LEAF_COUNT / MID_SIZE)
+/* number of utf8_char_class flags */
+#define CLASS_BITS 12
+
+static unsigned int class_mask(utf8proc_int32_t cp) {
+    if (cp >= 0xD800 && cp < 0xE000) {
+        return 0;
+    }
+
+    utf8proc_category_t ctg = utf8proc_category(cp);
+    unsigned int mask = 0;
+
+    switch (ctg) {
+        case UTF8PROC_CATEGORY_LU:
+        case UTF8PROC_CATEGORY_LT:
+            mask |= UTF8_CLASS_UPPER | UTF8_CLASS_ALPHA | UTF8_CLASS_CASED | UTF8_CLASS_WORD;
+            break;
+        case UTF8PROC_CATEGORY_LL:
+            mask |= UTF8_CLASS_LOWER | UTF8_CLASS_ALPHA | UTF8_CLASS_CASED | UTF8_CLASS_WORD;
+            break;
+        case UTF8PROC_CATEGORY_LO:
+            mask |= UTF8_CLASS_ALPHA | UTF8_CLASS_WORD;
+            break;
+        case UTF8PROC_CATEGORY_LM:
+            mask |= UTF8_CLASS_WORD;
+            break;
+        case UTF8PROC_CATEGORY_MN:
+        case UTF8PROC_CATEGORY_MC:
+            mask |= UTF8_CLASS_MARK | UTF8_CLASS_WORD;
+            break;
+        case UTF8PROC_CATEGORY_ME:
+            mask |= UTF8_CLASS_MARK;
+            break;
+        case UTF8PROC_CATEGORY_ND:
+            mask |= UTF8_CLASS_DIGIT | UTF8_CLASS_WORD;
+            break;
+        case UTF8PROC_CATEGORY_NL:
+        case UTF8PROC_CATEGORY_NO:
+            mask |= UTF8_CLASS_DIGIT;
+            break;
+        case UTF8PROC_CATEGORY_PC:
+            mask |= UTF8_CLASS_PUNCT | UTF8_CLASS_WORD;
+            break;
+        case UTF8PROC_CATEGORY_PD:
+        case UTF8PROC_CATEGORY_PS:
+        case UTF8PROC_CATEGORY_PE:
+        case UTF8PROC_CATEGORY_PI:
+        case UTF8PROC_CATEGORY_PF:
+        case UTF8PROC_CATEGORY_PO:
+            mask |= UTF8_CLASS_PUNCT;
+            break;
+        case UTF8PROC_CATEGORY_SM:
+        case UTF8PROC_CATEGORY_SC:
+        case UTF8PROC_CATEGORY_SK:
+        case UTF8PROC_CATEGORY_SO:
+            mask |= UTF8_CLASS_SYMBOL;
+            break;
+        case UTF8PROC_CATEGORY_ZS:
+            mask |= UTF8_CLASS_SPACE;
+            break;
+        case UTF8PROC_CATEGORY_CC:
+            mask |= UTF8_CLASS_CNTRL;
+            break;
+        default:
+            break;
+    }
+
+    if (cp >= 0x09 && cp <= 0x0D) {
+        mask |= UTF8_CLASS_SPACE;
+    }
+
+    /* the same categories utf8str_isprint has always excluded */
+    if (ctg != UTF8PROC_CATEGORY_CN &&
+        ctg != UTF8PROC_CATEGORY_LM &&
+        ctg != UTF8PROC_CATEGORY_MN &&
+        ctg != UTF8PROC_CATEGORY_ME &&
+        ctg != UTF8PROC_CATEGORY_MC &&
+        ctg != UTF8PROC_CATEGORY_ZS &&
+        ctg != UTF8PROC_CATEGORY_ZL &&
+        ctg != UTF8PROC_CATEGORY_ZP &&
+        ctg != UTF8PROC_CATEGORY_CC &&
+        ctg != UTF8PROC_CATEGORY_CF &&
+        ctg != UTF8PROC_CATEGORY_CO &&
+        ctg != UTF8PROC_CATEGORY_CS) {
+        mask |= UTF8_CLASS_PRINT;
+    }
+
+    return mask;
+}
+
+/* Appends a block of block_bytes bytes to the array of unique blocks unless
+ * the same block is already there. Returns the index of the block */
+static unsigned int add_block(void *blocks, size_t *nblocks, const void *src, size_t block_bytes) {
+    unsigned char *base = (unsigned char *)blocks;
+    for (size_t i = 0; i < *nblocks; i++) {
+        if (memcmp(base + i * block_bytes, src, block_bytes) == 0) {
+            return (unsigned int)i;
+        }
+    }
+    memcpy(base + *nblocks * block_bytes, src, block_bytes);
+    return (unsigned int)(*nblocks)++;
+}
+
+static void print_array(const char *type, const char *name, const unsigned short *data, size_t count, int hex) {
+    printf("const %s %s[] = {", type, name);
+    for (size_t i = 0; i < count; i++) {
+        if (hex) {
+            printf("%s0x%04X,", (i % 12 == 0) ? "\n  " : " ", data[i]);
+        } else {
+            printf("%s%u,", (i % 16 == 0) ? "\n  " : " ", data[i]);
+        }
+    }
+    printf("\n};\n\n");
+}
+
+int main(void) {
+    unsigned short *leaves = (unsigned short *)malloc(MAX_CP * sizeof(*leaves));
+    unsigned short *leaf_idx = (unsigned short *)malloc(LEAF_COUNT * sizeof(*leaf_idx));
+    unsigned short *mids = (unsigned short *)malloc(LEAF_COUNT * sizeof(*mids));
+    unsigned short top[TOP_COUNT];
+    unsigned short leaf[LEAF_SIZE];
+    size_t nleaves = 0, nmids = 0;
+
+    if (leaves == NULL || leaf_idx == NULL || mids == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (size_t l = 0; l < LEAF_COUNT; l++) {
+        for (size_t i = 0; i < LEAF_SIZE; i++) {
+            leaf[i] = (unsigned short)class_mask((utf8proc_int32_t)(l * LEAF_SIZE + i));
+        }
+        leaf_idx[l] = (unsigned short)add_block(leaves, &nleaves, leaf, sizeof(leaf));
+    }
+    for (size_t t = 0; t < TOP_COUNT; t++) {
+        top[t] = (unsigned short)add_block(mids, &nmids, leaf_idx + t * MID_SIZE,
+                MID_SIZE * sizeof(*leaf_idx));
+    }
+
+    /* the header declares the top level as 8-bit and others as 16-bit */
+    if (nmids > 0x100 || nleaves > 0x10000) {
+        fprintf(stderr, "Too many unique blocks(%u middle, %u leaves), change block sizes\n",
+                (unsigned int)nmids, (unsigned int)nleaves);
+        return 1;
+    }
+
+    size_t nleaf_items = nleaves * LEAF_SIZE, nmid_items = nmids * MID_SIZE;
+    printf("/* Generated by tools/utf8classgen.c from utf8proc %s data.\n",
+            utf8proc_version());
+    printf(" * Do not edit: run utf8classgen to regenerate.\n");
+    printf(" * Size: %u bytes(top %u, middle %u, leaves %u)\n */\n\n",
+            (unsigned int)(TOP_COUNT + nmid_items * 2 + nleaf_items * 2),
+            (unsigned int)TOP_COUNT, (unsigned int)(nmid_items * 2),
+            (unsigned int)(nleaf_items * 2));
+
+    print_array("utf8proc_uint8_t", "utf8str_class_top", top, TOP_COUNT, 0);
+    print_array("utf8proc_uint16_t", "utf8str_class_mid", mids, nmid_items, 0);
+    print_array("utf8proc_uint16_t", "utf8str_class_leaf", leaves, nleaf_items, 1);
+
+    /* ASCII characters of every class in the layout of span sets: bit N of
+     * row[c & 0x0F] is on for character c with c >> 4 == N */
+    printf("static const utf8proc_uint8_t utf8str_class_ascii[%d][16] = {\n", CLASS_BITS);
+    for (int b = 0; b < CLASS_BITS; b++) {
+        unsigned char row[16] = {0};
+        for (int c = 0; c < 0x80; c++) {
+            if (class_mask(c) & (1u << b)) {
+                row[c & 0x0F] |= (unsigned char)(1 << (c >> 4));
+            }
+        }
+        printf("  {");
+        for (int i = 0; i < 16; i++) {
+            printf("%s0x%02X", i == 0 ? "" : ", ", row[i]);
+        }
+        printf("},\n");
+    }
+    printf("};\n");
+
+    /* the first two bytes of the UTF8 sequences of non-ASCII characters that
+     * can start an emoji sequence: bit N of the entry for lead byte L is on
+     * if a character starts with L and a byte with the low bits N */
+    unsigned long long prefix[64] = {0};
+    for (utf8proc_int32_t cp = 0x80; cp < MAX_CP; cp++) {
+        utf8proc_uint8_t buf[4];
+        if ((cp >= 0xD800 && cp < 0xE000)
+                || !(utf8proc_emoji(cp) & (UTF8PROC_EMOJI | UTF8PROC_EXTENDED_PICTOGRAPHIC))) {
+            continue;
+        }
+        utf8proc_encode_char(cp, buf);
+        prefix[buf[0] & 0x3F] |= 1ULL << (buf[1] & 0x3F);
+    }
+    printf("\nstatic const uint64_t utf8str_emoji_prefix[64] = {");
+    for (int i = 0; i < 64; i++) {
+        printf("%s0x%016llXULL,", (i % 4 == 0) ? "\n  " : " ", prefix[i]);
+    }
+    printf("\n};\n");
+
+    free(leaves);
+    free(leaf_idx);
+    free(mids);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/* Writes the Unicode tables of src/utf8proc_data.c to a data file for the
+ * libraries built with UTF8STR_EXTERNAL_DATA(see utf8proc_load_data):
+ *     utf8datafile utf8proc.dat
+ * The file has the byte order and structure layout of the compiler the tool
+ * is built with, so build it with the compiler and data of the library.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* the tool reads the compiled-in tables, all of them */
+#undef UTF8STR_EXTERNAL_DATA
+#define UTF8STR_EXTERNAL_DATA 0
+#undef UTF8STR_WITH_NORMALIZATION
+#define UTF8STR_WITH_NORMALIZATION 1
+#undef UTF8STR_WITH_CASE
+#define UTF8STR_WITH_CASE 1
+#undef UTF8STR_WITH_WIDTH
+#define UTF8STR_WITH_WIDTH 1
+#undef UTF8STR_WITH_GRAPHEME
+#define UTF8STR_WITH_GRAPHEME 1
+#undef UTF8STR_WITH_SCRIPT
+#define UTF8STR_WITH_SCRIPT 1
+#undef UTF8STR_WITH_LINEBREAK
+#define UTF8STR_WITH_LINEBREAK 1
+#define UTF8PROC_DATA_WRITER
+#include "../src/utf8proc.c"
+
+#define TABLE(id, table) {id, table, sizeof(table), sizeof(table[0])}
+
+struct data_table {
+    int id;
+    const void *data;
+    size_t size;
+    size_t item_size;
+};
+
+static const struct data_table tables[] = {
+    TABLE(UTF8PROC_DATA_SEQUENCES, utf8proc_sequences),
+    TABLE(UTF8PROC_DATA_STAGE1, utf8proc_stage1table),
+    TABLE(UTF8PROC_DATA_STAGE2, utf8proc_stage2table),
+#if UTF8PROC_TABLE_STAGES == 3
+    TABLE(UTF8PROC_DATA_STAGE3, utf8proc_stage3table),
+#endif
+    TABLE(UTF8PROC_DATA_PROPERTIES, utf8proc_properties),
+    TABLE(UTF8PROC_DATA_HOT_PROPERTIES, utf8proc_hot_properties),
+    TABLE(UTF8PROC_DATA_COMBINATIONS, utf8proc_combinations),
+    TABLE(UTF8PROC_DATA_SCRIPT_STAGE1, utf8proc_script_stage1),
+    TABLE(UTF8PROC_DATA_SCRIPT_STAGE2, utf8proc_script_stage2),
+    TABLE(UTF8PROC_DATA_SCRIPT_SETS, utf8proc_script_sets),
+    TABLE(UTF8PROC_DATA_SCRIPT_SET_INDEX, utf8proc_script_set_index),
+    TABLE(UTF8PROC_DATA_LINEBREAK_STAGE1, utf8proc_linebreak_stage1),
+    TABLE(UTF8PROC_DATA_LINEBREAK_STAGE2, utf8proc_linebreak_stage2),
+};
+
+#define TABLE_COUNT (sizeof(tables) / sizeof(tables[0]))
+
+static size_t align(size_t offset) {
+    return (offset + UTF8PROC_DATA_ALIGN - 1) / UTF8PROC_DATA_ALIGN * UTF8PROC_DATA_ALIGN;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: utf8datafile OUTPUT\n");
+        return 2;
+    }
+    if (sizeof(utf8proc_stage1table[0]) != sizeof(utf8proc_uint16_t)
+            || sizeof(utf8proc_stage2table[0]) != sizeof(utf8proc_uint16_t)
+            || sizeof(utf8proc_script_stage1[0]) != sizeof(utf8proc_uint16_t)
+            || sizeof(utf8proc_linebreak_stage1[0]) != sizeof(utf8proc_uint16_t)) {
+        fprintf(stderr, "utf8datafile: data files need 16-bit stage tables, choose a smaller layout\n");
+        return 1;
+    }
+
+    utf8proc_data_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, UTF8PROC_DATA_MAGIC, sizeof(UTF8PROC_DATA_MAGIC));
+    header.format = UTF8PROC_DATA_FORMAT;
+    header.byte_order = UTF8PROC_DATA_BYTE_ORDER;
+    strncpy(header.unicode_version, UTF8PROC_UNICODE_VERSION, sizeof(header.unicode_version) - 1);
+    header.stages = UTF8PROC_TABLE_STAGES;
+    header.stage2_bits = UTF8PROC_STAGE2_BITS;
+#if UTF8PROC_TABLE_STAGES == 3
+    header.stage3_bits = UTF8PROC_STAGE3_BITS;
+#endif
+    header.script_bits = UTF8PROC_SCRIPT_BITS;
+    header.script_extension_base = UTF8PROC_SCRIPT_EXTENSION_BASE;
+    header.linebreak_bits = UTF8PROC_LINEBREAK_BITS;
+
+    /* absent tables are empty, at the end of the header */
+    size_t size = align(sizeof(header));
+    for (int i = 0; i < UTF8PROC_DATA_TABLES; i++) {
+        header.tables[i].offset = (utf8proc_uint32_t)size;
+        header.tables[i].item_size = sizeof(utf8proc_uint16_t);
+    }
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+        header.tables[tables[i].id].offset = (utf8proc_uint32_t)size;
+        header.tables[tables[i].id].count = (utf8proc_uint32_t)(tables[i].size / tables[i].item_size);
+        header.tables[tables[i].id].item_size = (utf8proc_uint32_t)tables[i].item_size;
+        size = align(size + tables[i].size);
+    }
+    header.size = (utf8proc_uint32_t)size;
+
+    utf8proc_uint8_t *data = (utf8proc_uint8_t *)calloc(size, 1);
+    if (data == NULL) {
+        fprintf(stderr, "utf8datafile: out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < TABLE_COUNT; i++) {
+        memcpy(data + header.tables[tables[i].id].offset, tables[i].data, tables[i].size);
+    }
+    header.checksum = data_checksum(data + sizeof(header), size - sizeof(header));
+    memcpy(data, &header, sizeof(header));
+
+    FILE *out = fopen(argv[1], "wb");
+    if (out == NULL || fwrite(data, 1, size, out) != size || fclose(out) != 0) {
+        fprintf(stderr, "utf8datafile: cannot write %s\n", argv[1]);
+        free(data);
+        return 1;
+    }
+    free(data);
+    fprintf(stderr, "Unicode %s data, %u bytes\n", UTF8PROC_UNICODE_VERSION, (unsigned int)size);
+    return 0;
+}
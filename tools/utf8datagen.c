@@ -0,0 +1,1345 @@
+/* Generates src/utf8proc_data.c from the Unicode Character Database text
+ * files in a local directory:
+ *     utf8datagen [-s 2|3] [-b bits] [-m bits] UCD_DIR > src/utf8proc_data.c
+ *
+ * Files read from UCD_DIR(GraphemeBreakProperty.txt may be in the
+ * auxiliary subdirectory as in the UCD archive):
+ *     UnicodeData.txt, CaseFolding.txt, CompositionExclusions.txt,
+ *     DerivedCoreProperties.txt, GraphemeBreakProperty.txt
+ *     CharWidths.txt - widths generated by utf8proc charwidths.jl. Without
+ *         it the widths are derived from EastAsianWidth.txt
+ *     EastAsianWidth.txt - the East Asian Ambiguous characters. Without it
+ *         and CharWidths.txt no character is ambiguous
+ *     Scripts.txt, ScriptExtensions.txt
+ *     LineBreak.txt
+ *     emoji-data.txt - may be in the emoji subdirectory. Its
+ *         Extended_Pictographic code points get that grapheme break class
+ *         where GraphemeBreakProperty.txt has none
+ *
+ * Layout options: code points are mapped to property entries with either two
+ * stages(default) or three stages of tables. -b sets the number of code point
+ * bits resolved by the last stage(default 8), -m the bits resolved by the
+ * middle stage of the three-stage layout(default 4). Smaller blocks are
+ * shared more often, so the tables are smaller, but a three-stage lookup
+ * reads one more table. The sizes are reported to stderr, the lookup speed
+ * is measured by utf8bench. Scripts are kept in a separate two-stage table
+ * of bytes with blocks of 1 << SCRIPT_BITS code points, line breaking
+ * classes in another one with blocks of 1 << LINEBREAK_BITS.
+ *
+ * The sequences, properties and combinations are built in the same order as
+ * the generator of utf8proc 2.0.2, so the data of the same Unicode version
+ * stays comparable.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdint.h>
+
+#define MAX_CP 0x110000
+#define NO_VALUE 0xFFFF
+#define MAX_DECOMP 20
+#define LINE_SIZE 1024
+
+/* sequences are addressed with 13 bits, the other 3 bits keep the length */
+#define SEQ_INDEX_MAX 0x1FFF
+#define SEQ_LONG 7
+
+static const char *categories[] = {
+    "Cn", "Lu", "Ll", "Lt", "Lm", "Lo", "Mn", "Mc", "Me", "Nd", "Nl", "No",
+    "Pc", "Pd", "Ps", "Pe", "Pi", "Pf", "Po", "Sm", "Sc", "Sk", "So", "Zs",
+    "Zl", "Zp", "Cc", "Cf", "Cs", "Co", NULL
+};
+static const char *bidi_classes[] = {
+    "", "L", "LRE", "LRO", "R", "AL", "RLE", "RLO", "PDF", "EN", "ES", "ET",
+    "AN", "CS", "NSM", "BN", "B", "S", "WS", "ON", "LRI", "RLI", "FSI", "PDI",
+    NULL
+};
+static const char *decomp_types[] = {
+    "", "font", "noBreak", "initial", "medial", "final", "isolated", "circle",
+    "super", "sub", "vertical", "wide", "narrow", "small", "square",
+    "fraction", "compat", NULL
+};
+/* in the order of utf8proc_boundclass_t */
+static const char *boundclasses[] = {
+    "START", "OTHER", "CR", "LF", "CONTROL", "EXTEND", "L", "V", "T", "LV",
+    "LVT", "REGIONAL_INDICATOR", "SPACINGMARK", "PREPEND", "ZWJ", "E_BASE",
+    "E_MODIFIER", "GLUE_AFTER_ZWJ", "E_BASE_GAZ", "EXTENDED_PICTOGRAPHIC", NULL
+};
+#define BOUNDCLASS_OTHER 1
+#define BOUNDCLASS_EXTENDED_PICTOGRAPHIC 19
+/* emoji-data.txt properties and their utf8proc_emoji_t flags, the others
+ * are not stored */
+static const struct {
+    const char *name;
+    int flag;
+} emoji_properties[] = {
+    {"Emoji", 1}, {"Emoji_Presentation", 2}, {"Emoji_Modifier_Base", 4},
+    {"Extended_Pictographic", 8}, {"Emoji_Modifier", 16},
+};
+#define EMOJI_EXTENDED_PICTOGRAPHIC 8
+/* in the order of utf8proc_script_t: the names of Scripts.txt and the ISO
+ * 15924 codes of ScriptExtensions.txt */
+static const char *scripts[][2] = {
+    {"Unknown", "Zzzz"}, {"Common", "Zyyy"}, {"Inherited", "Zinh"},
+    {"Adlam", "Adlm"}, {"Ahom", "Ahom"}, {"Anatolian_Hieroglyphs", "Hluw"},
+    {"Arabic", "Arab"}, {"Armenian", "Armn"}, {"Avestan", "Avst"},
+    {"Balinese", "Bali"}, {"Bamum", "Bamu"}, {"Bassa_Vah", "Bass"},
+    {"Batak", "Batk"}, {"Bengali", "Beng"}, {"Bhaiksuki", "Bhks"},
+    {"Bopomofo", "Bopo"}, {"Brahmi", "Brah"}, {"Braille", "Brai"},
+    {"Buginese", "Bugi"}, {"Buhid", "Buhd"}, {"Canadian_Aboriginal", "Cans"},
+    {"Carian", "Cari"}, {"Caucasian_Albanian", "Aghb"}, {"Chakma", "Cakm"},
+    {"Cham", "Cham"}, {"Cherokee", "Cher"}, {"Coptic", "Copt"},
+    {"Cuneiform", "Xsux"}, {"Cypriot", "Cprt"}, {"Cyrillic", "Cyrl"},
+    {"Deseret", "Dsrt"}, {"Devanagari", "Deva"}, {"Duployan", "Dupl"},
+    {"Egyptian_Hieroglyphs", "Egyp"}, {"Elbasan", "Elba"}, {"Ethiopic", "Ethi"},
+    {"Georgian", "Geor"}, {"Glagolitic", "Glag"}, {"Gothic", "Goth"},
+    {"Grantha", "Gran"}, {"Greek", "Grek"}, {"Gujarati", "Gujr"},
+    {"Gurmukhi", "Guru"}, {"Han", "Hani"}, {"Hangul", "Hang"},
+    {"Hanunoo", "Hano"}, {"Hatran", "Hatr"}, {"Hebrew", "Hebr"},
+    {"Hiragana", "Hira"}, {"Imperial_Aramaic", "Armi"},
+    {"Inscriptional_Pahlavi", "Phli"}, {"Inscriptional_Parthian", "Prti"},
+    {"Javanese", "Java"}, {"Kaithi", "Kthi"}, {"Kannada", "Knda"},
+    {"Katakana", "Kana"}, {"Kayah_Li", "Kali"}, {"Kharoshthi", "Khar"},
+    {"Khmer", "Khmr"}, {"Khojki", "Khoj"}, {"Khudawadi", "Sind"},
+    {"Lao", "Laoo"}, {"Latin", "Latn"}, {"Lepcha", "Lepc"}, {"Limbu", "Limb"},
+    {"Linear_A", "Lina"}, {"Linear_B", "Linb"}, {"Lisu", "Lisu"},
+    {"Lycian", "Lyci"}, {"Lydian", "Lydi"}, {"Mahajani", "Mahj"},
+    {"Malayalam", "Mlym"}, {"Mandaic", "Mand"}, {"Manichaean", "Mani"},
+    {"Marchen", "Marc"}, {"Meetei_Mayek", "Mtei"}, {"Mende_Kikakui", "Mend"},
+    {"Meroitic_Cursive", "Merc"}, {"Meroitic_Hieroglyphs", "Mero"},
+    {"Miao", "Plrd"}, {"Modi", "Modi"}, {"Mongolian", "Mong"}, {"Mro", "Mroo"},
+    {"Multani", "Mult"}, {"Myanmar", "Mymr"}, {"Nabataean", "Nbat"},
+    {"New_Tai_Lue", "Talu"}, {"Newa", "Newa"}, {"Nko", "Nkoo"},
+    {"Ogham", "Ogam"}, {"Ol_Chiki", "Olck"}, {"Old_Hungarian", "Hung"},
+    {"Old_Italic", "Ital"}, {"Old_North_Arabian", "Narb"},
+    {"Old_Permic", "Perm"}, {"Old_Persian", "Xpeo"},
+    {"Old_South_Arabian", "Sarb"}, {"Old_Turkic", "Orkh"}, {"Oriya", "Orya"},
+    {"Osage", "Osge"}, {"Osmanya", "Osma"}, {"Pahawh_Hmong", "Hmng"},
+    {"Palmyrene", "Palm"}, {"Pau_Cin_Hau", "Pauc"}, {"Phags_Pa", "Phag"},
+    {"Phoenician", "Phnx"}, {"Psalter_Pahlavi", "Phlp"}, {"Rejang", "Rjng"},
+    {"Runic", "Runr"}, {"Samaritan", "Samr"}, {"Saurashtra", "Saur"},
+    {"Sharada", "Shrd"}, {"Shavian", "Shaw"}, {"Siddham", "Sidd"},
+    {"SignWriting", "Sgnw"}, {"Sinhala", "Sinh"}, {"Sora_Sompeng", "Sora"},
+    {"Sundanese", "Sund"}, {"Syloti_Nagri", "Sylo"}, {"Syriac", "Syrc"},
+    {"Tagalog", "Tglg"}, {"Tagbanwa", "Tagb"}, {"Tai_Le", "Tale"},
+    {"Tai_Tham", "Lana"}, {"Tai_Viet", "Tavt"}, {"Takri", "Takr"},
+    {"Tamil", "Taml"}, {"Tangut", "Tang"}, {"Telugu", "Telu"},
+    {"Thaana", "Thaa"}, {"Thai", "Thai"}, {"Tibetan", "Tibt"},
+    {"Tifinagh", "Tfng"}, {"Tirhuta", "Tirh"}, {"Ugaritic", "Ugar"},
+    {"Vai", "Vaii"}, {"Warang_Citi", "Wara"}, {"Yi", "Yiii"},
+};
+#define SCRIPT_COUNT (sizeof(scripts) / sizeof(scripts[0]))
+#define SCRIPT_BITS 8
+/* values of the script table from SCRIPT_COUNT on select an extension */
+#define SCRIPT_VALUE_MAX 0xFF
+/* in the order of utf8proc_linebreak_t, the values of LineBreak.txt */
+static const char *linebreak_classes[] = {
+    "XX", "BK", "CR", "LF", "CM", "NL", "SG", "WJ", "ZW", "GL", "SP", "ZWJ",
+    "B2", "BA", "BB", "HY", "CB", "CL", "CP", "EX", "IN", "NS", "OP", "QU",
+    "IS", "NU", "PO", "PR", "SY", "AI", "AL", "CJ", "EB", "EM", "H2", "H3",
+    "HL", "ID", "JL", "JV", "JT", "RI", "SA", NULL
+};
+#define LINEBREAK_ID 37
+#define LINEBREAK_PR 27
+#define LINEBREAK_BITS 8
+
+/* A line of UnicodeData.txt. A range of code points shares one record */
+struct ucd_record {
+    int category;
+    int combining_class;
+    int bidi_class;
+    int decomp_type;
+    int decomp_len;
+    int32_t decomp[MAX_DECOMP];
+    int bidi_mirrored;
+    int32_t upper, lower, title;
+};
+
+/* An entry of utf8proc_properties */
+struct property {
+    int category;
+    int combining_class;
+    int bidi_class;
+    int decomp_type;
+    unsigned int decomp_seqindex;
+    unsigned int casefold_seqindex;
+    unsigned int uppercase_seqindex;
+    unsigned int lowercase_seqindex;
+    unsigned int titlecase_seqindex;
+    unsigned int comb_index;
+    int bidi_mirrored;
+    int comp_exclusion;
+    int ignorable;
+    int control_boundary;
+    int charwidth;
+    int boundclass;
+    int emoji;
+    int nfc_check;
+    int ambiguous;
+};
+
+static struct ucd_record *records;
+static size_t nrecords, records_cap;
+static int32_t *record_of;
+
+static int32_t *fold_pool;
+static size_t fold_pool_len, fold_pool_cap;
+static int32_t *fold_start;
+static unsigned char *fold_len;
+
+static unsigned char *exclusion;
+static unsigned char *ignorable;
+static unsigned char *boundclass;
+static unsigned char *charwidth;
+static unsigned char *emoji;
+static unsigned char *ambiguous;
+/* primary composites and second characters of their decompositions, which
+ * NFC_Quick_Check counts without the post composition version exclusions */
+static unsigned char *composite;
+static unsigned char *composite_second;
+static int widths_from_file;
+static int ambiguous_from_file;
+
+struct script_extension {
+    int script;
+    size_t count;
+    int scripts[SCRIPT_COUNT];
+};
+static uint32_t *script_value;
+static uint32_t *linebreak_value;
+static struct script_extension script_exts[SCRIPT_VALUE_MAX + 1 - SCRIPT_COUNT];
+static size_t nscript_exts;
+
+static uint16_t *seqs;
+static size_t nseqs, seqs_cap;
+/* every unique sequence to reuse them */
+struct seq_array {
+    size_t start;
+    size_t len;
+};
+#define SEQ_HASH_SIZE (1 << 16)
+static struct seq_array *seq_arrays;
+static size_t nseq_arrays, seq_arrays_cap;
+static int32_t seq_hash[SEQ_HASH_SIZE];
+
+static char version[32] = "unknown";
+
+static void fail(const char *msg, const char *arg) {
+    fprintf(stderr, "utf8datagen: %s%s\n", msg, arg ? arg : "");
+    exit(1);
+}
+
+static void *grow(void *ptr, size_t *cap, size_t need, size_t item) {
+    if (need <= *cap) {
+        return ptr;
+    }
+    size_t sz = *cap ? *cap : 64;
+    while (sz < need) {
+        sz *= 2;
+    }
+    ptr = realloc(ptr, sz * item);
+    if (ptr == NULL) {
+        fail("out of memory", NULL);
+    }
+    *cap = sz;
+    return ptr;
+}
+
+static void *alloc_zero(size_t count, size_t item) {
+    void *ptr = calloc(count, item);
+    if (ptr == NULL) {
+        fail("out of memory", NULL);
+    }
+    return ptr;
+}
+
+static FILE *open_ucd(const char *dir, const char *name, int required) {
+    static const char *subdirs[] = {"", "auxiliary/", "emoji/"};
+    char path[LINE_SIZE];
+    FILE *f = NULL;
+    for (size_t i = 0; f == NULL && i < sizeof(subdirs) / sizeof(subdirs[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s%s", dir, subdirs[i], name);
+        f = fopen(path, "r");
+    }
+    if (f == NULL && required) {
+        fail("cannot open ", name);
+    }
+    return f;
+}
+
+static int find_name(const char **names, const char *name, const char *what) {
+    for (int i = 0; names[i] != NULL; i++) {
+        if (strcmp(names[i], name) == 0) {
+            return i;
+        }
+    }
+    fprintf(stderr, "utf8datagen: unknown %s '%s'\n", what, name);
+    exit(1);
+}
+
+/* Splits a line at ';' in place and returns the number of fields. Comments
+ * are removed and the fields are trimmed */
+static int split_fields(char *line, char **fields, int max) {
+    char *hash = strchr(line, '#');
+    if (hash != NULL) {
+        *hash = '\0';
+    }
+
+    int n = 0;
+    char *p = line;
+    while (n < max) {
+        char *end = strchr(p, ';');
+        if (end != NULL) {
+            *end = '\0';
+        }
+        while (isspace((unsigned char)*p)) {
+            p++;
+        }
+        char *last = p + strlen(p);
+        while (last > p && isspace((unsigned char)last[-1])) {
+            *--last = '\0';
+        }
+        fields[n++] = p;
+        if (end == NULL) {
+            break;
+        }
+        p = end + 1;
+    }
+    return n;
+}
+
+/* Parses "XXXX" or "XXXX..YYYY", returns 0 if the field is not a range */
+static int parse_range(const char *field, int32_t *first, int32_t *last) {
+    char *end;
+    if (!isxdigit((unsigned char)*field)) {
+        return 0;
+    }
+    *first = (int32_t)strtol(field, &end, 16);
+    *last = *first;
+    if (end[0] == '.' && end[1] == '.') {
+        *last = (int32_t)strtol(end + 2, &end, 16);
+    }
+    if (*first < 0 || *last >= MAX_CP || *first > *last) {
+        fail("invalid code point range: ", field);
+    }
+    return 1;
+}
+
+/* Reads "# Name-9.0.0.txt" from the first line of a UCD file */
+static void read_version(const char *line) {
+    const char *dash = strrchr(line, '-');
+    if (line[0] != '#' || dash == NULL) {
+        return;
+    }
+    size_t len = strcspn(dash + 1, "t");
+    if (len > 1 && len < sizeof(version)) {
+        memcpy(version, dash + 1, len - 1);
+        version[len - 1] = '\0';
+    }
+}
+
+static void read_unicode_data(const char *dir) {
+    FILE *f = open_ucd(dir, "UnicodeData.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[16];
+    int32_t range_first = -1;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (split_fields(line, fields, 16) != 15) {
+            continue;
+        }
+
+        int32_t cp = (int32_t)strtol(fields[0], NULL, 16);
+        if (cp < 0 || cp >= MAX_CP) {
+            fail("invalid code point: ", fields[0]);
+        }
+        size_t name_len = strlen(fields[1]);
+        if (name_len > 8 && strcmp(fields[1] + name_len - 8, ", First>") == 0) {
+            range_first = cp;
+            continue;
+        }
+
+        records = (struct ucd_record *)grow(records, &records_cap, nrecords + 1, sizeof(*records));
+        struct ucd_record *rec = &records[nrecords];
+        memset(rec, 0, sizeof(*rec));
+        rec->category = find_name(categories, fields[2], "category");
+        rec->combining_class = atoi(fields[3]);
+        rec->bidi_class = find_name(bidi_classes, fields[4], "bidi class");
+
+        char *p = fields[5];
+        if (*p == '<') {
+            char *end = strchr(p, '>');
+            if (end == NULL) {
+                fail("invalid decomposition: ", fields[5]);
+            }
+            *end = '\0';
+            rec->decomp_type = find_name(decomp_types, p + 1, "decomposition type");
+            p = end + 1;
+        }
+        while (*p != '\0') {
+            char *end;
+            int32_t dcp = (int32_t)strtol(p, &end, 16);
+            if (end == p) {
+                break;
+            }
+            if (rec->decomp_len == MAX_DECOMP) {
+                fail("decomposition is too long: ", fields[0]);
+            }
+            rec->decomp[rec->decomp_len++] = dcp;
+            p = end;
+        }
+
+        rec->bidi_mirrored = fields[9][0] == 'Y';
+        rec->upper = *fields[12] ? (int32_t)strtol(fields[12], NULL, 16) : -1;
+        rec->lower = *fields[13] ? (int32_t)strtol(fields[13], NULL, 16) : -1;
+        rec->title = *fields[14] ? (int32_t)strtol(fields[14], NULL, 16) : -1;
+
+        int32_t first = (range_first >= 0) ? range_first : cp;
+        for (int32_t c = first; c <= cp; c++) {
+            record_of[c] = (int32_t)nrecords;
+        }
+        range_first = -1;
+        nrecords++;
+    }
+    fclose(f);
+}
+
+static void read_case_folding(const char *dir) {
+    FILE *f = open_ucd(dir, "CaseFolding.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[4];
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t cp, last;
+        /* full case folding: common and full mappings */
+        if (split_fields(line, fields, 4) < 3 || !parse_range(fields[0], &cp, &last)
+                || (strcmp(fields[1], "C") != 0 && strcmp(fields[1], "F") != 0)) {
+            continue;
+        }
+
+        fold_start[cp] = (int32_t)fold_pool_len;
+        char *p = fields[2];
+        while (*p != '\0') {
+            char *end;
+            int32_t fcp = (int32_t)strtol(p, &end, 16);
+            if (end == p) {
+                break;
+            }
+            fold_pool = (int32_t *)grow(fold_pool, &fold_pool_cap, fold_pool_len + 1, sizeof(*fold_pool));
+            fold_pool[fold_pool_len++] = fcp;
+            fold_len[cp]++;
+            p = end;
+        }
+    }
+    fclose(f);
+}
+
+/* Section 1(script specifics) is excluded from composition pairs, both
+ * sections 1 and 2(post composition version characters) are marked with
+ * comp_exclusion. The other sections are derived and commented out */
+static void read_exclusions(const char *dir) {
+    FILE *f = open_ucd(dir, "CompositionExclusions.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+    int section = 0;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (strncmp(line, "# (", 3) == 0) {
+            section = atoi(line + 3);
+            continue;
+        }
+        int32_t first, last;
+        if (section < 1 || section > 2 || split_fields(line, fields, 2) < 1
+                || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        for (int32_t c = first; c <= last; c++) {
+            exclusion[c] = (unsigned char)section;
+        }
+    }
+    fclose(f);
+}
+
+static void read_ignorable(const char *dir) {
+    FILE *f = open_ucd(dir, "DerivedCoreProperties.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+    int first_line = 1;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (first_line) {
+            read_version(line);
+            first_line = 0;
+        }
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || strcmp(fields[1], "Default_Ignorable_Code_Point") != 0
+                || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        for (int32_t c = first; c <= last; c++) {
+            ignorable[c] = 1;
+        }
+    }
+    fclose(f);
+}
+
+static void read_boundclasses(const char *dir) {
+    FILE *f = open_ucd(dir, "GraphemeBreakProperty.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    memset(boundclass, BOUNDCLASS_OTHER, MAX_CP);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        for (char *p = fields[1]; *p; p++) {
+            *p = (char)toupper((unsigned char)*p);
+        }
+        int bc = find_name(boundclasses, fields[1], "grapheme break property");
+        for (int32_t c = first; c <= last; c++) {
+            boundclass[c] = (unsigned char)bc;
+        }
+    }
+    fclose(f);
+}
+
+static int find_script(const char *name, int column) {
+    for (size_t i = 0; i < SCRIPT_COUNT; i++) {
+        if (strcmp(scripts[i][column], name) == 0) {
+            return (int)i;
+        }
+    }
+    fprintf(stderr, "utf8datagen: unknown script '%s'\n", name);
+    exit(1);
+}
+
+static void read_scripts(const char *dir) {
+    FILE *f = open_ucd(dir, "Scripts.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        int script = find_script(fields[1], 0);
+        for (int32_t c = first; c <= last; c++) {
+            script_value[c] = (uint32_t)script;
+        }
+    }
+    fclose(f);
+}
+
+/* Code points LineBreak.txt does not list are XX, except for the
+ * unassigned ones of the blocks its header gives other defaults */
+static void read_linebreaks(const char *dir) {
+    static const int32_t id_ranges[][2] = {
+        {0x3400, 0x4DBF}, {0x4E00, 0x9FFF}, {0xF900, 0xFAFF},
+        {0x20000, 0x2FFFD}, {0x30000, 0x3FFFD},
+    };
+    FILE *f = open_ucd(dir, "LineBreak.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    for (size_t i = 0; i < sizeof(id_ranges) / sizeof(id_ranges[0]); i++) {
+        for (int32_t c = id_ranges[i][0]; c <= id_ranges[i][1]; c++) {
+            linebreak_value[c] = LINEBREAK_ID;
+        }
+    }
+    for (int32_t c = 0x20A0; c <= 0x20CF; c++) {
+        linebreak_value[c] = LINEBREAK_PR;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        int lb = find_name(linebreak_classes, fields[1], "line break class");
+        for (int32_t c = first; c <= last; c++) {
+            linebreak_value[c] = (uint32_t)lb;
+        }
+    }
+    fclose(f);
+}
+
+/* Code points with extensions get the value of their script and extension
+ * set, equal sets of the same script share it */
+static void read_script_extensions(const char *dir) {
+    FILE *f = open_ucd(dir, "ScriptExtensions.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        int used[SCRIPT_COUNT] = {0};
+        for (char *code = strtok(fields[1], " "); code != NULL; code = strtok(NULL, " ")) {
+            used[find_script(code, 1)] = 1;
+        }
+        struct script_extension ext;
+        memset(&ext, 0, sizeof(ext));
+        for (size_t i = 0; i < SCRIPT_COUNT; i++) {
+            if (used[i]) {
+                ext.scripts[ext.count++] = (int)i;
+            }
+        }
+        for (int32_t c = first; c <= last; c++) {
+            if (script_value[c] >= SCRIPT_COUNT) {
+                fail("duplicate script extensions: ", fields[0]);
+            }
+            ext.script = (int)script_value[c];
+            size_t i = 0;
+            while (i < nscript_exts && memcmp(&script_exts[i], &ext, sizeof(ext)) != 0) {
+                i++;
+            }
+            if (i == nscript_exts) {
+                if (SCRIPT_COUNT + nscript_exts > SCRIPT_VALUE_MAX) {
+                    fail("too many script extension sets", NULL);
+                }
+                script_exts[nscript_exts++] = ext;
+            }
+            script_value[c] = (uint32_t)(SCRIPT_COUNT + i);
+        }
+    }
+    fclose(f);
+}
+
+static void read_emoji(const char *dir) {
+    FILE *f = open_ucd(dir, "emoji-data.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        for (size_t i = 0; i < sizeof(emoji_properties) / sizeof(emoji_properties[0]); i++) {
+            if (strcmp(emoji_properties[i].name, fields[1]) == 0) {
+                for (int32_t c = first; c <= last; c++) {
+                    emoji[c] |= (unsigned char)emoji_properties[i].flag;
+                }
+            }
+        }
+    }
+    fclose(f);
+}
+
+/* Without CharWidths.txt: wide and fullwidth characters take two columns,
+ * marks, format, control, surrogate and private use characters take
+ * none(as in the fonts charwidths.jl reads), the rest take one */
+static void derive_widths(const char *dir) {
+    static const char *zero_width[] = {"Mn", "Mc", "Me", "Cc", "Cf", "Zl", "Zp", "Cs", "Co", NULL};
+    FILE *f = open_ucd(dir, "EastAsianWidth.txt", 1);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    for (int32_t c = 0; c < MAX_CP; c++) {
+        if (record_of[c] < 0) {
+            continue;
+        }
+        const char *ctg = categories[records[record_of[c]].category];
+        int zero = 0;
+        for (int i = 0; zero_width[i] != NULL; i++) {
+            zero = zero || strcmp(ctg, zero_width[i]) == 0;
+        }
+        charwidth[c] = (unsigned char)(zero ? 0 : 1);
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)
+                || (strcmp(fields[1], "W") != 0 && strcmp(fields[1], "F") != 0)) {
+            continue;
+        }
+        for (int32_t c = first; c <= last; c++) {
+            if (record_of[c] >= 0 && charwidth[c] != 0) {
+                charwidth[c] = 2;
+            }
+        }
+    }
+    fclose(f);
+}
+
+/* East_Asian_Width=Ambiguous: one column in most locales, two in CJK ones */
+static void read_ambiguous(const char *dir, int required) {
+    FILE *f = open_ucd(dir, "EastAsianWidth.txt", required);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    if (f == NULL) {
+        return;
+    }
+    ambiguous_from_file = 1;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)
+                || strcmp(fields[1], "A") != 0) {
+            continue;
+        }
+        for (int32_t c = first; c <= last; c++) {
+            ambiguous[c] = 1;
+        }
+    }
+    fclose(f);
+}
+
+static void read_widths(const char *dir) {
+    FILE *f = open_ucd(dir, "CharWidths.txt", 0);
+    char line[LINE_SIZE];
+    char *fields[2];
+
+    if (f == NULL) {
+        derive_widths(dir);
+        read_ambiguous(dir, 1);
+        return;
+    }
+
+    widths_from_file = 1;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int32_t first, last;
+        if (split_fields(line, fields, 2) < 2 || !parse_range(fields[0], &first, &last)) {
+            continue;
+        }
+        for (int32_t c = first; c <= last; c++) {
+            charwidth[c] = (unsigned char)atoi(fields[1]);
+        }
+    }
+    fclose(f);
+    read_ambiguous(dir, 0);
+}
+
+/* Appends a UTF-16 encoded array to utf8proc_sequences unless the same array
+ * is already there. Returns its index */
+static size_t push_sequence(const uint16_t *data, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+
+    size_t slot = h & (SEQ_HASH_SIZE - 1);
+    while (seq_hash[slot] >= 0) {
+        const struct seq_array *a = &seq_arrays[seq_hash[slot]];
+        if (a->len == len && memcmp(seqs + a->start, data, len * sizeof(*data)) == 0) {
+            return a->start;
+        }
+        slot = (slot + 1) & (SEQ_HASH_SIZE - 1);
+    }
+    if (nseq_arrays >= SEQ_HASH_SIZE / 2) {
+        fail("too many unique sequences", NULL);
+    }
+
+    seq_hash[slot] = (int32_t)nseq_arrays;
+    seq_arrays = (struct seq_array *)grow(seq_arrays, &seq_arrays_cap, nseq_arrays + 1, sizeof(*seq_arrays));
+    seq_arrays[nseq_arrays].start = nseqs;
+    seq_arrays[nseq_arrays].len = len;
+    nseq_arrays++;
+
+    seqs = (uint16_t *)grow(seqs, &seqs_cap, nseqs + len, sizeof(*seqs));
+    memcpy(seqs + nseqs, data, len * sizeof(*data));
+    nseqs += len;
+    return nseqs - len;
+}
+
+/* Returns the seqindex of a code point array: the index in the low 13 bits,
+ * the number of code points minus one in the high 3 bits. Longer arrays
+ * keep the length in the first element */
+static unsigned int sequence_index(const int32_t *cps, size_t count) {
+    uint16_t data[MAX_DECOMP * 2 + 1];
+    size_t len = 0;
+
+    if (count == 0) {
+        return NO_VALUE;
+    }
+    unsigned int lencode = (unsigned int)count - 1;
+    if (lencode >= SEQ_LONG) {
+        data[len++] = (uint16_t)lencode;
+        lencode = SEQ_LONG;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (cps[i] >= 0x10000) {
+            data[len++] = (uint16_t)(0xD800 | ((cps[i] - 0x10000) >> 10));
+            data[len++] = (uint16_t)(0xDC00 | ((cps[i] - 0x10000) & 0x3FF));
+        } else {
+            data[len++] = (uint16_t)cps[i];
+        }
+    }
+
+    size_t idx = push_sequence(data, len);
+    if (idx > SEQ_INDEX_MAX) {
+        fail("too many sequences for 13-bit index", NULL);
+    }
+    return (unsigned int)idx | (lencode << 13);
+}
+
+/* Simple case mappings are single code points, their index takes all 16 bits */
+static unsigned int single_index(int32_t cp) {
+    uint16_t data[2];
+    size_t len = 0;
+
+    if (cp < 0) {
+        return NO_VALUE;
+    }
+    if (cp >= 0x10000) {
+        data[len++] = (uint16_t)(0xD800 | ((cp - 0x10000) >> 10));
+        data[len++] = (uint16_t)(0xDC00 | ((cp - 0x10000) & 0x3FF));
+    } else {
+        data[len++] = (uint16_t)cp;
+    }
+
+    size_t idx = push_sequence(data, len);
+    if (idx >= NO_VALUE) {
+        fail("too many sequences for 16-bit index", NULL);
+    }
+    return (unsigned int)idx;
+}
+
+/* Composition pairs: the first characters are the rows, the second ones the
+ * columns, both in the order of their first appearance. Second characters
+ * that compose to a character above U+FFFF take two elements of
+ * utf8proc_combinations */
+#define COMB_MAX 1024
+static int32_t comb_first[COMB_MAX], comb_second[COMB_MAX];
+static int second_nonbasic[COMB_MAX];
+static int comb_first_offset[COMB_MAX], comb_last_offset[COMB_MAX];
+static size_t ncomb_first, ncomb_second;
+static int32_t *comb_pairs;
+static unsigned int *comb_index;
+
+static size_t comb_find(int32_t *list, size_t *count, int32_t cp) {
+    for (size_t i = 0; i < *count; i++) {
+        if (list[i] == cp) {
+            return i;
+        }
+    }
+    if (*count == COMB_MAX) {
+        fail("too many characters in compositions", NULL);
+    }
+    list[*count] = cp;
+    return (*count)++;
+}
+
+static void build_compositions(void) {
+    comb_pairs = (int32_t *)alloc_zero(COMB_MAX * COMB_MAX, sizeof(*comb_pairs));
+    for (int32_t cp = 0; cp < MAX_CP; cp++) {
+        if (record_of[cp] < 0) {
+            continue;
+        }
+        const struct ucd_record *rec = &records[record_of[cp]];
+        if (rec->decomp_type != 0 || rec->decomp_len != 2 || record_of[rec->decomp[0]] < 0
+                || records[record_of[rec->decomp[0]]].combining_class != 0 || exclusion[cp] == 1) {
+            continue;
+        }
+
+        size_t a = comb_find(comb_first, &ncomb_first, rec->decomp[0]);
+        size_t b = comb_find(comb_second, &ncomb_second, rec->decomp[1]);
+        if (comb_pairs[a * COMB_MAX + b] != 0) {
+            fail("duplicate canonical mapping", NULL);
+        }
+        comb_pairs[a * COMB_MAX + b] = cp;
+        if (exclusion[cp] == 0) {
+            composite[cp] = 1;
+            composite_second[rec->decomp[1]] = 1;
+        }
+        if (cp > 0xFFFF) {
+            second_nonbasic[b] = 1;
+        }
+    }
+}
+
+/* utf8proc_combinations: for every first character the offsets of its first
+ * and last column followed by the compositions of these columns. The
+ * comb_index of a first character is the offset of its row, of a second
+ * character - 0x8000 | its column(| 0x4000 if it takes two elements) */
+static void build_comb_index(void) {
+    unsigned int cumoffset = 0;
+    for (size_t a = 0; a < ncomb_first; a++) {
+        int first = -1, last = -1, offset = 0;
+        for (size_t b = 0; b < ncomb_second; b++) {
+            if (comb_pairs[a * COMB_MAX + b] != 0) {
+                if (first < 0) {
+                    first = offset;
+                }
+                last = offset + second_nonbasic[b];
+            }
+            offset += 1 + second_nonbasic[b];
+        }
+        comb_first_offset[a] = first;
+        comb_last_offset[a] = last;
+        comb_index[comb_first[a]] = cumoffset;
+        cumoffset += (unsigned int)(last - first + 1 + 2);
+    }
+
+    unsigned int extra = 0;
+    for (size_t b = 0; b < ncomb_second; b++) {
+        if (comb_index[comb_second[b]] != NO_VALUE) {
+            fail("character is both first and second character of compositions", NULL);
+        }
+        comb_index[comb_second[b]] = 0x8000 | (unsigned int)(b + extra);
+        if (second_nonbasic[b]) {
+            comb_index[comb_second[b]] |= 0x4000;
+            extra++;
+        }
+    }
+}
+
+/* Unique properties with a hash table to find them */
+#define PROP_HASH_SIZE (1 << 16)
+static struct property *props;
+static size_t nprops, props_cap;
+static int32_t prop_hash[PROP_HASH_SIZE];
+
+static size_t add_property(const struct property *prop) {
+    const unsigned char *bytes = (const unsigned char *)prop;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(*prop); i++) {
+        h = (h ^ bytes[i]) * 16777619u;
+    }
+
+    size_t slot = h & (PROP_HASH_SIZE - 1);
+    while (prop_hash[slot] >= 0) {
+        if (memcmp(&props[prop_hash[slot]], prop, sizeof(*prop)) == 0) {
+            return (size_t)prop_hash[slot];
+        }
+        slot = (slot + 1) & (PROP_HASH_SIZE - 1);
+    }
+    if (nprops >= PROP_HASH_SIZE / 2) {
+        fail("too many unique properties", NULL);
+    }
+
+    props = (struct property *)grow(props, &props_cap, nprops + 1, sizeof(*props));
+    props[nprops] = *prop;
+    prop_hash[slot] = (int32_t)nprops;
+    return nprops++;
+}
+
+/* Maps blocks of 1 << bits values to unique blocks. Fills idx with the offset
+ * of the unique block of every block and returns the unique blocks */
+static uint32_t *dedup_blocks(const uint32_t *values, size_t count, int bits, uint32_t *idx, size_t *nunique) {
+    size_t block = (size_t)1 << bits;
+    uint32_t *unique = (uint32_t *)alloc_zero(count, sizeof(*unique));
+    size_t n = 0;
+
+    for (size_t i = 0; i < count / block; i++) {
+        size_t j = 0;
+        for (; j < n; j++) {
+            if (memcmp(unique + j * block, values + i * block, block * sizeof(*values)) == 0) {
+                break;
+            }
+        }
+        if (j == n) {
+            memcpy(unique + n * block, values + i * block, block * sizeof(*values));
+            n++;
+        }
+        idx[i] = (uint32_t)(j * block);
+    }
+    *nunique = n * block;
+    return unique;
+}
+
+static const char *table_type(const uint32_t *values, size_t count, size_t *item) {
+    for (size_t i = 0; i < count; i++) {
+        if (values[i] > 0xFFFF) {
+            *item = 4;
+            return "utf8proc_uint32_t";
+        }
+    }
+    *item = 2;
+    return "utf8proc_uint16_t";
+}
+
+/* Prints an array in the format of utf8proc 2.0.2 data */
+static size_t print_typed_table(const char *name, const char *type, size_t item,
+                                const uint32_t *values, size_t count) {
+    printf("const %s %s[] = {\n  ", type, name);
+    for (size_t i = 0; i < count; i++) {
+        if ((i + 1) % 8 == 0) {
+            printf("\n  ");
+        }
+        printf("%u, ", (unsigned int)values[i]);
+    }
+    printf("};\n");
+    return count * item;
+}
+
+static size_t print_table(const char *name, const uint32_t *values, size_t count) {
+    size_t item;
+    const char *type = table_type(values, count, &item);
+    return print_typed_table(name, type, item, values, count);
+}
+
+static void print_seqindex(unsigned int value) {
+    if (value == NO_VALUE) {
+        printf("UINT16_MAX, ");
+    } else {
+        printf("%u, ", value);
+    }
+}
+
+static void print_name(const char *prefix, const char **names, int value) {
+    if (value == 0) {
+        printf("0, ");
+        return;
+    }
+    printf("UTF8PROC_%s_", prefix);
+    for (const char *p = names[value]; *p; p++) {
+        putchar(toupper((unsigned char)*p));
+    }
+    printf(", ");
+}
+
+static void print_properties(void) {
+    printf("const utf8proc_property_t utf8proc_properties[] = {\n");
+    printf("  {0, 0, 0, 0, UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX,  false,false,false,false, 0, 0, UTF8PROC_BOUNDCLASS_OTHER},\n");
+    for (size_t i = 0; i < nprops; i++) {
+        const struct property *p = &props[i];
+        printf("  {");
+        print_name("CATEGORY", categories, p->category);
+        printf("%d, ", p->combining_class);
+        print_name("BIDI_CLASS", bidi_classes, p->bidi_class);
+        print_name("DECOMP_TYPE", decomp_types, p->decomp_type);
+        print_seqindex(p->decomp_seqindex);
+        print_seqindex(p->casefold_seqindex);
+        print_seqindex(p->uppercase_seqindex);
+        print_seqindex(p->lowercase_seqindex);
+        print_seqindex(p->titlecase_seqindex);
+        print_seqindex(p->comb_index);
+        printf("%s, %s, %s, %s, %d, 0, UTF8PROC_BOUNDCLASS_%s},\n",
+                p->bidi_mirrored ? "true" : "false", p->comp_exclusion ? "true" : "false",
+                p->ignorable ? "true" : "false", p->control_boundary ? "true" : "false",
+                p->charwidth, boundclasses[p->boundclass]);
+    }
+    printf("};\n");
+}
+
+/* utf8proc_hot_properties of utf8proc.c: the same entries reduced to the
+ * frequently read fields */
+static void print_hot_properties(void) {
+    printf("const utf8proc_hot_property_t utf8proc_hot_properties[] = {\n");
+    printf("  {UTF8PROC_CATEGORY_CN, 0, false, 0, UTF8PROC_BOUNDCLASS_OTHER, 0, false, false},\n");
+    for (size_t i = 0; i < nprops; i++) {
+        const struct property *p = &props[i];
+        int casemap = p->uppercase_seqindex != NO_VALUE || p->lowercase_seqindex != NO_VALUE
+            || p->titlecase_seqindex != NO_VALUE || p->casefold_seqindex != NO_VALUE;
+        printf("  {UTF8PROC_CATEGORY_%c%c, %d, %s, %d, UTF8PROC_BOUNDCLASS_%s, %d, %s, %s},\n",
+                toupper((unsigned char)categories[p->category][0]),
+                toupper((unsigned char)categories[p->category][1]),
+                p->charwidth, casemap ? "true" : "false", p->combining_class,
+                boundclasses[p->boundclass], p->emoji, p->nfc_check ? "true" : "false",
+                p->ambiguous ? "true" : "false");
+    }
+    printf("};\n\n");
+}
+
+static size_t print_combinations(void) {
+    size_t count = 0;
+    int counter = 0;
+    printf("const utf8proc_uint16_t utf8proc_combinations[] = {\n  ");
+    for (size_t a = 0; a < ncomb_first; a++) {
+        int offset = 0;
+        printf("%d, %d, ", comb_first_offset[a], comb_last_offset[a]);
+        count += 2;
+        for (size_t b = 0; b < ncomb_second && offset <= comb_last_offset[a]; b++) {
+            if (offset >= comb_first_offset[a]) {
+                uint32_t v = (uint32_t)comb_pairs[a * COMB_MAX + b];
+                if (++counter == 8) {
+                    counter = 0;
+                    printf("\n  ");
+                }
+                if (second_nonbasic[b]) {
+                    printf("%u, ", (unsigned int)(v >> 16));
+                    count++;
+                }
+                printf("%u, ", (unsigned int)(v & 0xFFFF));
+                count++;
+            }
+            offset += 1 + second_nonbasic[b];
+        }
+        printf("\n");
+    }
+    printf("};\n");
+    return count;
+}
+
+static void print_script_codes(void) {
+    printf("const char utf8proc_script_codes[][5] = {\n  ");
+    for (size_t i = 0; i < SCRIPT_COUNT; i++) {
+        if (i > 0) {
+            printf(i % 10 == 0 ? "\n  " : " ");
+        }
+        printf("\"%s\",", scripts[i][1]);
+    }
+    printf("\n};\n");
+}
+
+/* utf8proc_script_sets holds the script, the number of scripts and the
+ * scripts of every extension set, utf8proc_script_set_index the offset
+ * of each set */
+static size_t print_scripts(void) {
+    uint32_t *idx = (uint32_t *)alloc_zero(MAX_CP >> SCRIPT_BITS, sizeof(*idx));
+    size_t nunique;
+    uint32_t *unique = dedup_blocks(script_value, MAX_CP, SCRIPT_BITS, idx, &nunique);
+    size_t bytes = print_table("utf8proc_script_stage1", idx, MAX_CP >> SCRIPT_BITS);
+    printf("\n");
+    bytes += print_typed_table("utf8proc_script_stage2", "utf8proc_uint8_t", 1, unique, nunique);
+    printf("\n");
+
+    uint32_t *ext_values = (uint32_t *)alloc_zero(nscript_exts * (SCRIPT_COUNT + 2) + 1, sizeof(*ext_values));
+    uint32_t *ext_index = (uint32_t *)alloc_zero(nscript_exts + 1, sizeof(*ext_index));
+    size_t next = 0;
+    for (size_t i = 0; i < nscript_exts; i++) {
+        ext_index[i] = (uint32_t)next;
+        ext_values[next++] = (uint32_t)script_exts[i].script;
+        ext_values[next++] = (uint32_t)script_exts[i].count;
+        for (size_t j = 0; j < script_exts[i].count; j++) {
+            ext_values[next++] = (uint32_t)script_exts[i].scripts[j];
+        }
+    }
+    /* C does not allow empty arrays */
+    bytes += print_typed_table("utf8proc_script_sets", "utf8proc_uint8_t", 1, ext_values, next ? next : 1);
+    printf("\n");
+    bytes += print_table("utf8proc_script_set_index", ext_index, nscript_exts ? nscript_exts : 1);
+    return bytes;
+}
+
+static size_t print_linebreaks(void) {
+    uint32_t *idx = (uint32_t *)alloc_zero(MAX_CP >> LINEBREAK_BITS, sizeof(*idx));
+    size_t nunique;
+    uint32_t *unique = dedup_blocks(linebreak_value, MAX_CP, LINEBREAK_BITS, idx, &nunique);
+    size_t bytes = print_table("utf8proc_linebreak_stage1", idx, MAX_CP >> LINEBREAK_BITS);
+    printf("\n");
+    bytes += print_typed_table("utf8proc_linebreak_stage2", "utf8proc_uint8_t", 1, unique, nunique);
+    return bytes;
+}
+
+static int parse_int_arg(int argc, char **argv, int *i, int min, int max) {
+    if (*i + 1 >= argc) {
+        fail("missing value of ", argv[*i]);
+    }
+    int v = atoi(argv[++*i]);
+    if (v < min || v > max) {
+        fail("invalid value of ", argv[*i - 1]);
+    }
+    return v;
+}
+
+int main(int argc, char **argv) {
+    int stages = 2, block_bits = 8, mid_bits = 4;
+    const char *dir = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0) {
+            stages = parse_int_arg(argc, argv, &i, 2, 3);
+        } else if (strcmp(argv[i], "-b") == 0) {
+            block_bits = parse_int_arg(argc, argv, &i, 2, 12);
+        } else if (strcmp(argv[i], "-m") == 0) {
+            mid_bits = parse_int_arg(argc, argv, &i, 2, 10);
+        } else if (dir == NULL) {
+            dir = argv[i];
+        } else {
+            fail("unexpected argument ", argv[i]);
+        }
+    }
+    if (dir == NULL) {
+        fprintf(stderr, "Usage: utf8datagen [-s 2|3] [-b bits] [-m bits] UCD_DIR > utf8proc_data.c\n");
+        return 1;
+    }
+    if (stages == 3 && block_bits + mid_bits > 16) {
+        fail("-b and -m bits together must not exceed 16", NULL);
+    }
+
+    record_of = (int32_t *)alloc_zero(MAX_CP, sizeof(*record_of));
+    fold_start = (int32_t *)alloc_zero(MAX_CP, sizeof(*fold_start));
+    fold_len = (unsigned char *)alloc_zero(MAX_CP, 1);
+    exclusion = (unsigned char *)alloc_zero(MAX_CP, 1);
+    ignorable = (unsigned char *)alloc_zero(MAX_CP, 1);
+    boundclass = (unsigned char *)alloc_zero(MAX_CP, 1);
+    charwidth = (unsigned char *)alloc_zero(MAX_CP, 1);
+    emoji = (unsigned char *)alloc_zero(MAX_CP, 1);
+    ambiguous = (unsigned char *)alloc_zero(MAX_CP, 1);
+    composite = (unsigned char *)alloc_zero(MAX_CP, 1);
+    composite_second = (unsigned char *)alloc_zero(MAX_CP, 1);
+    script_value = (uint32_t *)alloc_zero(MAX_CP, sizeof(*script_value));
+    linebreak_value = (uint32_t *)alloc_zero(MAX_CP, sizeof(*linebreak_value));
+    comb_index = (unsigned int *)alloc_zero(MAX_CP, sizeof(*comb_index));
+    for (int32_t c = 0; c < MAX_CP; c++) {
+        record_of[c] = -1;
+        comb_index[c] = NO_VALUE;
+    }
+    memset(prop_hash, 0xFF, sizeof(prop_hash));
+    memset(seq_hash, 0xFF, sizeof(seq_hash));
+
+    read_unicode_data(dir);
+    read_case_folding(dir);
+    read_exclusions(dir);
+    read_ignorable(dir);
+    read_boundclasses(dir);
+    read_widths(dir);
+    read_scripts(dir);
+    read_script_extensions(dir);
+    read_linebreaks(dir);
+    read_emoji(dir);
+
+    /* sequences: decompositions and case foldings first, then simple case
+     * mappings while properties are collected */
+    unsigned int *decomp_seq = (unsigned int *)alloc_zero(nrecords, sizeof(*decomp_seq));
+    unsigned int *fold_seq = (unsigned int *)alloc_zero(MAX_CP, sizeof(*fold_seq));
+    int32_t prev_record = -1;
+    for (int32_t c = 0; c < MAX_CP; c++) {
+        int32_t r = record_of[c];
+        if (r < 0) {
+            continue;
+        }
+        if (r != prev_record) {
+            decomp_seq[r] = sequence_index(records[r].decomp, (size_t)records[r].decomp_len);
+            prev_record = r;
+        }
+        fold_seq[c] = sequence_index(fold_pool + fold_start[c], fold_len[c]);
+    }
+
+    build_compositions();
+    build_comb_index();
+
+    uint32_t *prop_of = (uint32_t *)alloc_zero(MAX_CP, sizeof(*prop_of));
+    for (int32_t c = 0; c < MAX_CP; c++) {
+        int32_t r = record_of[c];
+        struct property prop;
+        memset(&prop, 0, sizeof(prop));
+        prop.boundclass = boundclass[c];
+        if (prop.boundclass == BOUNDCLASS_OTHER && (emoji[c] & EMOJI_EXTENDED_PICTOGRAPHIC)) {
+            prop.boundclass = BOUNDCLASS_EXTENDED_PICTOGRAPHIC;
+        }
+        prop.emoji = emoji[c];
+        if (r < 0) {
+            /* reserved pictographic code points are unassigned with emoji
+             * properties, the rest share the entry 0 */
+            if (prop.emoji != 0) {
+                prop.decomp_seqindex = prop.casefold_seqindex = NO_VALUE;
+                prop.uppercase_seqindex = prop.lowercase_seqindex = NO_VALUE;
+                prop.titlecase_seqindex = prop.comb_index = NO_VALUE;
+                prop_of[c] = (uint32_t)add_property(&prop) + 1;
+            }
+            continue;
+        }
+        const struct ucd_record *rec = &records[r];
+        prop.category = rec->category;
+        prop.combining_class = rec->combining_class;
+        prop.bidi_class = rec->bidi_class;
+        prop.decomp_type = rec->decomp_type;
+        prop.decomp_seqindex = decomp_seq[r];
+        prop.casefold_seqindex = fold_seq[c];
+        prop.uppercase_seqindex = single_index(rec->upper);
+        prop.lowercase_seqindex = single_index(rec->lower);
+        prop.titlecase_seqindex = single_index(rec->title);
+        prop.comb_index = comb_index[c];
+        prop.bidi_mirrored = rec->bidi_mirrored;
+        prop.comp_exclusion = exclusion[c] != 0;
+        prop.ignorable = ignorable[c];
+        prop.control_boundary = strcmp(categories[rec->category], "Zl") == 0
+            || strcmp(categories[rec->category], "Zp") == 0
+            || strcmp(categories[rec->category], "Cc") == 0
+            || strcmp(categories[rec->category], "Cf") == 0;
+        prop.charwidth = charwidth[c];
+        prop.ambiguous = ambiguous[c];
+        /* NFC_Quick_Check is No for canonical decompositions that are not
+         * composed back, Maybe for second characters of compositions,
+         * including Hangul vowels and trailing consonants */
+        prop.nfc_check = (rec->decomp_type == 0 && rec->decomp_len > 0 && !composite[c])
+            || composite_second[c]
+            || (c >= 0x1161 && c <= 0x1175) || (c >= 0x11A8 && c <= 0x11C2);
+        prop_of[c] = (uint32_t)add_property(&prop) + 1;
+    }
+
+    int last_bits = block_bits;
+    int stage2_bits = (stages == 3) ? mid_bits : block_bits;
+    size_t nlast, nmid = 0;
+    uint32_t *last_idx = (uint32_t *)alloc_zero(MAX_CP >> last_bits, sizeof(*last_idx));
+    uint32_t *last = dedup_blocks(prop_of, MAX_CP, last_bits, last_idx, &nlast);
+    uint32_t *mid = NULL, *mid_idx = NULL;
+    if (stages == 3) {
+        mid_idx = (uint32_t *)alloc_zero(MAX_CP >> (last_bits + mid_bits), sizeof(*mid_idx));
+        mid = dedup_blocks(last_idx, MAX_CP >> last_bits, mid_bits, mid_idx, &nmid);
+    }
+
+    printf("/* Generated by tools/utf8datagen.c from Unicode %s data.\n", version);
+    printf(" * Do not edit: run utf8datagen to regenerate. */\n\n");
+    printf("#define UTF8PROC_UNICODE_VERSION \"%s\"\n", version);
+    printf("#define UTF8PROC_TABLE_STAGES %d\n", stages);
+    printf("#define UTF8PROC_STAGE2_BITS %d\n", stage2_bits);
+    if (stages == 3) {
+        printf("#define UTF8PROC_STAGE3_BITS %d\n", last_bits);
+    }
+    printf("#define UTF8PROC_SCRIPT_BITS %d\n", SCRIPT_BITS);
+    printf("#define UTF8PROC_SCRIPT_EXTENSION_BASE %u\n", (unsigned int)SCRIPT_COUNT);
+    printf("#define UTF8PROC_LINEBREAK_BITS %d\n", LINEBREAK_BITS);
+    printf("\n");
+    printf("#if UTF8PROC_WITH_SCRIPTS\n");
+    print_script_codes();
+    printf("#endif\n\n");
+
+    uint32_t *seq_values = (uint32_t *)alloc_zero(nseqs, sizeof(*seq_values));
+    for (size_t i = 0; i < nseqs; i++) {
+        seq_values[i] = seqs[i];
+    }
+    /* utf8proc.c defines UTF8PROC_WITH_* to leave out the tables the
+     * features it is built with do not read, or all of them when it reads
+     * the tables from a data file */
+    printf("#if UTF8PROC_WITH_TABLES\n\n");
+    printf("#if UTF8PROC_WITH_SEQUENCES\n");
+    print_table("utf8proc_sequences", seq_values, nseqs);
+    printf("#endif\n\n");
+
+    size_t stage_bytes;
+    if (stages == 3) {
+        stage_bytes = print_table("utf8proc_stage1table", mid_idx, MAX_CP >> (last_bits + mid_bits));
+        printf("\n");
+        stage_bytes += print_table("utf8proc_stage2table", mid, nmid);
+        printf("\n");
+        stage_bytes += print_table("utf8proc_stage3table", last, nlast);
+    } else {
+        stage_bytes = print_table("utf8proc_stage1table", last_idx, MAX_CP >> last_bits);
+        printf("\n");
+        stage_bytes += print_table("utf8proc_stage2table", last, nlast);
+    }
+    printf("\n");
+
+    printf("#if UTF8PROC_WITH_PROPERTIES\n");
+    print_properties();
+    printf("#endif\n\n");
+    print_hot_properties();
+    printf("#if UTF8PROC_WITH_COMBINATIONS\n");
+    size_t ncombinations = print_combinations();
+    printf("#endif\n\n");
+    printf("#if UTF8PROC_WITH_SCRIPTS\n");
+    size_t script_bytes = print_scripts();
+    printf("#endif\n\n");
+    printf("#if UTF8PROC_WITH_LINEBREAKS\n");
+    size_t linebreak_bytes = print_linebreaks();
+    printf("#endif\n\n");
+    printf("#endif\n");
+
+    if (stages == 3) {
+        fprintf(stderr, "Unicode %s, 3 stages(%d and %d bits): ", version, mid_bits, last_bits);
+    } else {
+        fprintf(stderr, "Unicode %s, 2 stages(%d bits): ", version, last_bits);
+    }
+    fprintf(stderr, "stage tables %u bytes, %u properties, %u sequence and %u combination elements\n",
+            (unsigned int)stage_bytes, (unsigned int)nprops + 1, (unsigned int)nseqs,
+            (unsigned int)ncombinations);
+    fprintf(stderr, "script tables %u bytes, %u script extension sets\n",
+            (unsigned int)script_bytes, (unsigned int)nscript_exts);
+    fprintf(stderr, "line break tables %u bytes\n", (unsigned int)linebreak_bytes);
+    if (!widths_from_file) {
+        fprintf(stderr, "No CharWidths.txt: widths are derived from EastAsianWidth.txt\n");
+    }
+    if (!ambiguous_from_file) {
+        fprintf(stderr, "No EastAsianWidth.txt: no character is East Asian Ambiguous\n");
+    }
+    return 0;
+}